@@ -7,6 +7,8 @@
 #include <algorithm>
 #include <chrono>
 #include <exception>
+#include <csignal>
+#include <unordered_set>
 
 // root includes
 #include "TInterpreter.h"
@@ -57,6 +59,11 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
+// larhsn includes
+#include "larhsn/Logging/HsnLog.h"
+#include "larhsn/FileLocationDatabase/Index/EventIndex.h"
+#include "larhsn/FileLocationDatabase/Index/EventList.h"
+
 #ifndef ANAHELPER_H
 #define ANAHELPER_H
 
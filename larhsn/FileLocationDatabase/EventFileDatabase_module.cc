@@ -4,40 +4,78 @@
 #include "AnaHelper.h"
 
 // Analyzer class
+// OutputLayout "Flat" (default): the EventFileDatabase tree has run, subrun, event and the full fileName per event.
+// OutputLayout "Dictionary": the EventFileDatabase tree has run, subrun, event and fileId per event, and the FileTable tree one row per input file
+// (fileId, fileName, firstEntry and lastEntry of its rows in the EventFileDatabase tree, nEvents). The rows of a file are contiguous.
 class EventFileDatabase : public art::EDAnalyzer
 {
 public:
   explicit EventFileDatabase(fhicl::ParameterSet const & pset);
   virtual ~EventFileDatabase();
   void respondToOpenInputFile(art::FileBlock const& fb);
+  void respondToCloseInputFile(art::FileBlock const& fb);
   void analyze(art::Event const & evt);
   void beginJob();
   void endJob();
 private:
+  // Declare fhiclcpp variables
+  std::string fOutputLayout;
+  bool fFlatLayout;
+
   // Declare trees
   TTree *tDataTree;
+  TTree *tFileTree;
 
   // Declare analysis variables
   int run, subrun, event;
   int f_run, f_subrun, f_event;
   std::string fileName;
   std::string f_fileName;
+  // File table (Dictionary layout)
+  int fileId;
+  int f_fileId;
+  Long64_t f_firstEntry, f_lastEntry, f_nEvents;
+  Long64_t nRows;
 
   // Declare analysis functions
   void ClearData();
 }; // End class EventFileDatabase
 
 EventFileDatabase::EventFileDatabase(fhicl::ParameterSet const & pset) :
-    EDAnalyzer(pset)
-{} // END constructor EventFileDatabase
+    EDAnalyzer(pset),
+    fOutputLayout(pset.get<std::string>("OutputLayout", "Flat")),
+    tDataTree(nullptr),
+    tFileTree(nullptr),
+    fileId(-1),
+    nRows(0)
+{
+  if (fOutputLayout != "Dictionary" && fOutputLayout != "Flat")
+  {
+    throw cet::exception("EventFileDatabase") << "OutputLayout must be \"Dictionary\" or \"Flat\", not \"" << fOutputLayout << "\".\n";
+  }
+  fFlatLayout = (fOutputLayout == "Flat");
+} // END constructor EventFileDatabase
 
 EventFileDatabase::~EventFileDatabase()
 {} // END destructor EventFileDatabase
 
 void EventFileDatabase::respondToOpenInputFile(art::FileBlock const& fb)
 {
- fileName = fb.fileName();
-}
+  fileName = fb.fileName();
+  // Every input file gets a new id, its row in the file table is filled when it is closed
+  fileId++;
+  f_firstEntry = nRows;
+} // END function respondToOpenInputFile
+
+void EventFileDatabase::respondToCloseInputFile(art::FileBlock const& fb)
+{
+  if (fFlatLayout) return;
+  f_fileId = fileId;
+  f_fileName = fileName;
+  f_nEvents = nRows - f_firstEntry;
+  f_lastEntry = nRows - 1;
+  tFileTree->Fill();
+} // END function respondToCloseInputFile
 
 void EventFileDatabase::beginJob()
 {
@@ -48,7 +86,20 @@ void EventFileDatabase::beginJob()
   tDataTree->Branch("run",&f_run);
   tDataTree->Branch("subrun",&f_subrun);
   tDataTree->Branch("event",&f_event);
-  tDataTree->Branch("fileName",&f_fileName);
+  if (fFlatLayout)
+  {
+    tDataTree->Branch("fileName",&f_fileName);
+  }
+  else
+  {
+    tDataTree->Branch("fileId",&f_fileId);
+    tFileTree = tfs->make<TTree>("FileTable","");
+    tFileTree->Branch("fileId",&f_fileId);
+    tFileTree->Branch("fileName",&f_fileName);
+    tFileTree->Branch("firstEntry",&f_firstEntry);
+    tFileTree->Branch("lastEntry",&f_lastEntry);
+    tFileTree->Branch("nEvents",&f_nEvents);
+  }
 } // END function beginJob
 
 void EventFileDatabase::endJob()
@@ -60,6 +111,7 @@ void EventFileDatabase::ClearData()
   f_run = -1;
   f_subrun = -1;
   f_event = -1;
+  f_fileId = -1;
   f_fileName = "";
 } // END function ClearData
 
@@ -77,12 +129,14 @@ void EventFileDatabase::analyze(art::Event const & evt)
   f_run = run;
   f_subrun = subrun;
   f_event = event;
-  f_fileName = fileName;
+  if (fFlatLayout) f_fileName = fileName;
+  else f_fileId = fileId;
   tDataTree->Fill();
+  nRows++;
 
 } // END function analyze
 
 // Name that will be used by the .fcl to invoke the module
 DEFINE_ART_MODULE(EventFileDatabase)
 
-#endif // END def EventFileDatabase_module
\ No newline at end of file
+#endif // END def EventFileDatabase_module
@@ -12,6 +12,7 @@ public:
   void respondToOpenInputFile(art::FileBlock const& fb);
   void analyze(art::Event const & evt);
   void beginJob();
+  void beginSubRun(art::SubRun const & subrun);
   void endJob();
 private:
   // Declare fhiclcpp variables
@@ -19,6 +20,16 @@ private:
   std::vector<int> q_subrun;
   std::vector<int> q_event;
   bool q_all;
+  std::string q_list;
+  std::string q_listTree;
+  bool q_stopWhenAllFound;
+  HsnLog::Logger fLog;
+
+  // Queried events (packed keys, see EventIndex.h), the subruns holding them and the events already found
+  std::unordered_set<uint64_t> fQueries;
+  std::unordered_set<uint64_t> fQueriedSubRuns;
+  std::unordered_set<uint64_t> fFound;
+  bool fSkipSubRun;
 
   // Declare trees
   TTree *tDataTree;
@@ -28,8 +39,7 @@ private:
   int f_run, f_subrun, f_event;
   std::string fileName;
   std::string f_fileName;
-  int lenQueriedEvents;
-  bool isCorrectRun, isCorrectSubrun, isCorrectEvent, isToStore;
+  bool isToStore;
 
   // Declare analysis functions
   void ClearData();
@@ -40,8 +50,26 @@ FindFileWithEvent::FindFileWithEvent(fhicl::ParameterSet const & pset) :
     q_run(pset.get<std::vector<int>>("queriedRun")),
     q_subrun(pset.get<std::vector<int>>("queriedSubrun")),
     q_event(pset.get<std::vector<int>>("queriedEvent")),
-    q_all(pset.get<bool>("queryAll"))
-{} // END constructor FindFileWithEvent
+    q_all(pset.get<bool>("queryAll")),
+    q_list(pset.get<std::string>("queryList")),
+    q_listTree(pset.get<std::string>("queryListTree")),
+    q_stopWhenAllFound(pset.get<bool>("stopWhenAllFound")),
+    fLog("FindFileWithEvent", pset.get<fhicl::ParameterSet>("Logging")),
+    fSkipSubRun(false)
+{
+  // Queries from the fhicl vectors and from the event list (bulk mode) go in the same hash set, so every event is checked in constant time
+  if (q_run.size() != q_event.size() || q_subrun.size() != q_event.size())
+  {
+    throw cet::exception("FindFileWithEvent") << "queriedRun, queriedSubrun and queriedEvent must have the same length.\n";
+  }
+  std::vector<uint64_t> keys;
+  for (size_t i=0; i!=q_event.size(); i++) keys.push_back(EventIndex::PackEventKey(q_run[i], q_subrun[i], q_event[i]));
+  if (!q_list.empty()) EventIndex::ReadEventList(q_list, q_listTree, keys);
+  fQueries.insert(keys.begin(), keys.end());
+  for (uint64_t key : fQueries) fQueriedSubRuns.insert(EventIndex::SubRunKey(key));
+  if (!q_all) HSN_INFO(fLog, "Query", "Looking for %zu events in %zu subruns.\n", fQueries.size(), fQueriedSubRuns.size());
+  fLog.Flush();
+} // END constructor FindFileWithEvent
 
 FindFileWithEvent::~FindFileWithEvent()
 {} // END destructor FindFileWithEvent
@@ -61,12 +89,29 @@ void FindFileWithEvent::beginJob()
   tDataTree->Branch("subrun",&f_subrun);
   tDataTree->Branch("event",&f_event);
   tDataTree->Branch("fileName",&f_fileName);
-
-  lenQueriedEvents = q_event.size();
 } // END function beginJob
 
+void FindFileWithEvent::beginSubRun(art::SubRun const & subrun)
+{
+  // Events of subruns without queried events are dismissed without looking at them
+  fSkipSubRun = !q_all && fQueriedSubRuns.count(EventIndex::SubRunKey(EventIndex::PackEventKey(subrun.run(), subrun.subRun(), 0))) == 0;
+} // END function beginSubRun
+
 void FindFileWithEvent::endJob()
 {
+  if (q_all) return;
+  // Report the queried events that were not in the input, in (run, subrun, event) order
+  std::vector<uint64_t> missing;
+  for (uint64_t key : fQueries) if (!fFound.count(key)) missing.push_back(key);
+  std::sort(missing.begin(), missing.end());
+  HSN_INFO(fLog, "Query", "Found %zu of %zu queried events.\n", fFound.size(), fQueries.size());
+  for (uint64_t key : missing)
+  {
+    unsigned run, subrun, event;
+    EventIndex::UnpackEventKey(key, run, subrun, event);
+    HSN_WARNING(fLog, "Missing", "Event %u [RUN %u, SUBRUN %u] was not found.\n", event, run, subrun);
+  }
+  fLog.Flush();
 } // END function endJob
 
 void FindFileWithEvent::ClearData()
@@ -82,6 +127,9 @@ void FindFileWithEvent::analyze(art::Event const & evt)
 {
   // Core analysis. This will be repeated event by event.
 
+  // Subrun without queried events
+  if (fSkipSubRun) return;
+
   // Start by clearing all data.
   ClearData();
 
@@ -94,25 +142,29 @@ void FindFileWithEvent::analyze(art::Event const & evt)
   if (q_all) isToStore = true;
   else
   {
-    for (int i=0;i<lenQueriedEvents;i++)
-    {
-      isCorrectRun = (q_run[i] == run);
-      isCorrectSubrun = (q_subrun[i] == subrun);
-      isCorrectEvent = (q_event[i] == event);
-      if (isCorrectRun && isCorrectSubrun && isCorrectEvent) isToStore = true;
-    }
+    const uint64_t key = EventIndex::PackEventKey(run, subrun, event);
+    isToStore = (fQueries.count(key) != 0);
+    if (isToStore) fFound.insert(key);
   }
 
   // If event information is to be stored, fill tree.
   if (isToStore)
   {
-    printf("||FOUND EVENT %i [RUN %i, SUBRUN %i] in file %s||\n", event, run, subrun, fileName.c_str());
+    HSN_INFO(fLog, "Event", "||FOUND EVENT %i [RUN %i, SUBRUN %i] in file %s||\n-------------------------------------------------------\n\n", event, run, subrun, fileName.c_str());
     f_run = run;
     f_subrun = subrun;
     f_event = event;
     f_fileName = fileName;
     tDataTree->Fill();
-    printf("-------------------------------------------------------\n\n");
+  }
+  fLog.Flush();
+
+  // All queried events found: ask art to stop after this event, as on SIGUSR2 (endJob runs and the output is closed normally)
+  if (!q_all && q_stopWhenAllFound && isToStore && fFound.size() == fQueries.size())
+  {
+    HSN_INFO(fLog, "Query", "All %zu queried events found, stopping the job.\n", fQueries.size());
+    fLog.Flush();
+    std::raise(SIGUSR2);
   }
 } // END function analyze
 
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * @file EventIndex.cxx
+ * @brief Sorted, memory-mapped index from (run, subrun, event) to the art file and entry holding the event
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventIndex.h
+ * ****************************************************************************/
+
+#include "EventIndex.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+
+namespace
+{
+  const char kMagic[8] = {'H','S','N','E','V','I','D','X'};
+  const uint32_t kVersion = 1;
+
+  bool KeyLess(const EventIndex::IndexEntry & a, const EventIndex::IndexEntry & b)
+  {
+    if (a.key != b.key) return a.key < b.key;
+    if (a.fileId != b.fileId) return a.fileId < b.fileId;
+    return a.entry < b.entry;
+  }
+
+  bool SameEntry(const EventIndex::IndexEntry & a, const EventIndex::IndexEntry & b)
+  {
+    return a.key == b.key && a.fileId == b.fileId && a.entry == b.entry;
+  }
+}
+
+namespace EventIndex
+{
+  uint64_t PackEventKey(unsigned run, unsigned subrun, unsigned event)
+  {
+    if (uint64_t(run) >> kRunBits || uint64_t(subrun) >> kSubRunBits || uint64_t(event) >> kEventBits)
+    {
+      throw cet::exception("EventIndex") << "Event " << run << ":" << subrun << ":" << event << " does not fit in the packed key (at most "
+        << kRunBits << ", " << kSubRunBits << " and " << kEventBits << " bits).\n";
+    }
+    return (uint64_t(run) << (kSubRunBits + kEventBits)) | (uint64_t(subrun) << kEventBits) | uint64_t(event);
+  } // END function PackEventKey
+
+  void UnpackEventKey(uint64_t key, unsigned & run, unsigned & subrun, unsigned & event)
+  {
+    event = key & ((uint64_t(1) << kEventBits) - 1);
+    subrun = (key >> kEventBits) & ((uint64_t(1) << kSubRunBits) - 1);
+    run = key >> (kSubRunBits + kEventBits);
+    return;
+  } // END function UnpackEventKey
+
+
+  // EventIndexWriter
+  uint32_t EventIndexWriter::AddFile(const std::string & fileName)
+  {
+    auto it = fFileIds.find(fileName);
+    if (it != fFileIds.end()) return it->second;
+    uint32_t fileId = fFileNames.size();
+    fFileNames.push_back(fileName);
+    fFileIds.emplace(fileName, fileId);
+    return fileId;
+  } // END function AddFile
+
+  void EventIndexWriter::AddEvent(unsigned run, unsigned subrun, unsigned event, uint32_t fileId, uint32_t entry)
+  {
+    if (fileId >= fFileNames.size()) throw cet::exception("EventIndex") << "File id " << fileId << " was not added.\n";
+    IndexEntry indexEntry = {PackEventKey(run, subrun, event), fileId, entry};
+    fEntries.push_back(indexEntry);
+    return;
+  } // END function AddEvent
+
+  size_t EventIndexWriter::NumEvents() const {return fEntries.size();}
+  size_t EventIndexWriter::NumFiles() const {return fFileNames.size();}
+
+  size_t EventIndexWriter::Write(const std::string & indexName)
+  {
+    // The same event of the same file, read by several jobs (e.g. databases of overlapping jobs merged together), is only kept once
+    std::sort(fEntries.begin(), fEntries.end(), KeyLess);
+    fEntries.erase(std::unique(fEntries.begin(), fEntries.end(), SameEntry), fEntries.end());
+
+    std::vector<uint64_t> fileOffsets(1, 0);
+    for (const std::string & name : fFileNames) fileOffsets.push_back(fileOffsets.back() + name.size());
+
+    IndexHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.numFiles = fFileNames.size();
+    header.numEvents = fEntries.size();
+    header.nameBytes = fileOffsets.back();
+
+    std::ofstream out(indexName, std::ios::binary | std::ios::trunc);
+    if (!out) throw cet::exception("EventIndex") << "Could not open index file " << indexName << " for writing.\n";
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(fEntries.data()), fEntries.size()*sizeof(IndexEntry));
+    out.write(reinterpret_cast<const char*>(fileOffsets.data()), fileOffsets.size()*sizeof(uint64_t));
+    for (const std::string & name : fFileNames) out.write(name.data(), name.size());
+    out.close();
+    if (!out) throw cet::exception("EventIndex") << "Could not write index file " << indexName << ".\n";
+    return fEntries.size();
+  } // END function Write
+
+
+  // EventIndexReader
+  EventIndexReader::EventIndexReader(const std::string & indexName) :
+    fMap(nullptr),
+    fMapBytes(0)
+  {
+    int fd = open(indexName.c_str(), O_RDONLY);
+    if (fd < 0) throw cet::exception("EventIndex") << "Could not open index file " << indexName << ".\n";
+    struct stat info;
+    if (fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(IndexHeader))
+    {
+      close(fd);
+      throw cet::exception("EventIndex") << indexName << " is not an event index (too short).\n";
+    }
+    fMapBytes = info.st_size;
+    fMap = mmap(nullptr, fMapBytes, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (fMap == MAP_FAILED)
+    {
+      fMap = nullptr;
+      throw cet::exception("EventIndex") << "Could not map index file " << indexName << ".\n";
+    }
+
+    const char* base = static_cast<const char*>(fMap);
+    fHeader = reinterpret_cast<const IndexHeader*>(base);
+    // The sections are only located once the header is known to describe this file
+    const bool isIndex = (memcmp(fHeader->magic, kMagic, sizeof(kMagic)) == 0 && fHeader->version == kVersion);
+    if (!isIndex || fHeader->numEvents > fMapBytes/sizeof(IndexEntry) || fHeader->nameBytes > fMapBytes ||
+        sizeof(IndexHeader) + fHeader->numEvents*sizeof(IndexEntry) + (uint64_t(fHeader->numFiles) + 1)*sizeof(uint64_t) + fHeader->nameBytes != fMapBytes)
+    {
+      munmap(fMap, fMapBytes);
+      fMap = nullptr;
+      throw cet::exception("EventIndex") << indexName << " is not an event index of version " << kVersion << " (or it is truncated).\n";
+    }
+    fEntries = reinterpret_cast<const IndexEntry*>(base + sizeof(IndexHeader));
+    fFileOffsets = reinterpret_cast<const uint64_t*>(fEntries + fHeader->numEvents);
+    fNames = reinterpret_cast<const char*>(fFileOffsets + fHeader->numFiles + 1);
+    // Binary searches and file names only touch a few pages each, read ahead would be wasted
+    madvise(fMap, fMapBytes, MADV_RANDOM);
+  } // END constructor EventIndexReader
+
+  EventIndexReader::~EventIndexReader()
+  {
+    if (fMap) munmap(fMap, fMapBytes);
+  } // END destructor EventIndexReader
+
+  size_t EventIndexReader::NumEvents() const {return fHeader->numEvents;}
+  size_t EventIndexReader::NumFiles() const {return fHeader->numFiles;}
+
+  std::pair<const IndexEntry*, const IndexEntry*> EventIndexReader::Find(uint64_t key) const
+  {
+    const IndexEntry* first = fEntries;
+    const IndexEntry* last = fEntries + fHeader->numEvents;
+    first = std::lower_bound(first, last, key, [](const IndexEntry & e, uint64_t k) {return e.key < k;});
+    last = std::upper_bound(first, last, key, [](uint64_t k, const IndexEntry & e) {return k < e.key;});
+    return std::make_pair(first, last);
+  } // END function Find
+
+  std::pair<const IndexEntry*, const IndexEntry*> EventIndexReader::Find(unsigned run, unsigned subrun, unsigned event) const
+  {
+    return Find(PackEventKey(run, subrun, event));
+  } // END function Find
+
+  std::string EventIndexReader::GetFileName(uint32_t fileId) const
+  {
+    if (fileId >= fHeader->numFiles) throw cet::exception("EventIndex") << "File id " << fileId << " is not in the index.\n";
+    return std::string(fNames + fFileOffsets[fileId], fFileOffsets[fileId+1] - fFileOffsets[fileId]);
+  } // END function GetFileName
+
+} // END namespace EventIndex
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * @file EventIndex.h
+ * @brief Sorted, memory-mapped index from (run, subrun, event) to the art file and entry holding the event
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventIndex.cxx BuildEventIndex.cc LookupEvent.cc
+ * ****************************************************************************/
+
+#ifndef EVENTINDEX_H
+#define EVENTINDEX_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "cetlib/exception.h"
+
+namespace EventIndex
+{
+  // Event IDs are packed in 64 bits as run (20 bits), subrun (20 bits), event (24 bits),
+  // so the packed keys sort in (run, subrun, event) order and the keys of a subrun are contiguous.
+  const int kRunBits = 20;
+  const int kSubRunBits = 20;
+  const int kEventBits = 24;
+
+  // Throws if a number does not fit in its field
+  uint64_t PackEventKey(unsigned run, unsigned subrun, unsigned event);
+  void UnpackEventKey(uint64_t key, unsigned & run, unsigned & subrun, unsigned & event);
+  // Key shared by all the events of the subrun of the key
+  inline uint64_t SubRunKey(uint64_t key) {return key >> kEventBits;}
+
+  // One event of the index: fileId is the position of the file in the file table,
+  // entry the position of the event in the file: the entry of the art Events tree with BuildEventCatalog -i, the order in which art
+  // visited the events (sorted by ID, the same unless the file was written unsorted) when built from an EventFileDatabase catalog
+  struct IndexEntry
+  {
+    uint64_t key;
+    uint32_t fileId;
+    uint32_t entry;
+  };
+
+  // On-disk layout (native byte order, every section 8-byte aligned):
+  //   header, IndexEntry[numEvents] sorted by key, uint64_t fileOffsets[numFiles+1] into the names, file names (not terminated)
+  struct IndexHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t numFiles;
+    uint64_t numEvents;
+    uint64_t nameBytes;
+  };
+
+  // EventIndexWriter class and functions
+  // Collects the events and the dictionary of file names, sorts them and writes the index file.
+  class EventIndexWriter
+  {
+  public:
+    // Id of the file in the file table, the same name always gets the same id
+    uint32_t AddFile(const std::string & fileName);
+    void AddEvent(unsigned run, unsigned subrun, unsigned event, uint32_t fileId, uint32_t entry);
+    size_t NumEvents() const;
+    size_t NumFiles() const;
+    // Sort by key (then file and entry), drop repeated (key, file, entry) and write the index. Returns the number of events written.
+    size_t Write(const std::string & indexName);
+
+  private:
+    std::vector<IndexEntry> fEntries;
+    std::vector<std::string> fFileNames;
+    std::unordered_map<std::string, uint32_t> fFileIds;
+  };
+
+  // EventIndexReader class and functions
+  // Maps the index file read-only: opening costs nothing but the header check, and every lookup is a binary search in the mapped entries.
+  class EventIndexReader
+  {
+  public:
+    explicit EventIndexReader(const std::string & indexName);
+    virtual ~EventIndexReader();
+    EventIndexReader(const EventIndexReader &) = delete;
+    EventIndexReader & operator=(const EventIndexReader &) = delete;
+
+    size_t NumEvents() const;
+    size_t NumFiles() const;
+    // All the entries with this key, as [first, last). Several files can hold the same event ID (e.g. MC samples).
+    std::pair<const IndexEntry*, const IndexEntry*> Find(uint64_t key) const;
+    std::pair<const IndexEntry*, const IndexEntry*> Find(unsigned run, unsigned subrun, unsigned event) const;
+    std::string GetFileName(uint32_t fileId) const;
+
+  private:
+    void* fMap;
+    size_t fMapBytes;
+    const IndexHeader* fHeader;
+    const IndexEntry* fEntries;
+    const uint64_t* fFileOffsets;
+    const char* fNames;
+  };
+
+} //END namespace EventIndex
+
+#endif
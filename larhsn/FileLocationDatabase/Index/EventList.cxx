@@ -0,0 +1,83 @@
+/******************************************************************************
+ * @file EventList.cxx
+ * @brief Lists of queried events, read from text or ROOT files as packed event keys
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventList.h
+ * ****************************************************************************/
+
+#include "EventList.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include "TFile.h"
+#include "TTree.h"
+
+namespace
+{
+  bool IsRootFile(const std::string & name)
+  {
+    const std::string suffix = ".root";
+    return name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+  }
+
+  void ReadTextList(const std::string & listName, std::vector<uint64_t> & keys)
+  {
+    std::ifstream list(listName);
+    if (!list) throw cet::exception("EventList") << "Could not open event list " << listName << ".\n";
+    std::string line;
+    while (std::getline(list, line))
+    {
+      if (line.find_first_not_of(" \t\r") == std::string::npos || line[0] == '#') continue;
+      keys.push_back(EventIndex::ParseEventKey(line));
+    }
+  }
+
+  void ReadRootList(const std::string & listName, const std::string & treePath, std::vector<uint64_t> & keys)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(listName.c_str(), "READ"));
+    if (!file || file->IsZombie()) throw cet::exception("EventList") << "Could not open event list " << listName << ".\n";
+    TTree* tree = nullptr;
+    file->GetObject(treePath.c_str(), tree);
+    if (!tree) throw cet::exception("EventList") << "No tree " << treePath << " in " << listName << ".\n";
+
+    int run, subrun, event;
+    tree->SetBranchStatus("*", false);
+    for (const char* name : {"run", "subrun", "event"}) tree->SetBranchStatus(name, true);
+    tree->SetBranchAddress("run", &run);
+    tree->SetBranchAddress("subrun", &subrun);
+    tree->SetBranchAddress("event", &event);
+    const Long64_t nRows = tree->GetEntries();
+    for (Long64_t i=0; i!=nRows; i++)
+    {
+      tree->GetEntry(i);
+      if (run < 0 || subrun < 0 || event < 0) throw cet::exception("EventList") << "Row " << i << " of " << listName << " is not an event.\n";
+      keys.push_back(EventIndex::PackEventKey(run, subrun, event));
+    }
+    tree->ResetBranchAddresses();
+  }
+}
+
+namespace EventIndex
+{
+  uint64_t ParseEventKey(std::string text)
+  {
+    std::replace(text.begin(), text.end(), ':', ' ');
+    std::istringstream stream(text);
+    long long run, subrun, event;
+    if (!(stream >> run >> subrun >> event) || run < 0 || subrun < 0 || event < 0)
+    {
+      throw cet::exception("EventList") << "Could not read an event from \"" << text << "\".\n";
+    }
+    return PackEventKey(run, subrun, event);
+  } // END function ParseEventKey
+
+  void ReadEventList(const std::string & listName, const std::string & treePath, std::vector<uint64_t> & keys)
+  {
+    if (IsRootFile(listName)) ReadRootList(listName, treePath, keys);
+    else ReadTextList(listName, keys);
+    return;
+  } // END function ReadEventList
+
+} // END namespace EventIndex
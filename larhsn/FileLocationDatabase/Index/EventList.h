@@ -0,0 +1,32 @@
+/******************************************************************************
+ * @file EventList.h
+ * @brief Lists of queried events, read from text or ROOT files as packed event keys
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventList.cxx EventIndex.h
+ * ****************************************************************************/
+
+#ifndef EVENTLIST_H
+#define EVENTLIST_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "cetlib/exception.h"
+#include "larhsn/FileLocationDatabase/Index/EventIndex.h"
+
+namespace EventIndex
+{
+  // "run subrun event" or "run:subrun:event"
+  uint64_t ParseEventKey(std::string text);
+
+  // Appends the events of a list to keys. A ROOT file (name ending in .root) is read from the int run, subrun and event branches
+  // of the tree at treePath (e.g. the Data tree of FindFileWithEvent or the EventFileDatabase tree).
+  // Any other file is read as text, one event per line, skipping empty lines and lines starting with #.
+  void ReadEventList(const std::string & listName, const std::string & treePath, std::vector<uint64_t> & keys);
+
+} //END namespace EventIndex
+
+#endif
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * @file ToolHelpers.cxx
+ * @brief Pieces shared by the command line tools: file lists, the pool of threads reading input files and the main wrapper
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  ToolHelpers.h
+ * ****************************************************************************/
+
+#include "ToolHelpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include "TROOT.h"
+
+namespace HsnTools
+{
+  void ReadFileList(const std::string & listName, std::vector<std::string> & fileNames)
+  {
+    std::ifstream list(listName);
+    if (!list) throw cet::exception("FileList") << "Could not open file list " << listName << ".\n";
+    std::string line;
+    while (std::getline(list, line))
+    {
+      if (line.empty() || line[0] == '#') continue;
+      fileNames.push_back(line);
+    }
+    return;
+  } // END function ReadFileList
+
+  size_t DefaultNumThreads()
+  {
+    return std::max(1u, std::thread::hardware_concurrency());
+  } // END function DefaultNumThreads
+
+  size_t ParallelFor(size_t n, size_t nThreads, const std::function<void(size_t)> & work)
+  {
+    ROOT::EnableThreadSafety();
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+      for (size_t i=next++; i<n; i=next++) work(i);
+    };
+    nThreads = std::max(size_t(1), std::min(nThreads, n));
+    std::vector<std::thread> threads;
+    for (size_t t=1; t<nThreads; t++) threads.emplace_back(worker);
+    worker();
+    for (std::thread & thread : threads) thread.join();
+    return nThreads;
+  } // END function ParallelFor
+
+  int RunTool(const char* toolName, int (*run)(int, char**), int argc, char** argv)
+  {
+    try
+    {
+      return run(argc, argv);
+    }
+    catch (const cet::exception & e)
+    {
+      fprintf(stderr, "%s: %s", toolName, e.what());
+    }
+    catch (const std::exception & e)
+    {
+      fprintf(stderr, "%s: %s\n", toolName, e.what());
+    }
+    return 1;
+  } // END function RunTool
+
+} // END namespace HsnTools
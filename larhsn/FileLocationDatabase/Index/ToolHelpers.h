@@ -0,0 +1,37 @@
+/******************************************************************************
+ * @file ToolHelpers.h
+ * @brief Pieces shared by the command line tools: file lists, the pool of threads reading input files and the main wrapper
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  ToolHelpers.cxx BuildEventCatalog.cc SumPot.cc HsnFinderGallery.cc
+ * ****************************************************************************/
+
+#ifndef TOOLHELPERS_H
+#define TOOLHELPERS_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "cetlib/exception.h"
+
+namespace HsnTools
+{
+  // Appends the file names of a list (-S of the tools), one per line, skipping empty lines and lines starting with #
+  void ReadFileList(const std::string & listName, std::vector<std::string> & fileNames);
+
+  // One thread per core, the default of -j
+  size_t DefaultNumThreads();
+
+  // Calls work(i) for every i in [0, n), handing the indices to at most nThreads threads (the calling thread is one of them) one at a time.
+  // ROOT thread safety is enabled first, so each call may open its own TFile. work must not throw, errors are kept in its results.
+  // Returns the number of threads used.
+  size_t ParallelFor(size_t n, size_t nThreads, const std::function<void(size_t)> & work);
+
+  // main of a tool: returns run(argc, argv), or prints the exception to stderr prefixed by the tool name and returns 1
+  int RunTool(const char* toolName, int (*run)(int, char**), int argc, char** argv);
+
+} //END namespace HsnTools
+
+#endif
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * @file BuildEventCatalog.cc
+ * @brief Writes the EventFileDatabase catalog of art files from their EventAuxiliary branch only, several files at a time, without an art job
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventFileDatabase_module.cc BuildEventIndex.cc
+ *
+ * Usage: BuildEventCatalog -o <catalog.root> [-l Flat|Dictionary] [-j <threads>] [-i <index file>] [-S <file list>] [input.root ...]
+ * Every input file is opened with plain ROOT I/O and only the EventAuxiliary branch of its Events tree is read, on a pool of threads
+ * (one file per thread at a time, default one thread per core). The catalog is the one EventFileDatabase writes when art reads the same
+ * files in the same order: the EventFileDatabase directory with the EventFileDatabase tree (layout "Flat" by default), and the FileTable tree with -l Dictionary.
+ * The rows of each file follow the order in which art's RootInput visits its events, i.e. its FileIndex sorted by (run, subrun, event),
+ * not the entry order of the Events tree (the two differ if the file was written unsorted; a job with noEventSort visits the entry order).
+ * With -i the event index of BuildEventIndex is written as well.
+ * The art::EventAuxiliary dictionary is loaded by ROOT from the canvas rootmap files, so the art environment must be set up.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TTree.h"
+
+// framework includes
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "cetlib/exception.h"
+
+// larhsn includes
+#include "larhsn/FileLocationDatabase/Index/EventIndex.h"
+#include "larhsn/FileLocationDatabase/Index/ToolHelpers.h"
+
+namespace
+{
+  // Events of one input file, in the order art visits them
+  struct FileCatalog
+  {
+    std::vector<unsigned> run, subrun, event;
+    std::vector<Long64_t> entry; // Entry of each event in the Events tree
+    Long64_t bytesRead = 0;
+    std::string error; // Set by the worker instead of throwing, the main thread reports it
+  };
+
+  void PrintUsage()
+  {
+    printf("Usage: BuildEventCatalog -o <catalog.root> [-l Flat|Dictionary] [-j <threads>] [-i <index file>] [-S <file list>] [input.root ...]\n");
+  }
+
+  // Reads the event IDs of one art file. Each thread opens its own TFile, nothing else is shared.
+  void ReadFile(const std::string & fileName, FileCatalog & catalog)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie())
+    {
+      catalog.error = "Could not open " + fileName + ".";
+      return;
+    }
+    TTree* events = nullptr;
+    file->GetObject("Events", events);
+    if (!events)
+    {
+      catalog.error = "No Events tree in " + fileName + ", it is not an art file.";
+      return;
+    }
+    // Only the baskets of EventAuxiliary are read, ahead of time through the tree cache
+    art::EventAuxiliary* aux = nullptr;
+    events->SetBranchStatus("*", false);
+    events->SetBranchStatus("EventAuxiliary*", true);
+    if (events->SetBranchAddress("EventAuxiliary", &aux) < 0)
+    {
+      catalog.error = "Could not read the EventAuxiliary branch of " + fileName + ".";
+      return;
+    }
+    events->SetCacheSize(10000000);
+    events->AddBranchToCache("EventAuxiliary*", true);
+
+    const Long64_t nEntries = events->GetEntries();
+    std::vector<std::array<unsigned,3>> ids;
+    ids.reserve(nEntries);
+    for (Long64_t i=0; i!=nEntries; i++)
+    {
+      events->GetEntry(i);
+      ids.push_back({{aux->id().run(), aux->id().subRun(), aux->id().event()}});
+    }
+    events->ResetBranchAddresses();
+    delete aux;
+    catalog.bytesRead = file->GetBytesRead();
+
+    // art sorts the FileIndex of the file by (run, subrun, event); the sort is stable so duplicated IDs keep their entry order
+    std::vector<Long64_t> order(nEntries);
+    for (Long64_t i=0; i!=nEntries; i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&ids](Long64_t a, Long64_t b) {return ids[a] < ids[b];});
+    catalog.run.reserve(nEntries);
+    catalog.subrun.reserve(nEntries);
+    catalog.event.reserve(nEntries);
+    catalog.entry.reserve(nEntries);
+    for (Long64_t i : order)
+    {
+      catalog.run.push_back(ids[i][0]);
+      catalog.subrun.push_back(ids[i][1]);
+      catalog.event.push_back(ids[i][2]);
+      catalog.entry.push_back(i);
+    }
+  } // END function ReadFile
+
+  // Same trees and branches as EventFileDatabase_module.cc
+  void WriteCatalog(const std::string & outputName, bool flatLayout, const std::vector<std::string> & fileNames, const std::vector<FileCatalog> & catalogs)
+  {
+    TFile output(outputName.c_str(), "RECREATE");
+    if (output.IsZombie()) throw cet::exception("BuildEventCatalog") << "Could not open output file " << outputName << ".\n";
+    TDirectory* directory = output.mkdir("EventFileDatabase");
+    directory->cd();
+
+    int f_run, f_subrun, f_event, f_fileId;
+    std::string f_fileName;
+    Long64_t f_firstEntry, f_lastEntry, f_nEvents;
+    TTree* dataTree = new TTree("EventFileDatabase","");
+    dataTree->Branch("run",&f_run);
+    dataTree->Branch("subrun",&f_subrun);
+    dataTree->Branch("event",&f_event);
+    TTree* fileTree = nullptr;
+    if (flatLayout)
+    {
+      dataTree->Branch("fileName",&f_fileName);
+    }
+    else
+    {
+      dataTree->Branch("fileId",&f_fileId);
+      fileTree = new TTree("FileTable","");
+      fileTree->Branch("fileId",&f_fileId);
+      fileTree->Branch("fileName",&f_fileName);
+      fileTree->Branch("firstEntry",&f_firstEntry);
+      fileTree->Branch("lastEntry",&f_lastEntry);
+      fileTree->Branch("nEvents",&f_nEvents);
+    }
+
+    Long64_t nRows = 0;
+    for (size_t f=0; f!=catalogs.size(); f++)
+    {
+      const FileCatalog & catalog = catalogs[f];
+      f_fileId = f;
+      f_fileName = fileNames[f];
+      f_firstEntry = nRows;
+      for (size_t i=0; i!=catalog.event.size(); i++)
+      {
+        f_run = catalog.run[i];
+        f_subrun = catalog.subrun[i];
+        f_event = catalog.event[i];
+        dataTree->Fill();
+        nRows++;
+      }
+      if (fileTree)
+      {
+        f_nEvents = nRows - f_firstEntry;
+        f_lastEntry = nRows - 1;
+        fileTree->Fill();
+      }
+    }
+    output.Write();
+    output.Close();
+  } // END function WriteCatalog
+
+  int Run(int argc, char** argv)
+  {
+    std::string outputName, layout = "Flat", indexName, listName;
+    size_t nThreads = HsnTools::DefaultNumThreads();
+    int option;
+    while ((option = getopt(argc, argv, "o:l:j:i:S:h")) != -1)
+    {
+      switch (option)
+      {
+        case 'o': outputName = optarg; break;
+        case 'l': layout = optarg; break;
+        case 'j': nThreads = std::max(1, atoi(optarg)); break;
+        case 'i': indexName = optarg; break;
+        case 'S': listName = optarg; break;
+        default: PrintUsage(); return 1;
+      }
+    }
+    std::vector<std::string> fileNames;
+    if (!listName.empty()) HsnTools::ReadFileList(listName, fileNames);
+    for (int i=optind; i<argc; i++) fileNames.push_back(argv[i]);
+    if (outputName.empty() || fileNames.empty() || (layout != "Dictionary" && layout != "Flat"))
+    {
+      PrintUsage();
+      return 1;
+    }
+
+    // Files are handed to the threads one at a time, the results are kept in input order
+    auto tStart = std::chrono::steady_clock::now();
+    std::vector<FileCatalog> catalogs(fileNames.size());
+    nThreads = HsnTools::ParallelFor(fileNames.size(), nThreads, [&](size_t f) {ReadFile(fileNames[f], catalogs[f]);});
+    const double readTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+
+    size_t nEvents = 0;
+    Long64_t bytesRead = 0;
+    for (const FileCatalog & catalog : catalogs)
+    {
+      if (!catalog.error.empty()) throw cet::exception("BuildEventCatalog") << catalog.error << "\n";
+      nEvents += catalog.event.size();
+      bytesRead += catalog.bytesRead;
+    }
+    WriteCatalog(outputName, layout == "Flat", fileNames, catalogs);
+
+    if (!indexName.empty())
+    {
+      EventIndex::EventIndexWriter writer;
+      for (size_t f=0; f!=catalogs.size(); f++)
+      {
+        const uint32_t fileId = writer.AddFile(fileNames[f]);
+        for (size_t i=0; i!=catalogs[f].event.size(); i++) writer.AddEvent(catalogs[f].run[i], catalogs[f].subrun[i], catalogs[f].event[i], fileId, catalogs[f].entry[i]);
+      }
+      writer.Write(indexName);
+    }
+
+    const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+    printf("Catalogued %zu events of %zu files with %zu threads: %.2f s reading (%.1f MB read, %.1f MB/s), %.2f s in total, catalog in %s.\n",
+      nEvents, fileNames.size(), nThreads, readTime, bytesRead/1e6, (readTime > 0.) ? bytesRead/1e6/readTime : 0., totalTime, outputName.c_str());
+    return 0;
+  } // END function Run
+}
+
+int main(int argc, char** argv)
+{
+  return HsnTools::RunTool("BuildEventCatalog", Run, argc, argv);
+} // END function main
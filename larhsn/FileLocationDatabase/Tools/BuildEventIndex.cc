@@ -0,0 +1,172 @@
+/******************************************************************************
+ * @file BuildEventIndex.cc
+ * @brief Turns EventFileDatabase trees into a sorted event index for LookupEvent
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventIndex.h EventFileDatabase_module.cc LookupEvent.cc
+ *
+ * Usage: BuildEventIndex -o <index file> [-t <tree path>] [-S <file list>] [database.root ...]
+ * Reads the run, subrun and event branches of the EventFileDatabase tree (default path "EventFileDatabase/EventFileDatabase",
+ * the module label directory of the TFileService) of every database file, with the fileName branch of the Flat layout
+ * or the fileId branch and the FileTable tree of the Dictionary layout. The entry of an event is its position among the rows of its
+ * art file, which is the entry of the art Events tree when EventFileDatabase read the whole file.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TTree.h"
+
+// framework includes
+#include "cetlib/exception.h"
+
+// larhsn includes
+#include "larhsn/FileLocationDatabase/Index/EventIndex.h"
+#include "larhsn/FileLocationDatabase/Index/ToolHelpers.h"
+
+namespace
+{
+  void PrintUsage()
+  {
+    printf("Usage: BuildEventIndex -o <index file> [-t <tree path>] [-S <file list>] [database.root ...]\n");
+  }
+
+  // Adds the rows of one database file. Entries are counted within the database, so an art file read by several jobs
+  // gets the same entries from each of them, and the repeated rows are dropped by EventIndexWriter::Write.
+  size_t AddDatabase(const std::string & databaseName, const std::string & treePath, EventIndex::EventIndexWriter & writer)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(databaseName.c_str(), "READ"));
+    if (!file || file->IsZombie()) throw cet::exception("BuildEventIndex") << "Could not open " << databaseName << ".\n";
+    TTree* tree = nullptr;
+    file->GetObject(treePath.c_str(), tree);
+    if (!tree) throw cet::exception("BuildEventIndex") << "No tree " << treePath << " in " << databaseName << ".\n";
+
+    int run, subrun, event;
+    tree->SetBranchStatus("*", false);
+    for (const char* name : {"run", "subrun", "event"}) tree->SetBranchStatus(name, true);
+    tree->SetBranchAddress("run", &run);
+    tree->SetBranchAddress("subrun", &subrun);
+    tree->SetBranchAddress("event", &event);
+    const Long64_t nRows = tree->GetEntries();
+
+    if (tree->GetBranch("fileName"))
+    {
+      // Flat layout: rows of the same art file come one after the other, so the dictionary is only searched when the name changes
+      std::string* fileName = nullptr;
+      tree->SetBranchStatus("fileName", true);
+      tree->SetBranchAddress("fileName", &fileName);
+      std::vector<uint32_t> nextEntry;
+      std::string lastName;
+      uint32_t fileId = 0;
+      for (Long64_t i=0; i!=nRows; i++)
+      {
+        tree->GetEntry(i);
+        if (i == 0 || *fileName != lastName)
+        {
+          lastName = *fileName;
+          fileId = writer.AddFile(lastName);
+          if (fileId >= nextEntry.size()) nextEntry.resize(fileId+1, 0);
+        }
+        writer.AddEvent(run, subrun, event, fileId, nextEntry[fileId]++);
+      }
+      tree->ResetBranchAddresses();
+      delete fileName;
+    }
+    else
+    {
+      // Dictionary layout: the file ids of the database are translated to the ids of the index through the FileTable tree next to the events
+      const size_t slash = treePath.rfind('/');
+      const std::string fileTablePath = (slash == std::string::npos) ? "FileTable" : treePath.substr(0, slash+1) + "FileTable";
+      TTree* fileTable = nullptr;
+      file->GetObject(fileTablePath.c_str(), fileTable);
+      if (!fileTable || !tree->GetBranch("fileId"))
+      {
+        throw cet::exception("BuildEventIndex") << treePath << " in " << databaseName << " has neither a fileName branch nor a fileId branch and a FileTable tree.\n";
+      }
+      int databaseId;
+      Long64_t firstEntry;
+      std::string* fileName = nullptr;
+      fileTable->SetBranchAddress("fileId", &databaseId);
+      fileTable->SetBranchAddress("fileName", &fileName);
+      fileTable->SetBranchAddress("firstEntry", &firstEntry);
+      std::vector<uint32_t> indexIds;
+      std::vector<Long64_t> firstEntries;
+      for (Long64_t i=0; i!=fileTable->GetEntries(); i++)
+      {
+        fileTable->GetEntry(i);
+        if (databaseId < 0) throw cet::exception("BuildEventIndex") << "Bad file id " << databaseId << " in " << databaseName << ".\n";
+        if (size_t(databaseId) >= indexIds.size())
+        {
+          indexIds.resize(databaseId+1, uint32_t(-1));
+          firstEntries.resize(databaseId+1, 0);
+        }
+        indexIds[databaseId] = writer.AddFile(*fileName);
+        firstEntries[databaseId] = firstEntry;
+      }
+      fileTable->ResetBranchAddresses();
+      delete fileName;
+      int databaseFileId;
+      tree->SetBranchStatus("fileId", true);
+      tree->SetBranchAddress("fileId", &databaseFileId);
+      for (Long64_t i=0; i!=nRows; i++)
+      {
+        tree->GetEntry(i);
+        if (databaseFileId < 0 || size_t(databaseFileId) >= indexIds.size() || indexIds[databaseFileId] == uint32_t(-1))
+        {
+          throw cet::exception("BuildEventIndex") << "File id " << databaseFileId << " of row " << i << " is not in the FileTable of " << databaseName << ".\n";
+        }
+        // The rows of a file start at its firstEntry in the events tree
+        writer.AddEvent(run, subrun, event, indexIds[databaseFileId], i - firstEntries[databaseFileId]);
+      }
+    }
+    tree->ResetBranchAddresses();
+    return nRows;
+  } // END function AddDatabase
+
+  int Run(int argc, char** argv)
+  {
+    std::string indexName, listName;
+    std::string treePath = "EventFileDatabase/EventFileDatabase";
+    int option;
+    while ((option = getopt(argc, argv, "o:t:S:h")) != -1)
+    {
+      switch (option)
+      {
+        case 'o': indexName = optarg; break;
+        case 't': treePath = optarg; break;
+        case 'S': listName = optarg; break;
+        default: PrintUsage(); return 1;
+      }
+    }
+    std::vector<std::string> databaseNames;
+    if (!listName.empty()) HsnTools::ReadFileList(listName, databaseNames);
+    for (int i=optind; i<argc; i++) databaseNames.push_back(argv[i]);
+    if (indexName.empty() || databaseNames.empty())
+    {
+      PrintUsage();
+      return 1;
+    }
+
+    auto tStart = std::chrono::steady_clock::now();
+    EventIndex::EventIndexWriter writer;
+    size_t nRows = 0;
+    for (const std::string & databaseName : databaseNames) nRows += AddDatabase(databaseName, treePath, writer);
+    const size_t nEvents = writer.Write(indexName);
+    const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+    printf("Indexed %zu events (%zu repeated rows dropped) of %zu art files from %zu databases in %.2f s, index in %s.\n",
+      nEvents, nRows - nEvents, writer.NumFiles(), databaseNames.size(), totalTime, indexName.c_str());
+    return 0;
+  } // END function Run
+}
+
+int main(int argc, char** argv)
+{
+  return HsnTools::RunTool("BuildEventIndex", Run, argc, argv);
+} // END function main
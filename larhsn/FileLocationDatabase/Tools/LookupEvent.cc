@@ -0,0 +1,86 @@
+/******************************************************************************
+ * @file LookupEvent.cc
+ * @brief Finds the art file and entry of events in an index made by BuildEventIndex, without an art job
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventIndex.h BuildEventIndex.cc
+ *
+ * Usage: LookupEvent -i <index file> [-f <event list>] [-t <tree path>] [run:subrun:event ...]
+ * The event list has one event per line, as "run subrun event" or "run:subrun:event" (lines starting with # are skipped),
+ * or is a ROOT file with the run, subrun and event branches of the tree at the -t path (default "FindFileWithEvent/Data").
+ * Every event is printed as "run subrun event entry fileName", once for every file holding it, or as "run subrun event NOT FOUND".
+ * Each query is a binary search in the mapped index. The exit status is 2 if an event was not found.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+// framework includes
+#include "cetlib/exception.h"
+
+// larhsn includes
+#include "larhsn/FileLocationDatabase/Index/EventIndex.h"
+#include "larhsn/FileLocationDatabase/Index/EventList.h"
+#include "larhsn/FileLocationDatabase/Index/ToolHelpers.h"
+
+namespace
+{
+  void PrintUsage()
+  {
+    printf("Usage: LookupEvent -i <index file> [-f <event list>] [-t <tree path>] [run:subrun:event ...]\n");
+  }
+
+  int Run(int argc, char** argv)
+  {
+    std::string indexName, listName;
+    std::string treePath = "FindFileWithEvent/Data";
+    int option;
+    while ((option = getopt(argc, argv, "i:f:t:h")) != -1)
+    {
+      switch (option)
+      {
+        case 'i': indexName = optarg; break;
+        case 'f': listName = optarg; break;
+        case 't': treePath = optarg; break;
+        default: PrintUsage(); return 1;
+      }
+    }
+    std::vector<uint64_t> keys;
+    if (!listName.empty()) EventIndex::ReadEventList(listName, treePath, keys);
+    for (int i=optind; i<argc; i++) keys.push_back(EventIndex::ParseEventKey(argv[i]));
+    if (indexName.empty() || keys.empty())
+    {
+      PrintUsage();
+      return 1;
+    }
+
+    const EventIndex::EventIndexReader index(indexName);
+    size_t nMissing = 0;
+    for (uint64_t key : keys)
+    {
+      unsigned run, subrun, event;
+      EventIndex::UnpackEventKey(key, run, subrun, event);
+      auto found = index.Find(key);
+      if (found.first == found.second)
+      {
+        printf("%u %u %u NOT FOUND\n", run, subrun, event);
+        nMissing++;
+        continue;
+      }
+      for (const EventIndex::IndexEntry* entry = found.first; entry != found.second; entry++)
+      {
+        printf("%u %u %u %u %s\n", run, subrun, event, entry->entry, index.GetFileName(entry->fileId).c_str());
+      }
+    }
+    if (nMissing) fprintf(stderr, "LookupEvent: %zu of %zu events not found among the %zu events of %s.\n", nMissing, keys.size(), index.NumEvents(), indexName.c_str());
+    return nMissing ? 2 : 0;
+  } // END function Run
+}
+
+int main(int argc, char** argv)
+{
+  return HsnTools::RunTool("LookupEvent", Run, argc, argv);
+} // END function main
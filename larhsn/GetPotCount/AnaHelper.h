@@ -58,6 +58,9 @@
 #include "larcoreobj/SummaryData/POTSummary.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
+// larhsn includes
+#include "larhsn/Logging/HsnLog.h"
+
 #ifndef ANAHELPER_H
 #define ANAHELPER_H
 
@@ -18,8 +18,8 @@ private:
   // Declare trees
   TTree *tPotCount;
   TTree *tEventCount;
-  bool fVerbose;
   bool fIsOverlayData;
+  HsnLog::Logger fLog;
 
   // Declare analysis variables
   int run, subrun, nEvents;
@@ -35,8 +35,8 @@ private:
 
 GetPotCount::GetPotCount(fhicl::ParameterSet const & pset) :
     EDAnalyzer(pset),
-    fVerbose(pset.get<bool>("verbose")),
-    fIsOverlayData(pset.get<bool>("isOverlayData"))
+    fIsOverlayData(pset.get<bool>("isOverlayData")),
+    fLog("GetPotCount", pset.get<fhicl::ParameterSet>("Logging"))
 {} // END constructor GetPotCount
 
 GetPotCount::~GetPotCount()
@@ -59,6 +59,8 @@ void GetPotCount::beginJob()
 
 void GetPotCount::endJob()
 {
+  fLog.PrintSummary();
+  fLog.Flush();
 } // END function endJob
 
 void GetPotCount::ClearData()
@@ -123,9 +125,8 @@ void GetPotCount::endSubRun(art::SubRun const & sr)
 
   } // END if isOverlayData
 
-  std::cout << "----------------------------" << std::endl;
-  std::cout << "Total POT / subRun: " << pot << std::endl;
-  std::cout << "----------------------------" << std::endl;
+  HSN_INFO(fLog, "Pot", "----------------------------\nTotal POT / subRun: %g\n----------------------------\n", pot);
+  fLog.Flush();
 
   nEvents = events.size();
   tPotCount->Fill();
@@ -0,0 +1,277 @@
+/******************************************************************************
+ * @file SumPot.cc
+ * @brief Writes the PotCount tree of GetPotCount from the SubRuns tree of art files, several files at a time, without an art job
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  GetPotCount_module.cc
+ *
+ * Usage: SumPot -o <potCount.root> [-O] [-e] [-j <threads>] [-p <process>] [-S <file list>] [input.root ...]
+ *   -O  overlay sample (isOverlayData of GetPotCount)
+ *   -e  also read the EventAuxiliary branch of the Events tree, to fill the events and nEvents branches (otherwise empty and -1)
+ *   -p  process name of the POTSummary products, needed when a file holds them from several processes
+ * Every input file is opened with plain ROOT I/O and only the SubRunAuxiliary, generator and beamdata:bnbETOR860 POTSummary branches
+ * of its SubRuns tree are read, on a pool of threads. The subruns are then summed as GetPotCount::endSubRun does, in the order art visits
+ * them (input files in order, the subruns and events of each file sorted by ID as in its FileIndex, not in entry order; the running
+ * differences of the overlay depend on it), and written to the PotCount tree in the GetPotCount directory. Data or MC is taken from the first event of each file.
+ * The dictionaries are loaded by ROOT from the rootmap files, so the art environment must be set up.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TTree.h"
+
+// framework includes
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/SubRunAuxiliary.h"
+#include "cetlib/exception.h"
+
+// larsoft object includes
+#include "larcoreobj/SummaryData/POTSummary.h"
+
+// larhsn includes
+#include "larhsn/FileLocationDatabase/Index/ToolHelpers.h"
+
+namespace
+{
+  using POTWrapper = art::Wrapper<sumdata::POTSummary>;
+
+  // One entry of the SubRuns tree
+  struct SubRunPot
+  {
+    int run, subrun;
+    bool hasMcPot, hasDataPot;
+    double mcPot, dataPot;
+    std::vector<int> events;
+  };
+
+  // Subruns of one input file, in the order art visits them
+  struct FilePot
+  {
+    std::vector<SubRunPot> subruns;
+    bool isRealData = false;
+    std::string error; // Set by the worker instead of throwing, the main thread reports it
+  };
+
+  void PrintUsage()
+  {
+    printf("Usage: SumPot -o <potCount.root> [-O] [-e] [-j <threads>] [-p <process>] [-S <file list>] [input.root ...]\n");
+  }
+
+  // Name of the branch of a product (art names it type_label_instance_process.), empty if the file does not have it.
+  // Returns false if the product was made by several processes and no process was given.
+  bool FindProductBranch(TTree* tree, const std::string & prefix, const std::string & process, std::string & branchName)
+  {
+    branchName.clear();
+    TObjArray* branches = tree->GetListOfBranches();
+    for (int i=0; i!=branches->GetEntriesFast(); i++)
+    {
+      const std::string name = static_cast<TBranch*>(branches->At(i))->GetName();
+      if (name.compare(0, prefix.size(), prefix) != 0) continue;
+      if (!process.empty() && name != prefix + process + ".") continue;
+      if (!branchName.empty()) return false;
+      branchName = name;
+    }
+    return true;
+  }
+
+  // Reads the POT of every subrun of one art file. Each thread opens its own TFile, nothing else is shared.
+  void ReadFile(const std::string & fileName, const std::string & process, bool readEvents, FilePot & filePot)
+  {
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (!file || file->IsZombie())
+    {
+      filePot.error = "Could not open " + fileName + ".";
+      return;
+    }
+    TTree* subruns = nullptr;
+    TTree* events = nullptr;
+    file->GetObject("SubRuns", subruns);
+    file->GetObject("Events", events);
+    if (!subruns)
+    {
+      filePot.error = "No SubRuns tree in " + fileName + ", it is not an art file.";
+      return;
+    }
+
+    std::string mcBranch, dataBranch;
+    if (!FindProductBranch(subruns, "sumdata::POTSummary_generator__", process, mcBranch) ||
+        !FindProductBranch(subruns, "sumdata::POTSummary_beamdata_bnbETOR860_", process, dataBranch))
+    {
+      filePot.error = "POTSummary products of several processes in " + fileName + ", choose one with -p.";
+      return;
+    }
+    art::SubRunAuxiliary* subRunAux = nullptr;
+    POTWrapper* mcPot = nullptr;
+    POTWrapper* dataPot = nullptr;
+    subruns->SetBranchStatus("*", false);
+    subruns->SetBranchStatus("SubRunAuxiliary*", true);
+    subruns->SetBranchAddress("SubRunAuxiliary", &subRunAux);
+    if (!mcBranch.empty())
+    {
+      subruns->SetBranchStatus((mcBranch + "*").c_str(), true);
+      subruns->SetBranchAddress(mcBranch.c_str(), &mcPot);
+    }
+    if (!dataBranch.empty())
+    {
+      subruns->SetBranchStatus((dataBranch + "*").c_str(), true);
+      subruns->SetBranchAddress(dataBranch.c_str(), &dataPot);
+    }
+    for (Long64_t i=0; i!=subruns->GetEntries(); i++)
+    {
+      subruns->GetEntry(i);
+      SubRunPot subrun;
+      subrun.run = subRunAux->id().run();
+      subrun.subrun = subRunAux->id().subRun();
+      // Same as a failed getByLabel in GetPotCount::endSubRun
+      subrun.hasMcPot = mcPot && mcPot->isPresent();
+      subrun.hasDataPot = dataPot && dataPot->isPresent();
+      subrun.mcPot = subrun.hasMcPot ? mcPot->product()->totpot : 0.;
+      subrun.dataPot = subrun.hasDataPot ? dataPot->product()->totpot : 0.;
+      filePot.subruns.push_back(std::move(subrun));
+    }
+    subruns->ResetBranchAddresses();
+    delete subRunAux;
+    delete mcPot;
+    delete dataPot;
+
+    // art visits the subruns of a file, and the events of each subrun, sorted by ID (its FileIndex order)
+    std::stable_sort(filePot.subruns.begin(), filePot.subruns.end(), [](const SubRunPot & a, const SubRunPot & b)
+      {return std::make_pair(a.run, a.subrun) < std::make_pair(b.run, b.subrun);});
+    std::map<std::pair<int,int>, size_t> subrunEntry;
+    for (size_t i=0; i!=filePot.subruns.size(); i++) subrunEntry[std::make_pair(filePot.subruns[i].run, filePot.subruns[i].subrun)] = i;
+
+    // Data or MC from the first event, or all the event numbers with -e
+    filePot.isRealData = mcBranch.empty();
+    const Long64_t nEvents = events ? (readEvents ? events->GetEntries() : std::min(events->GetEntries(), Long64_t(1))) : 0;
+    if (nEvents == 0) return;
+    art::EventAuxiliary* eventAux = nullptr;
+    events->SetBranchStatus("*", false);
+    events->SetBranchStatus("EventAuxiliary*", true);
+    events->SetBranchAddress("EventAuxiliary", &eventAux);
+    for (Long64_t i=0; i!=nEvents; i++)
+    {
+      events->GetEntry(i);
+      if (i == 0) filePot.isRealData = eventAux->isRealData();
+      if (!readEvents) break;
+      auto it = subrunEntry.find(std::make_pair((int) eventAux->id().run(), (int) eventAux->id().subRun()));
+      if (it != subrunEntry.end()) filePot.subruns[it->second].events.push_back(eventAux->id().event());
+    }
+    events->ResetBranchAddresses();
+    delete eventAux;
+    for (SubRunPot & subrun : filePot.subruns) std::sort(subrun.events.begin(), subrun.events.end());
+  } // END function ReadFile
+
+  int Run(int argc, char** argv)
+  {
+    std::string outputName, process, listName;
+    bool isOverlayData = false;
+    bool readEvents = false;
+    size_t nThreads = HsnTools::DefaultNumThreads();
+    int option;
+    while ((option = getopt(argc, argv, "o:Oej:p:S:h")) != -1)
+    {
+      switch (option)
+      {
+        case 'o': outputName = optarg; break;
+        case 'O': isOverlayData = true; break;
+        case 'e': readEvents = true; break;
+        case 'j': nThreads = std::max(1, atoi(optarg)); break;
+        case 'p': process = optarg; break;
+        case 'S': listName = optarg; break;
+        default: PrintUsage(); return 1;
+      }
+    }
+    std::vector<std::string> fileNames;
+    if (!listName.empty()) HsnTools::ReadFileList(listName, fileNames);
+    for (int i=optind; i<argc; i++) fileNames.push_back(argv[i]);
+    if (outputName.empty() || fileNames.empty())
+    {
+      PrintUsage();
+      return 1;
+    }
+
+    // Files are handed to the threads one at a time, the results are kept in input order
+    auto tStart = std::chrono::steady_clock::now();
+    std::vector<FilePot> filePots(fileNames.size());
+    nThreads = HsnTools::ParallelFor(fileNames.size(), nThreads, [&](size_t f) {ReadFile(fileNames[f], process, readEvents, filePots[f]);});
+    for (const FilePot & filePot : filePots)
+    {
+      if (!filePot.error.empty()) throw cet::exception("SumPot") << filePot.error << "\n";
+    }
+
+    // Same tree as GetPotCount::beginJob, in the directory of the module
+    TFile output(outputName.c_str(), "RECREATE");
+    if (output.IsZombie()) throw cet::exception("SumPot") << "Could not open output file " << outputName << ".\n";
+    output.mkdir("GetPotCount")->cd();
+    int run, subrun, nEvents;
+    std::vector<int> events;
+    double pot, mc_pot, data_pot;
+    TTree* tPotCount = new TTree("PotCount","");
+    tPotCount->Branch("run",&run,"run/I");
+    tPotCount->Branch("subrun",&subrun,"subrun/I");
+    tPotCount->Branch("events",&events);
+    tPotCount->Branch("nEvents",&nEvents);
+    tPotCount->Branch("pot",&pot);
+    tPotCount->Branch("mcPot",&mc_pot);
+    tPotCount->Branch("dataPot",&data_pot);
+
+    // Same sums as GetPotCount::endSubRun, with the running sums of the overlay reset for every input file
+    double totalMcPot = 0.;
+    double totalDataPot = 0.;
+    size_t nSubruns = 0;
+    for (const FilePot & filePot : filePots)
+    {
+      double mc_potSum = 0.;
+      double data_potSum = 0.;
+      for (const SubRunPot & subrunPot : filePot.subruns)
+      {
+        run = subrunPot.run;
+        subrun = subrunPot.subrun;
+        if (isOverlayData)
+        {
+          mc_pot = subrunPot.hasMcPot ? subrunPot.mcPot - mc_potSum : 0.;
+          data_pot = subrunPot.hasDataPot ? subrunPot.dataPot - data_potSum : 0.;
+          mc_potSum += mc_pot;
+          data_potSum += data_pot;
+          pot = mc_potSum;
+        }
+        else
+        {
+          mc_pot = subrunPot.mcPot;
+          data_pot = subrunPot.dataPot;
+          pot = filePot.isRealData ? data_pot : mc_pot;
+        }
+        events = subrunPot.events;
+        nEvents = readEvents ? events.size() : -1;
+        tPotCount->Fill();
+        totalMcPot += mc_pot;
+        totalDataPot += data_pot;
+        nSubruns++;
+      }
+    }
+    output.Write();
+    output.Close();
+
+    const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+    printf("Summed %zu subruns of %zu files with %zu threads in %.2f s: MC POT %g, data POT %g, PotCount tree in %s.\n",
+      nSubruns, fileNames.size(), nThreads, totalTime, totalMcPot, totalDataPot, outputName.c_str());
+    return 0;
+  } // END function Run
+}
+
+int main(int argc, char** argv)
+{
+  return HsnTools::RunTool("SumPot", Run, argc, argv);
+} // END function main
@@ -6,8 +6,7 @@ namespace CalorimetryRadius
   CalorimetryRadiusAlg::CalorimetryRadiusAlg(fhicl::ParameterSet const & pset)
   {
     reconfigure(pset);
-    fGeometry = lar::providerFrom<geo::Geometry>();
-    fDetectorProperties = lar::providerFrom<detinfo::DetectorPropertiesService>();
+    fLog = &HsnLog::DefaultLogger();
   }
   CalorimetryRadiusAlg::~CalorimetryRadiusAlg()
   {}
@@ -16,7 +15,6 @@ namespace CalorimetryRadius
   {
     fPfpLabel = pset.get<std::string>("PfpLabel");
     fHitLabel = pset.get<std::string>("HitLabel");
-    fVerbose = pset.get<bool>("VerboseMode");
     fRadiusProfileLimits = pset.get<std::vector<double>>("RadiusProfileLimits");
     fRadiusProfileBins = pset.get<int>("RadiusProfileBins");
     fChannelNorm = pset.get<double>("ChannelNorm");
@@ -25,133 +23,127 @@ namespace CalorimetryRadius
     // Determine profile ticks
     double profileStep = (fRadiusProfileLimits[1] - fRadiusProfileLimits[0]) / float(fRadiusProfileBins);
     double currTick = fRadiusProfileLimits[0];
+    profileTicks.clear();
+    profileTicks2.clear();
     for (int i=0; i<fRadiusProfileBins; i++)
     {
       currTick += profileStep;
       profileTicks.push_back(currTick);
+      profileTicks2.push_back(currTick*currTick);
     }
   }
 
+  void CalorimetryRadiusAlg::SetLogger(const HsnLog::Logger* logger)
+  {
+    fLog = logger;
+    return;
+  }
+
   
-  // Perform calorimetry analysis. At this stage we finally calculate all the charge deposited by the hits of track1 and track2 (or shower) within a radius from the assumed HSN decay vertex (cleanVertices[i]), for each decay vertex.
+  // Perform calorimetry analysis. At this stage we finally calculate all the charge deposited by the hits of track1 and track2 (or shower) within a radius from the assumed HSN decay vertex, for each candidate.
   // The second step looks at all the charge deposited by any hit in radius (which may come from hadronic interaction, in the case of background). And we finally calculate the ratio between the two (caloRatio). We would expect this ratio to be closer to 1 for signal, since HSN decaying in the detector don't interact with any particle, and we'd expect charge deposited by the two decay products to be the only charge within a certain radius from the decay point.
   // Now, we actually repeat this step for different radia in order to build up a profile. The width of the profile is given by fRadiusProfileLimits and the number of bins by fRadiusProfileBin.
+  // The event hits are bucketed once in a per-plane grid, so each candidate only looks at the hits near its vertex. The total charge profile of those hits comes from the vectorized kernel in RadiusProfileKernel; prong hits are few and are assigned to the smallest radius containing them, then a prefix sum over the radii gives the profile.
   void CalorimetryRadiusAlg::PerformCalorimetry(
-          art::Event const & evt,
+          const AuxEvent::EventSource & evt,
           AuxEvent::EventTreeFiller & evd,
-          std::vector<AuxVertex::DecayVertex>& decayVertices)
+          AuxEvent::HitPool & hitPool,
+          AuxVertex::CandidateBatch& candidates,
+          Workspace & workspace) const
   {
+    // The hits are only read when there are candidates
+    if (candidates.Size() == 0)
+    {
+      ResizeOutput(0, workspace);
+      return;
+    }
+    art::InputTag hitTag {fHitLabel};
+    const AuxEvent::ProductView<recob::Hit> hits = evt.GetHits(hitTag);
+    PerformCalorimetry(*hits, hits.id, evd, hitPool, candidates, workspace);
+    return;
+  } // END function PerformCalorimetry
 
-    // Clean vectors that will be returned by function
-    // evd.calo_prong1ChargeInRadius.clear();
-    // evd.calo_prong2ChargeInRadius.clear();
-    // evd.calo_totChargeInRadius.clear();
-    // evd.calo_caloRatio.clear();
+  void CalorimetryRadiusAlg::PerformCalorimetry(
+          const std::vector<recob::Hit> & hits,
+          art::ProductID hitID,
+          AuxEvent::EventTreeFiller & evd,
+          AuxEvent::HitPool & hitPool,
+          AuxVertex::CandidateBatch& candidates,
+          Workspace & workspace) const
+  {
+    // Prepare vectors that will be returned by function (inner vectors keep their capacity)
+    const size_t nCandidates = candidates.Size();
+    ResizeOutput(nCandidates, workspace);
+    if (nCandidates == 0) return;
 
-    // Prepare total hits vector (this is absolutely inefficient and potentially wrong, must be fixed)
-    // art::InputTag hitTag {fHitLabel};
-    // const auto& hitHandle = evt.getValidHandle< std::vector<recob::Hit> >(hitTag);
-    // std::vector<art::Ptr<recob::Hit>> totHits;
-    // for(std::vector<int>::size_type i=0; i!=(*hitHandle).size(); i++)
-    // {
-    //   art::Ptr<recob::Hit> hit(hitHandle,i);
-    //   // totHits.push_back(hit);
-    // }
+    // Bucket all the event hits, with cells as large as the maximum radius (so at most 3x3 cells are visited per plane)
+    const float maxRadius = profileTicks.back();
+    workspace.hitGrid.Build(hits, fChannelNorm, fTickNorm, maxRadius);
 
-    // // Loop through each decay vertex
-    // for (std::vector<int>::size_type i=0; i!=decayVertices.size(); i++)
-    // {
-    //   AuxVertex::DecayVertex currentVertex = decayVertices[i];
-    //   // Get useful quantities about the decay vertex currently being analyzed, like coordinates and parent indices
-    //   int channel0[3] = {currentVertex.GetChannelLoc(0),currentVertex.GetChannelLoc(1),currentVertex.GetChannelLoc(2)};
-    //   float tick0[3] = {currentVertex.GetTickLoc(0),currentVertex.GetTickLoc(1),currentVertex.GetTickLoc(2)};
-      
-    //   // Initialize the vector of hits that will be pushed back to the vector of vector of hits and returned by the function
-    //   std::vector<recob::Hit const*> totHitsInMaxRadius;
-    //   // Get the vector of hits for the prongs
-    //   std::vector<recob::Hit const*> trackHits1 = currentVertex.GetProngHits(0);
-    //   std::vector<recob::Hit const*> trackHits2 = currentVertex.GetProngHits(0);
+    // Loop through each candidate
+    for (size_t c=0; c!=nCandidates; c++)
+    {
+      const AuxVertex::Planes<int> & channel0 = candidates.fChannelLoc[c];
+      const AuxVertex::Planes<float> & tick0 = candidates.fTickLoc[c];
+      std::vector<float> & prongCharge1 = workspace.tree_calo_prong1ChargeInRadius[c];
+      std::vector<float> & prongCharge2 = workspace.tree_calo_prong2ChargeInRadius[c];
+      std::vector<float> & totCharge = workspace.tree_calo_totChargeInRadius[c];
+      std::vector<float> & caloRatio = workspace.tree_calo_caloRatio[c];
+      prongCharge1.assign(fRadiusProfileBins,0.);
+      prongCharge2.assign(fRadiusProfileBins,0.);
+      totCharge.assign(fRadiusProfileBins,0.);
+      caloRatio.assign(fRadiusProfileBins,0.);
 
-    //   // Calculate calorimetry for track 1 within radius
-    //   // parCharge1 is a vector, which contains all the charge due to particle1 in a circle of radius r around the vertex.
-    //   // Each element of the vector is that integrated charge in increasing value of r
-    //   // It starts out as a vector of size equal to the number of bins in radius profile, each element is equal to 0.
-    //   // A loop goes then through each hit and for each radius size asks whether the hit is in it. If it is, the charge gets added to the total.
-    //   // Now declare parCharge1 and fill it with zeros
-    //   std::vector<float> prongCharge1;
-    //   for (int j=0; j<fRadiusProfileBins; j++) prongCharge1.push_back(0.);
-    //   for (recob::Hit const * hit : trackHits1)
-    //   {
-    //     int hitChannel = hit->Channel();
-    //     double hitTick = (hit->EndTick() + hit->StartTick())/2.;
-    //     int hitPlane = hit->View();
-    //     for (int j=0; j<fRadiusProfileBins; j++)
-    //     {
-    //       double caloCut = profileTicks[j];
-    //       bool isInsideRadius = (pow(((hitChannel-channel0[hitPlane])/fChannelNorm),2.) + pow(((hitTick-tick0[hitPlane])/fTickNorm),2.) < pow(caloCut,2.));
-    //       if (isInsideRadius)
-    //       {
-    //         double hitCharge = hit->Integral();
-    //         prongCharge1[j] += hitCharge;
-    //       } // END if hit is in current radius
-    //     } // END loop for each radius
-    //   } // END loop for each hit
+      // Calculate calorimetry for the two prongs within radius
+      for (int prong=0; prong!=2; prong++)
+      {
+        std::vector<float> & prongCharge = (prong == 0) ? prongCharge1 : prongCharge2;
+        for (const recob::Hit & hit : candidates.GetProngHits(c,prong))
+        {
+          int hitPlane = hit.View();
+          if (hitPlane < 0 || hitPlane >= AuxEvent::HitGrid::kNumPlanes) continue;
+          AddToProfile(workspace.hitGrid.GetDistance2(hit, channel0[hitPlane], tick0[hitPlane]), hit.Integral(), prongCharge);
+        }
+        CumulateProfile(prongCharge);
+      }
 
-    //   // Calculate calorimetry for track 2 within radius
-    //   std::vector<float> prongCharge2;
-    //   for (int j=0; j<fRadiusProfileBins; j++) prongCharge2.push_back(0.);
-    //   for (auto hit : trackHits2)
-    //   {
-    //     int hitChannel = hit->Channel();
-    //     double hitTick = (hit->EndTick() + hit->StartTick())/2.;
-    //     int hitPlane = hit->View();
-    //     for (int j=0; j<fRadiusProfileBins; j++)
-    //     {
-    //       double caloCut = profileTicks[j];
-    //       bool isInsideRadius = (pow(((hitChannel-channel0[hitPlane])/fChannelNorm),2.) + pow(((hitTick-tick0[hitPlane])/fTickNorm),2.) < pow(caloCut,2.));
-    //       if (isInsideRadius)
-    //       {
-    //         double hitCharge = hit->Integral();
-    //         prongCharge2[j] += hitCharge;
-    //       } // END if hit is in current radius
-    //     } // END loop for each radius
-    //   } // END loop for each hit
+      // Calculate total calorimetry within radius, only looking at the hits near the vertex
+      // totHitsInMaxRadius are used to draw the evd, they are the hits within the largest radius
+      workspace.nearKeys.clear();
+      for (int plane=0; plane!=AuxEvent::HitGrid::kNumPlanes; plane++)
+      {
+        workspace.hitGrid.AccumulateProfile(plane, channel0[plane], tick0[plane], profileTicks2.data(), profileTicks2.size(), totCharge.data(), &workspace.nearKeys);
+      }
+      candidates.SetTotHits(c, hitPool.AddKeys(hitID, &hits, workspace.nearKeys));
 
-    //   // Calculate total calorimetry within radius
-    //   std::vector<float> totCharge;
-    //   for (int j=0; j<fRadiusProfileBins; j++) totCharge.push_back(0.);
-    //   for (auto hit : totHits)
-    //   {
-    //     int hitChannel = hit->Channel();
-    //     double hitTick = (hit->EndTick() + hit->StartTick())/2.;
-    //     int hitPlane = hit->View();
-    //     for (int j=0; j<fRadiusProfileBins; j++)
-    //     {
-    //       double caloCut = profileTicks[j];
-    //       bool isInsideRadius = (pow(((hitChannel-channel0[hitPlane])/fChannelNorm),2.) + pow(((hitTick-tick0[hitPlane])/fTickNorm),2.) < pow(caloCut,2.));
-    //       if (isInsideRadius)
-    //       {
-    //         double hitCharge = hit->Integral();
-    //         totCharge[j] += hitCharge;
+      // Calculate the calorimetry ratio
+      for (int j=0; j<fRadiusProfileBins; j++) caloRatio[j] = (prongCharge1[j]+prongCharge2[j])/float(totCharge[j]);
 
-    //         // totHitsInMaxRadius are used to draw the evd, you need to do that only for the largest radius
-    //         if (j == fRadiusProfileBins-1) totHitsInMaxRadius.push_back(hit);
-    //       } // END if hit is in current radius
-    //     } // END loop for each radius
-    //   } // END loop for each hit
+      HSN_DEBUG(*fLog, "Calorimetry", "Candidate %zu: %zu hits within %.1f cm of the vertex.\n", c, workspace.nearKeys.size(), maxRadius);
+    } // END loop for each candidate
+    return;
+  } // END function PerformCalorimetry
 
-    //   // Assign the total hits in maximum radius vertex of pointers to the vertex
-    //   currentVertex.SetTotHits(totHitsInMaxRadius);
+  void CalorimetryRadiusAlg::AddToProfile(float distance2, float charge, std::vector<float> & profile) const
+  {
+    // A hit is inside radius j if its distance is strictly smaller than it, so its first bin is the first radius larger than the distance
+    size_t bin = std::upper_bound(profileTicks2.begin(), profileTicks2.end(), distance2) - profileTicks2.begin();
+    if (bin < profile.size()) profile[bin] += charge;
+    return;
+  }
 
-    //   // Calculate the calorimetry ratio
-    //   std::vector<float> thisCaloRatio;
-    //   for (int j=0; j<fRadiusProfileBins; j++) thisCaloRatio.push_back((prongCharge1[j]+prongCharge2[j])/float(totCharge[j]));
+  void CalorimetryRadiusAlg::CumulateProfile(std::vector<float> & profile) const
+  {
+    for (size_t j=1; j<profile.size(); j++) profile[j] += profile[j-1];
+    return;
+  }
 
-    //   evd.calo_prong1ChargeInRadius.push_back(prongCharge1);
-    //   evd.calo_prong2ChargeInRadius.push_back(prongCharge2);
-    //   evd.calo_totChargeInRadius.push_back(totCharge);
-    //   evd.calo_caloRatio.push_back(thisCaloRatio);
-    // } // END loop for each decay vertex
+  void CalorimetryRadiusAlg::ResizeOutput(size_t nCandidates, Workspace & workspace) const
+  {
+    workspace.tree_calo_prong1ChargeInRadius.resize(nCandidates);
+    workspace.tree_calo_prong2ChargeInRadius.resize(nCandidates);
+    workspace.tree_calo_totChargeInRadius.resize(nCandidates);
+    workspace.tree_calo_caloRatio.resize(nCandidates);
     return;
-  } // END function PerformCalorimetry
-} // END namespace CalorimetryRadius
\ No newline at end of file
+  }
+} // END namespace CalorimetryRadius
@@ -58,8 +58,12 @@
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
 // Auxiliary objects includes
-#include "larhsn/HsnFinder/DataObjects/DecayVertex.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
 #include "larhsn/HsnFinder/DataObjects/EventTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/HitPool.h"
+#include "larhsn/HsnFinder/DataObjects/HitGrid.h"
+#include "larhsn/HsnFinder/DataObjects/EventSource.h"
+#include "larhsn/Logging/HsnLog.h"
 
 namespace CalorimetryRadius
 {
@@ -70,21 +74,37 @@ namespace CalorimetryRadius
     CalorimetryRadiusAlg(fhicl::ParameterSet const & pset);
     ~CalorimetryRadiusAlg();
     void reconfigure(fhicl::ParameterSet const & pset);
+    // Logger of the module
+    void SetLogger(const HsnLog::Logger* logger);
+
+  // Output buffers of PerformCalorimetry, kept by the caller between events so they are not reallocated.
+  struct Workspace
+  {
+    // PerformCalorimetry returns (for each candidate, for each radius in profileTicks)
+    std::vector<std::vector<float>> tree_calo_totChargeInRadius;
+    std::vector<std::vector<float>> tree_calo_prong1ChargeInRadius;
+    std::vector<std::vector<float>> tree_calo_prong2ChargeInRadius;
+    std::vector<std::vector<float>> tree_calo_caloRatio;
+    // Hit grid and scratch space, reused across events
+    AuxEvent::HitGrid hitGrid;
+    std::vector<uint32_t> nearKeys;
+  };
 
   // Algorithms
   void PerformCalorimetry(
-          art::Event const & evt,
+          const AuxEvent::EventSource & evt,
           AuxEvent::EventTreeFiller & evd,
-          std::vector<AuxVertex::DecayVertex>& decayVertices);
-
-  // PerformCalorimetry returns
-  std::vector<std::vector<art::Ptr<recob::Hit>>> ana_calo_totHitsInMaxRadius; // for each hit, for each dv
-
-  int tree_calo_NumTotHits;
-  std::vector<std::vector<float>> tree_calo_totChargeInRadius;
-  std::vector<std::vector<float>> tree_calo_prong1ChargeInRadius;
-  std::vector<std::vector<float>> tree_calo_prong2ChargeInRadius;
-  std::vector<std::vector<float>> tree_calo_caloRatio;
+          AuxEvent::HitPool & hitPool,
+          AuxVertex::CandidateBatch& candidates,
+          Workspace & workspace) const;
+  // Same, on a hit collection in memory. hitID is its product ID, used by the hit pool (also run by Benchmarks/AlgorithmThroughput.cc).
+  void PerformCalorimetry(
+          const std::vector<recob::Hit> & hits,
+          art::ProductID hitID,
+          AuxEvent::EventTreeFiller & evd,
+          AuxEvent::HitPool & hitPool,
+          AuxVertex::CandidateBatch& candidates,
+          Workspace & workspace) const;
 
   private:
     // fhicl parameters
@@ -94,12 +114,16 @@ namespace CalorimetryRadius
     int fRadiusProfileBins;
     double fChannelNorm;
     double fTickNorm;
-    bool fVerbose;
+    const HsnLog::Logger* fLog;
     std::vector<float> profileTicks;
+    std::vector<float> profileTicks2; // Squared radii, used to find the first radius containing a hit
 
-    // microboone services
-    const geo::GeometryCore* fGeometry;
-    const detinfo::DetectorProperties* fDetectorProperties;
+    // Add the charge of a hit to the first radius bin containing it
+    void AddToProfile(float distance2, float charge, std::vector<float> & profile) const;
+    // Turn charge per radius bin into charge within each radius
+    void CumulateProfile(std::vector<float> & profile) const;
+    // One output profile per candidate
+    void ResizeOutput(size_t nCandidates, Workspace & workspace) const;
   };
 
 } // END namespace CalorimetryRadius
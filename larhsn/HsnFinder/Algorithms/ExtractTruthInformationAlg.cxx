@@ -6,8 +6,7 @@ namespace ExtractTruthInformation
   ExtractTruthInformationAlg::ExtractTruthInformationAlg(fhicl::ParameterSet const & pset)
   {
     reconfigure(pset);
-    fGeometry = lar::providerFrom<geo::Geometry>();
-    fDetectorProperties = lar::providerFrom<detinfo::DetectorPropertiesService>();
+    fProjection = nullptr;
   }
   ExtractTruthInformationAlg::~ExtractTruthInformationAlg()
   {}
@@ -17,20 +16,24 @@ namespace ExtractTruthInformation
     fMaxTpcBound = pset.get<std::vector<double>>("MaxTpcBound");
     fMcTrackLabel = pset.get<std::string>("McTrackLabel");
     fIsHSN = pset.get<bool>("IsHSN");
-    fVerbose = pset.get<bool>("VerboseMode");
+  }
+
+  void ExtractTruthInformationAlg::SetProjectionCache(const AuxEvent::ProjectionCache* projection)
+  {
+    fProjection = projection;
+    return;
   }
 
   // Find each neutrino, and associated daughter. For each neutrino, fill every vector with the pfp_neutrino and vectors of pfp_tracks and pfp_showers that are its daughters.
   void ExtractTruthInformationAlg::FillEventTreeWithTruth(
-            art::Event const & evt,
+            const AuxEvent::EventSource & evt,
             AuxEvent::EventTreeFiller & etf,
-            std::vector<AuxVertex::DecayVertex> & ana_decayVertices)
+            const AuxVertex::CandidateBatch & candidates) const
   {
     // Prepare handle labels
     std::string mcTruthLabel = "generator";
     art::InputTag mcTruthTag {mcTruthLabel};
-    const auto& mcTruthHandle = evt.getValidHandle< std::vector<simb::MCTruth> >(mcTruthTag);
-    art::Ptr<simb::MCTruth> mct(mcTruthHandle,0);
+    art::Ptr<simb::MCTruth> mct = evt.GetMCTruths(mcTruthTag).MakePtr(0);
     if (fIsHSN)
     {
       // Convention valid only for HSN! (first mcParticle in first mcTruth is either pi or mu from decay).
@@ -51,10 +54,9 @@ namespace ExtractTruthInformation
     // Loop through each decay vertex and find reco-truth distance
     float minDist = 1e10;
     int minDistInd = -1;
-    for (std::vector<int>::size_type i=0; i!=ana_decayVertices.size(); i++)
+    for (size_t i=0; i!=candidates.Size(); i++)
     {
-      AuxVertex::DecayVertex dv = ana_decayVertices[i];
-      float distance = sqrt( pow((etf.truth_vx - dv.fX),2.) + pow((etf.truth_vy - dv.fY),2.) + pow((etf.truth_vz - dv.fZ),2.) );
+      float distance = sqrt( pow((etf.truth_vx - candidates.fX[i]),2.) + pow((etf.truth_vy - candidates.fY[i]),2.) + pow((etf.truth_vz - candidates.fZ[i]),2.) );
       if ( distance < minDist )
       {
         minDist = distance;
@@ -68,8 +70,9 @@ namespace ExtractTruthInformation
 
 
   void ExtractTruthInformationAlg::FillDrawTreeWithTruth(
-            art::Event const & evt,
-            AuxEvent::DrawTreeFiller & dtf)
+            const AuxEvent::EventSource & evt,
+            AuxEvent::DrawTreeFiller & dtf,
+            Workspace & workspace) const
   {
 
     // Clear vectors
@@ -125,13 +128,12 @@ namespace ExtractTruthInformation
     // Prepare handle labels
     std::string mcTruthLabel = "generator";
     art::InputTag mcTruthTag {mcTruthLabel};
-    const auto& mcTruthHandle = evt.getValidHandle< std::vector<simb::MCTruth> >(mcTruthTag);
-    art::Ptr<simb::MCTruth> mct(mcTruthHandle,0);
+    art::Ptr<simb::MCTruth> mct = evt.GetMCTruths(mcTruthTag).MakePtr(0);
     // And for tracks and showers
     art::InputTag mcTrackTag {fMcTrackLabel};
-    const auto& mcTrackHandle = evt.getValidHandle< std::vector<sim::MCTrack> >(mcTrackTag);
+    const AuxEvent::ProductView<sim::MCTrack> mcTrackHandle = evt.GetMCTracks(mcTrackTag);
     art::InputTag mcShowerTag {fMcTrackLabel};
-    const auto& mcShowerHandle = evt.getValidHandle< std::vector<sim::MCShower> >(mcShowerTag);
+    const AuxEvent::ProductView<sim::MCShower> mcShowerHandle = evt.GetMCShowers(mcShowerTag);
 
     // Extract vertex location
     float nu_xyz[3];
@@ -178,166 +180,111 @@ namespace ExtractTruthInformation
     if (dtf.truth_dv_p2_tickCoordinates<dtf.p2_minTick) dtf.p2_minTick = dtf.truth_dv_p2_tickCoordinates;
     if (dtf.truth_dv_p2_tickCoordinates>dtf.p2_maxTick) dtf.p2_maxTick = dtf.truth_dv_p2_tickCoordinates;
 
-    // Now do it for tracks
+    // Now do it for tracks. The trajectories of the tracks starting inside the TPC are copied to contiguous columns once,
+    // then the last contained point and the exact exit point of all of them are found in a single pass.
+    workspace.trajectories.Clear();
+    workspace.trajectoryIsPrimary.clear();
+    for (const sim::MCTrack & mctrack : *mcTrackHandle)
+    {
+      if (mctrack.size()<=1) continue;
+      float start[3] = {(float) mctrack[0].X(),(float) mctrack[0].Y(),(float) mctrack[0].Z()};
+      if (!IsInsideTpc(start)) continue;
+      for (const sim::MCStep & step : mctrack) workspace.trajectories.AddPoint(step.X(), step.Y(), step.Z());
+      workspace.trajectories.EndTrajectory();
+      workspace.trajectoryIsPrimary.push_back(mctrack.Process()=="primary");
+    }
+    workspace.trajectories.FindExits(fMinTpcBound, fMaxTpcBound, workspace.trajectoryExits);
+
+    // Start and exit of every track, followed by start and end of the contained showers, are projected together
+    workspace.projectionX.clear();
+    workspace.projectionY.clear();
+    workspace.projectionZ.clear();
+    for (size_t t=0; t!=workspace.trajectories.NumTrajectories(); t++)
+    {
+      std::array<float,3> start = workspace.trajectories.GetPoint(t,0);
+      const std::array<float,3> & end = workspace.trajectoryExits[t].xyz;
+      workspace.projectionX.insert(workspace.projectionX.end(), {start[0], end[0]});
+      workspace.projectionY.insert(workspace.projectionY.end(), {start[1], end[1]});
+      workspace.projectionZ.insert(workspace.projectionZ.end(), {start[2], end[2]});
+    }
+    workspace.showerIsPrimary.clear();
+    for (const sim::MCShower & mcshower : *mcShowerHandle)
+    {
+      float start[3] = {(float) mcshower.Start().X(),(float) mcshower.Start().Y(),(float) mcshower.Start().Z()};
+      float end[3] = {(float) mcshower.End().X(),(float) mcshower.End().Y(),(float) mcshower.End().Z()};
+      if (!(IsInsideTpc(start) && IsInsideTpc(end))) continue;
+      workspace.projectionX.insert(workspace.projectionX.end(), {start[0], end[0]});
+      workspace.projectionY.insert(workspace.projectionY.end(), {start[1], end[1]});
+      workspace.projectionZ.insert(workspace.projectionZ.end(), {start[2], end[2]});
+      workspace.showerIsPrimary.push_back(mcshower.Process()=="primary");
+    }
+    workspace.projectedChannels.resize(workspace.projectionX.size());
+    workspace.projectedTicks.resize(workspace.projectionX.size());
+    fProjection->ProjectPoints(workspace.projectionX.data(), workspace.projectionY.data(), workspace.projectionZ.data(), workspace.projectionX.size(), workspace.projectedChannels.data(), workspace.projectedTicks.data());
+
+    // Fill the tracks
     int nPrimaryTracks = 0;
     int nSecondaryTracks = 0;
-    for(std::vector<int>::size_type k=0; k!=(*mcTrackHandle).size(); k++)
+    size_t point = 0;
+    for (size_t t=0; t!=workspace.trajectories.NumTrajectories(); t++, point+=2)
     {
-      art::Ptr<sim::MCTrack> mctrack(mcTrackHandle,k);
-      bool mctrackIsPrimary = (mctrack->Process()=="primary");
-      if (mctrackIsPrimary)
+      if (workspace.trajectoryIsPrimary[t])
       {
-        if ((*mctrack).size()>1)
-        {
-          float start[3] = {(float) mctrack->at(0).X(),(float) mctrack->at(0).Y(),(float) mctrack->at(0).Z()};
-          if (IsInsideTpc(start))
-          {
-            nPrimaryTracks += 1;
-
-            float end[3] = {0.,0.,0.};
-            for(std::vector<int>::size_type j=0; j!=(*mctrack).size(); j++)
-            {
-              float xyz[3] = {(float) mctrack->at(j).X(),(float) mctrack->at(j).Y(),(float) mctrack->at(j).Z()};
-              if (IsInsideTpc(xyz))
-              {
-                end[0] = xyz[0];
-                end[1] = xyz[1];
-                end[2] = xyz[2];
-              }
-            }
-
-            // Placeholders
-            std::vector<int> channelLoc;
-            std::vector<float> tickLoc;
-            // Now convert start to wire-channel
-            XYZtoWireTick(start, channelLoc, tickLoc);
-            dtf.truth_primaryTracks_start_p0_wireCoordinates.push_back(channelLoc[0]);
-            dtf.truth_primaryTracks_start_p0_tickCoordinates.push_back(tickLoc[0]);
-            dtf.truth_primaryTracks_start_p1_wireCoordinates.push_back(channelLoc[1]);
-            dtf.truth_primaryTracks_start_p1_tickCoordinates.push_back(tickLoc[1]);
-            dtf.truth_primaryTracks_start_p2_wireCoordinates.push_back(channelLoc[2]);
-            dtf.truth_primaryTracks_start_p2_tickCoordinates.push_back(tickLoc[2]);
-            // Now convert end to wire-channel 
-            XYZtoWireTick(end, channelLoc, tickLoc);
-            dtf.truth_primaryTracks_end_p0_wireCoordinates.push_back(channelLoc[0]);
-            dtf.truth_primaryTracks_end_p0_tickCoordinates.push_back(tickLoc[0]);
-            dtf.truth_primaryTracks_end_p1_wireCoordinates.push_back(channelLoc[1]);
-            dtf.truth_primaryTracks_end_p1_tickCoordinates.push_back(tickLoc[1]);
-            dtf.truth_primaryTracks_end_p2_wireCoordinates.push_back(channelLoc[2]);
-            dtf.truth_primaryTracks_end_p2_tickCoordinates.push_back(tickLoc[2]);
-          } // END IsInsideTpc condition
-        } // END condition on mcpart length
-      } // END particle is primary condition
+        nPrimaryTracks += 1;
+        PushWireTick(workspace, point,
+          dtf.truth_primaryTracks_start_p0_wireCoordinates, dtf.truth_primaryTracks_start_p0_tickCoordinates,
+          dtf.truth_primaryTracks_start_p1_wireCoordinates, dtf.truth_primaryTracks_start_p1_tickCoordinates,
+          dtf.truth_primaryTracks_start_p2_wireCoordinates, dtf.truth_primaryTracks_start_p2_tickCoordinates);
+        PushWireTick(workspace, point+1,
+          dtf.truth_primaryTracks_end_p0_wireCoordinates, dtf.truth_primaryTracks_end_p0_tickCoordinates,
+          dtf.truth_primaryTracks_end_p1_wireCoordinates, dtf.truth_primaryTracks_end_p1_tickCoordinates,
+          dtf.truth_primaryTracks_end_p2_wireCoordinates, dtf.truth_primaryTracks_end_p2_tickCoordinates);
+      }
       else
       {
-        if ((*mctrack).size()>1)
-        {
-          float start[3] = {(float) mctrack->at(0).X(),(float) mctrack->at(0).Y(),(float) mctrack->at(0).Z()};
-          if (IsInsideTpc(start))
-          {
-            nSecondaryTracks += 1;
-
-            float end[3] = {(float) mctrack->at(0).X(),(float) mctrack->at(0).Y(),(float) mctrack->at(0).Z()};
-            for(std::vector<int>::size_type j=0; j!=(*mctrack).size(); j++)
-            {
-              float xyz[3] = {(float) mctrack->at(j).X(),(float) mctrack->at(j).Y(),(float) mctrack->at(j).Z()};
-              if (IsInsideTpc(xyz))
-              {
-                end[0] = xyz[0];
-                end[1] = xyz[1];
-                end[2] = xyz[2];
-              }
-            }
-
-            // Placeholders
-            std::vector<int> channelLoc;
-            std::vector<float> tickLoc;
-            // Now convert start to wire-channel
-            XYZtoWireTick(start, channelLoc, tickLoc);
-            dtf.truth_secondaryTracks_start_p0_wireCoordinates.push_back(channelLoc[0]);
-            dtf.truth_secondaryTracks_start_p0_tickCoordinates.push_back(tickLoc[0]);
-            dtf.truth_secondaryTracks_start_p1_wireCoordinates.push_back(channelLoc[1]);
-            dtf.truth_secondaryTracks_start_p1_tickCoordinates.push_back(tickLoc[1]);
-            dtf.truth_secondaryTracks_start_p2_wireCoordinates.push_back(channelLoc[2]);
-            dtf.truth_secondaryTracks_start_p2_tickCoordinates.push_back(tickLoc[2]);
-            // Now convert end to wire-channel 
-            XYZtoWireTick(end, channelLoc, tickLoc);
-            dtf.truth_secondaryTracks_end_p0_wireCoordinates.push_back(channelLoc[0]);
-            dtf.truth_secondaryTracks_end_p0_tickCoordinates.push_back(tickLoc[0]);
-            dtf.truth_secondaryTracks_end_p1_wireCoordinates.push_back(channelLoc[1]);
-            dtf.truth_secondaryTracks_end_p1_tickCoordinates.push_back(tickLoc[1]);
-            dtf.truth_secondaryTracks_end_p2_wireCoordinates.push_back(channelLoc[2]);
-            dtf.truth_secondaryTracks_end_p2_tickCoordinates.push_back(tickLoc[2]);
-          } // END IsInsideTpc condition
-        } // END condition on mcpart length
-      } // END particle is NOT primary condition
+        nSecondaryTracks += 1;
+        PushWireTick(workspace, point,
+          dtf.truth_secondaryTracks_start_p0_wireCoordinates, dtf.truth_secondaryTracks_start_p0_tickCoordinates,
+          dtf.truth_secondaryTracks_start_p1_wireCoordinates, dtf.truth_secondaryTracks_start_p1_tickCoordinates,
+          dtf.truth_secondaryTracks_start_p2_wireCoordinates, dtf.truth_secondaryTracks_start_p2_tickCoordinates);
+        PushWireTick(workspace, point+1,
+          dtf.truth_secondaryTracks_end_p0_wireCoordinates, dtf.truth_secondaryTracks_end_p0_tickCoordinates,
+          dtf.truth_secondaryTracks_end_p1_wireCoordinates, dtf.truth_secondaryTracks_end_p1_tickCoordinates,
+          dtf.truth_secondaryTracks_end_p2_wireCoordinates, dtf.truth_secondaryTracks_end_p2_tickCoordinates);
+      }
     } // END loop through mctracks
     dtf.truth_nPrimaryTracks = nPrimaryTracks;
     dtf.truth_nSecondaryTracks = nSecondaryTracks;
 
-    // Now do it for showers
+    // Fill the showers
     int nPrimaryShowers = 0;
     int nSecondaryShowers = 0;
-    for(std::vector<int>::size_type k=0; k!=(*mcShowerHandle).size(); k++)
+    for (size_t s=0; s!=workspace.showerIsPrimary.size(); s++, point+=2)
     {
-      art::Ptr<sim::MCShower> mcshower(mcShowerHandle,k);
-      bool mcshowerIsPrimary = (mcshower->Process()=="primary");
-      if (mcshowerIsPrimary)
+      if (workspace.showerIsPrimary[s])
       {
-        float start[3] = {(float) mcshower->Start().X(),(float) mcshower->Start().Y(),(float) mcshower->Start().Z()};
-        float end[3] = {(float) mcshower->End().X(),(float) mcshower->End().Y(),(float) mcshower->End().Z()};
-        if (IsInsideTpc(start) && IsInsideTpc(end))
-        {
-          nPrimaryShowers += 1;
-          // Placeholders
-          std::vector<int> channelLoc;
-          std::vector<float> tickLoc;
-          // Now convert start to wire-channel
-          XYZtoWireTick(start, channelLoc, tickLoc);
-          dtf.truth_primaryShowers_start_p0_wireCoordinates.push_back(channelLoc[0]);
-          dtf.truth_primaryShowers_start_p0_tickCoordinates.push_back(tickLoc[0]);
-          dtf.truth_primaryShowers_start_p1_wireCoordinates.push_back(channelLoc[1]);
-          dtf.truth_primaryShowers_start_p1_tickCoordinates.push_back(tickLoc[1]);
-          dtf.truth_primaryShowers_start_p2_wireCoordinates.push_back(channelLoc[2]);
-          dtf.truth_primaryShowers_start_p2_tickCoordinates.push_back(tickLoc[2]);
-          // Now convert end to wire-channel 
-          XYZtoWireTick(end, channelLoc, tickLoc);
-          dtf.truth_primaryShowers_end_p0_wireCoordinates.push_back(channelLoc[0]);
-          dtf.truth_primaryShowers_end_p0_tickCoordinates.push_back(tickLoc[0]);
-          dtf.truth_primaryShowers_end_p1_wireCoordinates.push_back(channelLoc[1]);
-          dtf.truth_primaryShowers_end_p1_tickCoordinates.push_back(tickLoc[1]);
-          dtf.truth_primaryShowers_end_p2_wireCoordinates.push_back(channelLoc[2]);
-          dtf.truth_primaryShowers_end_p2_tickCoordinates.push_back(tickLoc[2]);
-        } // END IsInsideTpc condition
-      } // END particle is primary condition
+        nPrimaryShowers += 1;
+        PushWireTick(workspace, point,
+          dtf.truth_primaryShowers_start_p0_wireCoordinates, dtf.truth_primaryShowers_start_p0_tickCoordinates,
+          dtf.truth_primaryShowers_start_p1_wireCoordinates, dtf.truth_primaryShowers_start_p1_tickCoordinates,
+          dtf.truth_primaryShowers_start_p2_wireCoordinates, dtf.truth_primaryShowers_start_p2_tickCoordinates);
+        PushWireTick(workspace, point+1,
+          dtf.truth_primaryShowers_end_p0_wireCoordinates, dtf.truth_primaryShowers_end_p0_tickCoordinates,
+          dtf.truth_primaryShowers_end_p1_wireCoordinates, dtf.truth_primaryShowers_end_p1_tickCoordinates,
+          dtf.truth_primaryShowers_end_p2_wireCoordinates, dtf.truth_primaryShowers_end_p2_tickCoordinates);
+      }
       else
       {
-        float start[3] = {(float) mcshower->Start().X(),(float) mcshower->Start().Y(),(float) mcshower->Start().Z()};
-        float end[3] = {(float) mcshower->End().X(),(float) mcshower->End().Y(),(float) mcshower->End().Z()};
-        if (IsInsideTpc(start) && IsInsideTpc(end))
-        {
-          nSecondaryShowers += 1;
-          // Placeholders
-          std::vector<int> channelLoc;
-          std::vector<float> tickLoc;
-          // Now convert start to wire-channel
-          XYZtoWireTick(start, channelLoc, tickLoc);
-          dtf.truth_secondaryShowers_start_p0_wireCoordinates.push_back(channelLoc[0]);
-          dtf.truth_secondaryShowers_start_p0_tickCoordinates.push_back(tickLoc[0]);
-          dtf.truth_secondaryShowers_start_p1_wireCoordinates.push_back(channelLoc[1]);
-          dtf.truth_secondaryShowers_start_p1_tickCoordinates.push_back(tickLoc[1]);
-          dtf.truth_secondaryShowers_start_p2_wireCoordinates.push_back(channelLoc[2]);
-          dtf.truth_secondaryShowers_start_p2_tickCoordinates.push_back(tickLoc[2]);
-          // Now convert end to wire-channel 
-          XYZtoWireTick(end, channelLoc, tickLoc);
-          dtf.truth_secondaryShowers_end_p0_wireCoordinates.push_back(channelLoc[0]);
-          dtf.truth_secondaryShowers_end_p0_tickCoordinates.push_back(tickLoc[0]);
-          dtf.truth_secondaryShowers_end_p1_wireCoordinates.push_back(channelLoc[1]);
-          dtf.truth_secondaryShowers_end_p1_tickCoordinates.push_back(tickLoc[1]);
-          dtf.truth_secondaryShowers_end_p2_wireCoordinates.push_back(channelLoc[2]);
-          dtf.truth_secondaryShowers_end_p2_tickCoordinates.push_back(tickLoc[2]);
-        } // END IsInsideTpc condition
-      } // END particle is NOT primary condition
+        nSecondaryShowers += 1;
+        PushWireTick(workspace, point,
+          dtf.truth_secondaryShowers_start_p0_wireCoordinates, dtf.truth_secondaryShowers_start_p0_tickCoordinates,
+          dtf.truth_secondaryShowers_start_p1_wireCoordinates, dtf.truth_secondaryShowers_start_p1_tickCoordinates,
+          dtf.truth_secondaryShowers_start_p2_wireCoordinates, dtf.truth_secondaryShowers_start_p2_tickCoordinates);
+        PushWireTick(workspace, point+1,
+          dtf.truth_secondaryShowers_end_p0_wireCoordinates, dtf.truth_secondaryShowers_end_p0_tickCoordinates,
+          dtf.truth_secondaryShowers_end_p1_wireCoordinates, dtf.truth_secondaryShowers_end_p1_tickCoordinates,
+          dtf.truth_secondaryShowers_end_p2_wireCoordinates, dtf.truth_secondaryShowers_end_p2_tickCoordinates);
+      }
     } // END loop through mcShowers
     dtf.truth_nPrimaryShowers = nPrimaryShowers;
     dtf.truth_nSecondaryShowers = nSecondaryShowers;
@@ -345,7 +292,7 @@ namespace ExtractTruthInformation
   } // END function FillDrawTree
 
   // Determine if coordinates are inside TPC
-  bool ExtractTruthInformationAlg::IsInsideTpc(const float* xyz)
+  bool ExtractTruthInformationAlg::IsInsideTpc(const float* xyz) const
   {
     double extraEdge = 0;
     bool isInsideX = (xyz[0]>fMinTpcBound[0]+extraEdge &&
@@ -359,18 +306,19 @@ namespace ExtractTruthInformation
   } // END function IsInsideTpc
 
   // Convert XYZ coordinates to wire-tick coordinates
-  void ExtractTruthInformationAlg::XYZtoWireTick(const float* xyz, std::vector<int>& channelLoc, std::vector<float>& tickLoc)
+  void ExtractTruthInformationAlg::XYZtoWireTick(const float* xyz, std::vector<int>& channelLoc, std::vector<float>& tickLoc) const
   {
+    if (!fProjection)
+    {
+      throw cet::exception("ExtractTruthInformationAlg") << "Wire-tick conversion requested without a projection cache.\n";
+    }
     if (IsInsideTpc(xyz))
     {
-      raw::ChannelID_t channel0 = fGeometry->NearestChannel(xyz,0);
-      raw::ChannelID_t channel1 = fGeometry->NearestChannel(xyz,1);
-      raw::ChannelID_t channel2 = fGeometry->NearestChannel(xyz,2);
-      double tick0 = fDetectorProperties->ConvertXToTicks(xyz[0], 0, 0, 0);
-      double tick1 = fDetectorProperties->ConvertXToTicks(xyz[0], 1, 0, 0);
-      double tick2 = fDetectorProperties->ConvertXToTicks(xyz[0], 2, 0, 0);
-      channelLoc = {(int) channel0,(int) channel1,(int) channel2};
-      tickLoc = { (float) tick0, (float) tick1, (float) tick2};
+      std::array<int,3> channels;
+      std::array<float,3> ticks;
+      fProjection->ProjectPoint(xyz, channels, ticks);
+      channelLoc.assign(channels.begin(), channels.end());
+      tickLoc.assign(ticks.begin(), ticks.end());
     }
     else
     {
@@ -378,4 +326,23 @@ namespace ExtractTruthInformation
       tickLoc = {-999.0,-999.0,-999.0};
     }
   } // END function XYZtoWireTick
+
+  // Append the projection of a point of the last batch to the wire and tick vectors of each plane
+  void ExtractTruthInformationAlg::PushWireTick(
+            const Workspace & workspace,
+            size_t point,
+            std::vector<int>& wire0, std::vector<float>& tick0,
+            std::vector<int>& wire1, std::vector<float>& tick1,
+            std::vector<int>& wire2, std::vector<float>& tick2) const
+  {
+    const std::array<int,3> & channels = workspace.projectedChannels[point];
+    const std::array<float,3> & ticks = workspace.projectedTicks[point];
+    wire0.push_back(channels[0]);
+    tick0.push_back(ticks[0]);
+    wire1.push_back(channels[1]);
+    tick1.push_back(ticks[1]);
+    wire2.push_back(channels[2]);
+    tick2.push_back(ticks[2]);
+    return;
+  } // END function PushWireTick
 } // END namespace ExtractTruthInformation
@@ -61,9 +61,12 @@
 #include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 // Auxiliary objects includes
-#include "larhsn/HsnFinder/DataObjects/DecayVertex.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
 #include "larhsn/HsnFinder/DataObjects/EventTreeFiller.h"
 #include "larhsn/HsnFinder/DataObjects/DrawTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/ProjectionCache.h"
+#include "larhsn/HsnFinder/DataObjects/TrajectoryBatch.h"
+#include "larhsn/HsnFinder/DataObjects/EventSource.h"
 
 namespace ExtractTruthInformation
 {
@@ -74,26 +77,45 @@ namespace ExtractTruthInformation
     ExtractTruthInformationAlg(fhicl::ParameterSet const & pset);
     ~ExtractTruthInformationAlg();
     void reconfigure(fhicl::ParameterSet const & pset);
+    // Per-run detector projection, owned by the module
+    void SetProjectionCache(const AuxEvent::ProjectionCache* projection);
+
+    // Per-event buffers of the truth draw tree, reused for every event of the job.
+    struct Workspace
+    {
+      AuxEvent::TrajectoryBatch trajectories; // Tracks starting inside the TPC
+      std::vector<AuxEvent::TrajectoryExit> trajectoryExits;
+      std::vector<bool> trajectoryIsPrimary, showerIsPrimary;
+      std::vector<float> projectionX, projectionY, projectionZ; // Points projected in one batch
+      std::vector<std::array<int,3>> projectedChannels;
+      std::vector<std::array<float,3>> projectedTicks;
+    };
 
     // Algorithms
     void FillEventTreeWithTruth(
-            art::Event const & evt,
+            const AuxEvent::EventSource & evt,
             AuxEvent::EventTreeFiller & etf,
-            std::vector<AuxVertex::DecayVertex> & ana_decayVertices);
+            const AuxVertex::CandidateBatch & candidates) const;
     void FillDrawTreeWithTruth(
-            art::Event const & evt,
-            AuxEvent::DrawTreeFiller & dtf);
-    void XYZtoWireTick(const float* xyz, std::vector<int>& channelLoc, std::vector<float>& tickLoc);
-    bool IsInsideTpc(const float* xyz);
+            const AuxEvent::EventSource & evt,
+            AuxEvent::DrawTreeFiller & dtf,
+            Workspace & workspace) const;
+    void XYZtoWireTick(const float* xyz, std::vector<int>& channelLoc, std::vector<float>& tickLoc) const;
+    bool IsInsideTpc(const float* xyz) const;
   private:
+    void PushWireTick(
+            const Workspace & workspace,
+            size_t point,
+            std::vector<int>& wire0, std::vector<float>& tick0,
+            std::vector<int>& wire1, std::vector<float>& tick1,
+            std::vector<int>& wire2, std::vector<float>& tick2) const;
+
     std::vector<double> fMinTpcBound;
     std::vector<double> fMaxTpcBound;
     std::string fMcTrackLabel;
-    bool fVerbose;
     bool fIsHSN;
-    // microboone services
-    const geo::GeometryCore* fGeometry;
-    const detinfo::DetectorProperties* fDetectorProperties;
+    // XYZ to (channel, tick) conversions
+    const AuxEvent::ProjectionCache* fProjection;
   };
 
 } // END namespace ExtractTruthInformation
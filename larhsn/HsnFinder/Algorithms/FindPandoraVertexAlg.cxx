@@ -6,8 +6,8 @@ namespace FindPandoraVertex
   FindPandoraVertexAlg::FindPandoraVertexAlg(fhicl::ParameterSet const & pset)
   {
     reconfigure(pset);
-    fGeometry = lar::providerFrom<geo::Geometry>();
-    fDetectorProperties = lar::providerFrom<detinfo::DetectorPropertiesService>();
+    fProjection = nullptr;
+    fLog = &HsnLog::DefaultLogger();
   }
   FindPandoraVertexAlg::~FindPandoraVertexAlg()
   {}
@@ -18,18 +18,55 @@ namespace FindPandoraVertex
     fMaxTpcBound = pset.get<std::vector<double>>("MaxTpcBound");
     fPfpLabel = pset.get<std::string>("PfpLabel");
     fMcsLabel = pset.get<std::string>("McsLabel");
-    fVerbose = pset.get<bool>("VerboseMode");
+  }
+
+  void FindPandoraVertexAlg::SetProjectionCache(const AuxEvent::ProjectionCache* projection)
+  {
+    fProjection = projection;
+    return;
+  }
+
+  void FindPandoraVertexAlg::SetLogger(const HsnLog::Logger* logger)
+  {
+    fLog = logger;
+    return;
   }
 
 
   // Find each neutrino, and associated daughter. For each neutrino, fill every vector with the pfp_neutrino and vectors of pfp_tracks and pfp_showers that are its daughters.
   void FindPandoraVertexAlg::GetPotentialNeutrinoVertices(
-            art::Event const & evt,
+            const AuxEvent::EventSource & evt,
             AuxEvent::EventTreeFiller & etf,
-            std::vector<AuxVertex::DecayVertex> & ana_decayVertices)
+            AuxEvent::HitPool & hitPool,
+            AuxVertex::CandidateBatch & candidates,
+            Workspace & workspace) const
   {
-    if (fVerbose) printf("\n--- GetPotentialNeutrinoVertices message ---\n");
+    HSN_DEBUG(*fLog, "Vertex", "\n--- GetPotentialNeutrinoVertices message ---\n");
+
+    //Prepare the pfp handle
+    art::InputTag pfpTag {fPfpLabel};
+    {
+      AuxEvent::ScopedStageTimer timer(workspace.performance, AuxEvent::kStagePfpScan);
+      const AuxEvent::ProductView<recob::PFParticle> pfps = evt.GetPFParticles(pfpTag);
+      FindTwoProngedNeutrinos(*pfps, [&pfps](size_t i) {return pfps.MakePtr(i);}, etf, workspace);
+    }
+
+    // Resolve associations of all candidates and create the decay vertices
+    {
+      AuxEvent::ScopedStageTimer timer(workspace.performance, AuxEvent::kStageAssociations);
+      ResolveCandidateAssociations(evt,pfpTag,hitPool,workspace);
+    }
+    AuxEvent::CountWork(workspace.performance, AuxEvent::kCountHits, hitPool.NumIndices());
+    AuxEvent::ScopedStageTimer timer(workspace.performance, AuxEvent::kStageVertices);
+    BuildDecayVertices(etf,hitPool,candidates,workspace);
+  } // END function GetPotentialNeutrinoVertices
 
+  void FindPandoraVertexAlg::FindTwoProngedNeutrinos(
+            const std::vector<recob::PFParticle> & pfps,
+            const std::function<art::Ptr<recob::PFParticle>(size_t)> & makePtr,
+            AuxEvent::EventTreeFiller & etf,
+            Workspace & workspace) const
+  {
     // Clear stuff that will be modified by function
     etf.nNeutrinos = 0;
     etf.nTwoProngedNeutrinos = 0;
@@ -42,153 +79,186 @@ namespace FindPandoraVertex
     etf.status_nuWithMissingAssociatedTrack = 0;
     etf.status_nuProngWithMissingAssociatedHits = 0;
 
-    //Prepare the pfp handle
-    art::InputTag pfpTag {fPfpLabel};
-    art::InputTag mcsTag {fMcsLabel};
-    const auto& pfpHandle = evt.getValidHandle< std::vector<recob::PFParticle> >(pfpTag);
-    // const auto& trackHandle = evt.getValidHandle< std::vector<recob::Track> >(pfpTag);
-    const auto& mcsHandle = evt.getValidHandle< std::vector<recob::MCSFitResult> >(mcsTag);
+    // Build the parent->children index once, then only visit primaries and their daughters
+    workspace.pfpHierarchy.Build(pfps);
+    AuxEvent::CountWork(workspace.performance, AuxEvent::kCountPfps, pfps.size());
+    workspace.candidateAssociations.Clear();
 
-    // Loop through each pfp
-    for(std::vector<int>::size_type i=0; i!=(*pfpHandle).size(); i++)
+    // Loop through each primary pfp
+    for (size_t i : workspace.pfpHierarchy.GetPrimaries())
     {
-      art::Ptr<recob::PFParticle> pfp(pfpHandle,i);
-      // Find out if this pfp is a neutrino
-      if (pfp->IsPrimary())
-      {
-        // Fill useful variables for the tree
-        etf.nNeutrinos += 1;
-        etf.neutrinoPdgCode.push_back(pfp->PdgCode());
-        etf.neutrinoNumDaughters.push_back(pfp->NumDaughters());
-        int thisNeutrino_numTracks = 0;
-        int thisNeutrino_numShowers = 0;
-        // ID of current neutrino and vectors where we will fill pointers to daughters (only tracks for now)
-        size_t nuID = pfp->Self();
-        std::vector<art::Ptr<recob::PFParticle>> thisNeutrino_pfpTrackPointers;
-
-        // Diagnostic message
-        if (fVerbose)
-        {
-          printf("Neutrino %i (ID: %i, PDG: %i)\n", etf.nNeutrinos, (int) nuID, pfp->PdgCode());
-          printf("|_Number of daughters: %i (ID:", pfp->NumDaughters());
-
-          // Prepare vector of ID of neutrino daughters
-          auto nuDaughtersID = pfp->Daughters();
-          // Loop through each daughter and print their ID
-          for (std::vector<int>::size_type j=0; j!=nuDaughtersID.size(); j++)
-          {
-            printf(" %i", (int) nuDaughtersID[j]);
-          }
-          printf(" )\n");
-        }
+      const recob::PFParticle & nuPfp = pfps[i];
+      // Fill useful variables for the tree
+      etf.nNeutrinos += 1;
+      etf.neutrinoPdgCode.push_back(nuPfp.PdgCode());
+      etf.neutrinoNumDaughters.push_back(nuPfp.NumDaughters());
+      int thisNeutrino_numTracks = 0;
+      int thisNeutrino_numShowers = 0;
+      // ID of current neutrino and vectors where we will fill pointers to daughters (only tracks for now)
+      size_t nuID = nuPfp.Self();
+      std::vector<art::Ptr<recob::PFParticle>> thisNeutrino_pfpTrackPointers;
 
-        // Loop through each pfp and check if their parent was the neutrino we are currently looping through
-        for(std::vector<int>::size_type j=0; j!=(*pfpHandle).size(); j++)
+      // Diagnostic message
+      if (fLog->IsEnabled(HsnLog::kDebug))
+      {
+        // Prepare vector of ID of neutrino daughters
+        auto nuDaughtersID = nuPfp.Daughters();
+        // Loop through each daughter and collect their ID
+        std::string daughterIDs;
+        for (std::vector<int>::size_type j=0; j!=nuDaughtersID.size(); j++)
         {
-          art::Ptr<recob::PFParticle> daughter_pfp(pfpHandle,j);
-          // Find correct pfp corresponding to daughter we are analyzing
-          if (daughter_pfp->Parent()==nuID)
-          {
-            // Separate in track and shower pfps and save their pointers to corresponding vectors
-            if (daughter_pfp->PdgCode()==13)
-            {
-              if (fVerbose) printf("| |_Found track with ID: %i\n", (int) daughter_pfp->Self());
-              thisNeutrino_numTracks += 1;
-              thisNeutrino_pfpTrackPointers.push_back(daughter_pfp);
-            }
-            if (daughter_pfp->PdgCode()==11)
-            {
-              if (fVerbose) printf("| |_Found shower with ID: %i\n", (int) daughter_pfp->Self());
-              thisNeutrino_numShowers += 1;
-            }
-          }
+          daughterIDs += " " + std::to_string(nuDaughtersID[j]);
         }
-        // Save to vector number of tracks and showers found
-        etf.neutrinoNumTracks.push_back(thisNeutrino_numTracks);
-        etf.neutrinoNumShowers.push_back(thisNeutrino_numShowers);
+        HSN_DEBUG(*fLog, "Vertex", "Neutrino %i (ID: %i, PDG: %i)\n|_Number of daughters: %i (ID:%s )\n", etf.nNeutrinos, (int) nuID, nuPfp.PdgCode(), nuPfp.NumDaughters(), daughterIDs.c_str());
+      }
 
-        // Diagnostic message
-        if (fVerbose)
+      // Loop through the daughters of the neutrino we are currently looping through
+      for (size_t j : workspace.pfpHierarchy.GetChildren(i))
+      {
+        const recob::PFParticle & daughter_pfp = pfps[j];
+        // Separate in track and shower pfps and save their pointers to corresponding vectors
+        if (daughter_pfp.PdgCode()==13)
         {
-          // Cross check, loop through each pointer, make sure their ID is correct and their parent is as well
-          for (auto const& pfpTrack : thisNeutrino_pfpTrackPointers)
-          {
-            printf("| |_Checking saved daughter with ID %i and parent ID %i\n", (int) pfpTrack->Self(), (int) pfpTrack->Parent());
-          }
+          HSN_DEBUG(*fLog, "Vertex", "| |_Found track with ID: %i\n", (int) daughter_pfp.Self());
+          thisNeutrino_numTracks += 1;
+          thisNeutrino_pfpTrackPointers.push_back(makePtr(j));
         }
-        // Diagnostic message
-        if (fVerbose)
+        if (daughter_pfp.PdgCode()==11)
         {
-          printf("|_Summary: %i daughters, %i tracks and %i showers.\n", pfp->NumDaughters(),thisNeutrino_numTracks, thisNeutrino_numShowers);
+          HSN_DEBUG(*fLog, "Vertex", "| |_Found shower with ID: %i\n", (int) daughter_pfp.Self());
+          thisNeutrino_numShowers += 1;
         }
+      }
+      // Save to vector number of tracks and showers found
+      etf.neutrinoNumTracks.push_back(thisNeutrino_numTracks);
+      etf.neutrinoNumShowers.push_back(thisNeutrino_numShowers);
 
-        // If this neutrino contains two and only two tracks we can create a specific decay vertex for it (to use later for calorimetry), but first we have to make sure we have all the associations we need.
-        if (thisNeutrino_numTracks==2)
-        {
-          etf.nTwoProngedNeutrinos += 1;
-          if (fVerbose) printf("|_Neutrino is potential candidate n. %i in event.\n", etf.nTwoProngedNeutrinos);
-
-          // Creating a stupid vector with a pointer to the current neutrino, all other methods won't work so I have to go through this stupid way of retrieving associations
-          std::vector<art::Ptr<recob::PFParticle>> thisNeutrino_pfpNeutrinoPointer;
-          thisNeutrino_pfpNeutrinoPointer.push_back(pfp);
-
-          // Association to vertex and tracks objects of our pfpTracks
-          art::FindOneP<recob::Vertex> nu_pva(thisNeutrino_pfpNeutrinoPointer,evt,pfpTag);
-          art::FindOneP<recob::Vertex> pva(thisNeutrino_pfpTrackPointers,evt,pfpTag);
-          art::FindOneP<recob::Track> pta(thisNeutrino_pfpTrackPointers,evt,pfpTag);
-
-          // Make sure we have the necessary vertices associated with the pfp
-          art::Ptr<recob::Vertex> nuVertex, t1Vertex, t2Vertex;
-          nu_pva.get(0,nuVertex);
-          pva.get(0,t1Vertex);
-          pva.get(1,t2Vertex);
-          bool rightNumVertices = (nuVertex.isNonnull() && t1Vertex.isNonnull() && t2Vertex.isNonnull());
-
-          // Make sure we have the necessary tracks associated with the pfps
-          art::Ptr<recob::Track> t1Track, t2Track;
-          pta.get(0,t1Track);
-          pta.get(1,t2Track);
-          bool rightNumTracks = (t1Track.isNonnull() && t2Track.isNonnull());
-
-          if (!rightNumVertices) etf.status_nuWithMissingAssociatedVertex += 1;
-          if (!rightNumTracks) etf.status_nuWithMissingAssociatedTrack += 1;
-          if (rightNumVertices && rightNumTracks)
-          {
-            if (fVerbose) printf("| | |_Neutrino has correct number of vertex and tracks associated to PFP.\n");
-            std::vector<art::Ptr<recob::Track>> thisNu_tracks = {t1Track, t2Track};
-
-            // Make sure also we have the necessary hits associated to tracks
-            art::FindManyP<recob::Hit> tha(thisNu_tracks,evt,pfpTag);
-            std::vector<art::Ptr<recob::Hit>> t1Hits, t2Hits;
-            tha.get(0,t1Hits);
-            tha.get(1,t2Hits);
-            bool rightNumHits = (t1Hits.size()>1 && t2Hits.size()>1);
-            std::cout << "| |_Track 1: There are " << t1Hits.size() << " associated hits." << std::endl;
-            std::cout << "| |_Track 2: There are " << t2Hits.size() << " associated hits." << std::endl;
-
-            if (!rightNumHits) etf.status_nuProngWithMissingAssociatedHits += 1;
-            else
-            {
-              if (fVerbose) printf("| | |_Neutrino has correct number of hits vectors associated to tracks.\n");
-
-              // For each track, find in the mcsHandle the MCS fit result with the same index (they don't have associations unfortunately but they should be paired by same index, so you can retrieve them this way).
-              art::Ptr<recob::MCSFitResult> t1Mcs(mcsHandle,t1Track.key());
-              art::Ptr<recob::MCSFitResult> t2Mcs(mcsHandle,t2Track.key());
-
-              // Time to dump all associations in the neutrino vertex
-              AuxVertex::DecayVertex nuV(nuVertex,t1Vertex,t2Vertex,t1Track,t2Track,t1Hits,t2Hits,t1Mcs,t2Mcs);
-              nuV.SetDetectorCoordinates(fMinTpcBound,fMaxTpcBound,fGeometry,fDetectorProperties);
-              nuV.PrintInformation();
-              if (nuV.fIsInsideTPC)
-              {
-                etf.nContainedTwoProngedNeutrinos += 1;
-                ana_decayVertices.push_back(nuV);
-              }
-            } // END if right number of hits associations
-          } // END if right number of vertices / tracks associations
-        } // END if neutrino has 2 tracks
-      } // END if pfp is a neutrino
-    } // END loop for each pfp
-  } // END function GetOrderedPFParticles
+      // Diagnostic message
+      // Cross check, loop through each pointer, make sure their ID is correct and their parent is as well
+      for (auto const& pfpTrack : thisNeutrino_pfpTrackPointers)
+      {
+        HSN_DEBUG(*fLog, "Vertex", "| |_Checking saved daughter with ID %i and parent ID %i\n", (int) pfpTrack->Self(), (int) pfpTrack->Parent());
+      }
+      // Diagnostic message
+      HSN_DEBUG(*fLog, "Vertex", "|_Summary: %i daughters, %i tracks and %i showers.\n", nuPfp.NumDaughters(),thisNeutrino_numTracks, thisNeutrino_numShowers);
+
+      // If this neutrino contains two and only two tracks we can create a specific decay vertex for it (to use later for calorimetry), but first we have to make sure we have all the associations we need.
+      // Candidates are only registered here, their associations are resolved for the whole event at once afterwards.
+      if (thisNeutrino_numTracks==2)
+      {
+        etf.nTwoProngedNeutrinos += 1;
+        HSN_DEBUG(*fLog, "Vertex", "|_Neutrino is potential candidate n. %i in event.\n", etf.nTwoProngedNeutrinos);
+        workspace.candidateAssociations.AddCandidate(makePtr(i),thisNeutrino_pfpTrackPointers[0],thisNeutrino_pfpTrackPointers[1]);
+      } // END if neutrino has 2 tracks
+    } // END loop for each primary pfp
+  } // END function FindTwoProngedNeutrinos
+
+  void FindPandoraVertexAlg::BuildDecayVertices(
+            AuxEvent::EventTreeFiller & etf,
+            AuxEvent::HitPool & hitPool,
+            AuxVertex::CandidateBatch & candidates,
+            Workspace & workspace) const
+  {
+    if (!fProjection)
+    {
+      throw cet::exception("FindPandoraVertexAlg") << "Vertex search requested without a projection cache.\n";
+    }
+    candidates.Clear();
+    candidates.SetHitPool(&hitPool);
+    for (size_t c=0; c!=workspace.candidateAssociations.NumCandidates(); c++)
+    {
+      HSN_DEBUG(*fLog, "Vertex", "Candidate %i (neutrino ID: %i)\n", (int) c+1, (int) workspace.candidateAssociations.GetNuPfp(c)->Self());
+      bool rightNumVertices = workspace.candidateAssociations.HasVertices(c);
+      bool rightNumTracks = workspace.candidateAssociations.HasTracks(c);
+      if (!rightNumVertices) etf.status_nuWithMissingAssociatedVertex += 1;
+      if (!rightNumTracks) etf.status_nuWithMissingAssociatedTrack += 1;
+      if (!(rightNumVertices && rightNumTracks)) continue;
+      HSN_DEBUG(*fLog, "Vertex", "| | |_Neutrino has correct number of vertex and tracks associated to PFP.\n");
+
+      // Make sure also we have the necessary hits associated to tracks
+      HSN_DEBUG(*fLog, "Vertex", "| |_Track 1: There are %zu associated hits.\n| |_Track 2: There are %zu associated hits.\n",
+        workspace.candidateAssociations.GetNumProngHits(c,0), workspace.candidateAssociations.GetNumProngHits(c,1));
+      if (!workspace.candidateAssociations.HasHits(c))
+      {
+        etf.status_nuProngWithMissingAssociatedHits += 1;
+        continue;
+      }
+      HSN_DEBUG(*fLog, "Vertex", "| | |_Neutrino has correct number of hits vectors associated to tracks.\n");
+
+      // Time to dump all associations in the candidate batch
+      size_t nuV = candidates.AddCandidate(
+        workspace.candidateAssociations.GetNuVertex(c),
+        workspace.candidateAssociations.GetProngVertex(c,0),
+        workspace.candidateAssociations.GetProngVertex(c,1),
+        workspace.candidateAssociations.GetProngTrack(c,0),
+        workspace.candidateAssociations.GetProngTrack(c,1),
+        workspace.candidateAssociations.GetProngHits(c,0),
+        workspace.candidateAssociations.GetProngHits(c,1),
+        workspace.candidateAssociations.GetProngMcs(c,0),
+        workspace.candidateAssociations.GetProngMcs(c,1));
+      candidates.SetDetectorCoordinates(nuV,fMinTpcBound,fMaxTpcBound,*fProjection);
+      candidates.PrintInformation(nuV, *fLog);
+      if (candidates.fIsInsideTPC[nuV]) etf.nContainedTwoProngedNeutrinos += 1;
+      else candidates.PopBack();
+    } // END loop for each candidate
+  } // END function BuildDecayVertices
+
+  // Retrieve vertices, tracks, hits and MCS fit results of every registered candidate with one query per association type (instead of one set of queries per candidate).
+  void FindPandoraVertexAlg::ResolveCandidateAssociations(
+            const AuxEvent::EventSource & evt,
+            art::InputTag const & pfpTag,
+            AuxEvent::HitPool & hitPool,
+            Workspace & workspace) const
+  {
+    const size_t nCandidates = workspace.candidateAssociations.NumCandidates();
+    if (nCandidates==0) return;
+    art::InputTag mcsTag {fMcsLabel};
+    const AuxEvent::ProductView<recob::MCSFitResult> mcsResults = evt.GetMcsFitResults(mcsTag);
+
+    // Vertices: query is [neutrinos..., prongs...]
+    const std::vector<art::Ptr<recob::Vertex>> & vertices = workspace.associatedVertices;
+    evt.FindVertices(workspace.candidateAssociations.GetVertexQuery(),pfpTag,workspace.associatedVertices);
+    AuxEvent::CountWork(workspace.performance, AuxEvent::kCountAssociations, 3*nCandidates);
+    for (size_t c=0; c!=nCandidates; c++)
+    {
+      workspace.candidateAssociations.SetNuVertex(c,vertices[c]);
+      workspace.candidateAssociations.SetProngVertex(c,0,vertices[nCandidates+2*c]);
+      workspace.candidateAssociations.SetProngVertex(c,1,vertices[nCandidates+2*c+1]);
+    }
+
+    // Tracks: query is [prongs...]
+    const std::vector<art::Ptr<recob::Track>> & tracks = workspace.associatedTracks;
+    evt.FindTracks(workspace.candidateAssociations.GetTrackQuery(),pfpTag,workspace.associatedTracks);
+    AuxEvent::CountWork(workspace.performance, AuxEvent::kCountAssociations, 2*nCandidates);
+    std::vector<art::Ptr<recob::Track>> hitQuery;
+    std::vector<size_t> hitQueryCandidate;
+    for (size_t c=0; c!=nCandidates; c++)
+    {
+      const art::Ptr<recob::Track> & t1Track = tracks[2*c];
+      const art::Ptr<recob::Track> & t2Track = tracks[2*c+1];
+      workspace.candidateAssociations.SetProngTrack(c,0,t1Track);
+      workspace.candidateAssociations.SetProngTrack(c,1,t2Track);
+      // Only candidates with complete vertices and tracks need hits and MCS results
+      if (!workspace.candidateAssociations.HasVertices(c) || !workspace.candidateAssociations.HasTracks(c)) continue;
+      hitQuery.push_back(t1Track);
+      hitQuery.push_back(t2Track);
+      hitQueryCandidate.push_back(c);
+      // MCS fit results have no associations, but they are paired to tracks by index.
+      workspace.candidateAssociations.SetProngMcs(c,0,mcsResults.MakePtr(t1Track.key()));
+      workspace.candidateAssociations.SetProngMcs(c,1,mcsResults.MakePtr(t2Track.key()));
+    }
+    if (hitQuery.empty()) return;
+
+    // Hits: query is [tracks of complete candidates...], only their indices are kept in the hit pool
+    evt.FindHits(hitQuery,pfpTag,workspace.associatedHits);
+    AuxEvent::CountWork(workspace.performance, AuxEvent::kCountAssociations, hitQuery.size());
+    for (size_t q=0; q!=hitQueryCandidate.size(); q++)
+    {
+      for (int prong=0; prong!=2; prong++)
+      {
+        workspace.candidateAssociations.SetProngHits(hitQueryCandidate[q],prong,hitPool.AddHits(evt,workspace.associatedHits[2*q+prong]));
+      }
+    }
+  } // END function ResolveCandidateAssociations
 
 } // END namespace FindPandoraVertex
@@ -10,6 +10,7 @@
 #include <algorithm>
 #include <chrono>
 #include <exception>
+#include <functional>
 
 // root includes
 #include "TInterpreter.h"
@@ -60,8 +61,15 @@
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
 // Auxiliary objects includes
-#include "larhsn/HsnFinder/DataObjects/DecayVertex.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
 #include "larhsn/HsnFinder/DataObjects/EventTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/PfpHierarchy.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateAssociations.h"
+#include "larhsn/HsnFinder/DataObjects/HitPool.h"
+#include "larhsn/HsnFinder/DataObjects/EventSource.h"
+#include "larhsn/HsnFinder/DataObjects/ProjectionCache.h"
+#include "larhsn/HsnFinder/DataObjects/EventPerformance.h"
+#include "larhsn/Logging/HsnLog.h"
 
 
 
@@ -74,24 +82,60 @@ namespace FindPandoraVertex
     FindPandoraVertexAlg(fhicl::ParameterSet const & pset);
     ~FindPandoraVertexAlg();
     void reconfigure(fhicl::ParameterSet const & pset);
+    // Per-run detector projection, owned by the module
+    void SetProjectionCache(const AuxEvent::ProjectionCache* projection);
+    // Logger of the module
+    void SetLogger(const HsnLog::Logger* logger);
+
+    // Per-event state of the algorithm, part of the HsnFinderEventAlg workspace and cleared at the start of every event.
+    struct Workspace
+    {
+      AuxEvent::PfpHierarchy pfpHierarchy; // Parent->children index of the pfps (can be reused for other traversals)
+      AuxEvent::CandidateAssociations candidateAssociations; // Associations of the two-pronged candidates
+      std::vector<art::Ptr<recob::Vertex>> associatedVertices; // Results of the association queries
+      std::vector<art::Ptr<recob::Track>> associatedTracks;
+      std::vector<std::vector<art::Ptr<recob::Hit>>> associatedHits;
+      AuxEvent::EventPerformance* performance = nullptr; // Stage timers of the event, null when they are disabled
+    };
 
     // Algorithms
     void GetPotentialNeutrinoVertices(
-            art::Event const & evt,
+            const AuxEvent::EventSource & evt,
             AuxEvent::EventTreeFiller & evd,
-            std::vector<AuxVertex::DecayVertex> & ana_decayVertices);
+            AuxEvent::HitPool & hitPool,
+            AuxVertex::CandidateBatch & candidates,
+            Workspace & workspace) const;
+
+    // Stages of GetPotentialNeutrinoVertices that only use collections in memory (also run by Benchmarks/AlgorithmThroughput.cc).
+    // Register the neutrinos with exactly two track daughters in workspace.candidateAssociations. makePtr(i) returns the art::Ptr to pfps[i].
+    void FindTwoProngedNeutrinos(
+            const std::vector<recob::PFParticle> & pfps,
+            const std::function<art::Ptr<recob::PFParticle>(size_t)> & makePtr,
+            AuxEvent::EventTreeFiller & etf,
+            Workspace & workspace) const;
+    // Make the decay vertices of the registered candidates from their resolved associations, keeping the ones inside the TPC
+    void BuildDecayVertices(
+            AuxEvent::EventTreeFiller & etf,
+            AuxEvent::HitPool & hitPool,
+            AuxVertex::CandidateBatch & candidates,
+            Workspace & workspace) const;
 
   private:
+    void ResolveCandidateAssociations(
+            const AuxEvent::EventSource & evt,
+            art::InputTag const & pfpTag,
+            AuxEvent::HitPool & hitPool,
+            Workspace & workspace) const;
+
     // fhicl parameters
     std::string fPfpLabel;
     std::string fMcsLabel;
     std::vector<double> fMinTpcBound;
     std::vector<double> fMaxTpcBound;
-    bool fVerbose;
 
-    // microboone services
-    const geo::GeometryCore* fGeometry;
-    const detinfo::DetectorProperties* fDetectorProperties;
+    // XYZ to (channel, tick) conversions
+    const AuxEvent::ProjectionCache* fProjection;
+    const HsnLog::Logger* fLog;
   };
 
 } // END namespace FindPandoraVertex
@@ -0,0 +1,149 @@
+#include "HsnFinderEventAlg.h"
+
+namespace HsnFinderEvent
+{
+  // Constructor/destructor
+  HsnFinderEventAlg::HsnFinderEventAlg(fhicl::ParameterSet const & pset) :
+    fFindPandoraVertexAlg(pset),
+    fCalorimetryRadiusAlg(pset),
+    fExtractTruthInformationAlg(pset)
+  {
+    reconfigure(pset);
+    fLog = &HsnLog::DefaultLogger();
+    // The algorithms only keep a pointer to the projection cache, which is built later by the caller
+    fFindPandoraVertexAlg.SetProjectionCache(&fProjectionCache);
+    fExtractTruthInformationAlg.SetProjectionCache(&fProjectionCache);
+  }
+  HsnFinderEventAlg::~HsnFinderEventAlg()
+  {}
+
+  void HsnFinderEventAlg::reconfigure(fhicl::ParameterSet const & pset)
+  {
+    fCenterCoordinates = pset.get<std::vector<double>>("CenterCoordinates");
+    fSaveDrawTree = pset.get<bool>("SaveDrawTree");
+    fSaveTruthDrawTree = pset.get<bool>("SaveTruthDrawTree");
+    fUseTruthDistanceMetric = pset.get<bool>("UseTruthDistanceMetric");
+    fRangeTableMaxRange = pset.get<double>("RangeTableMaxRange");
+    fRangeTableStep = pset.get<double>("RangeTableStep");
+    fValidateRangeTable = pset.get<bool>("ValidateRangeTable");
+    fRangeTableTolerance = pset.get<double>("RangeTableTolerance");
+    fStageTimers = pset.get<bool>("StageTimers");
+  }
+
+  void HsnFinderEventAlg::SetLogger(const HsnLog::Logger* logger)
+  {
+    fLog = logger;
+    fFindPandoraVertexAlg.SetLogger(logger);
+    fCalorimetryRadiusAlg.SetLogger(logger);
+    return;
+  }
+
+  double HsnFinderEventAlg::BuildRangeTable(double density)
+  {
+    // Built once for the whole job and shared with the candidates
+    fRangeTable.Build(fRangeTableMaxRange, fRangeTableStep, density);
+    HSN_DEBUG(*fLog, "RangeTable", "Range tables built for an argon density of %.17g g/cm3.\n", density);
+    // Below 2 cm the proton fit in TrackMomentumCalculator is not accurate enough to be used as a reference
+    if (fValidateRangeTable) return fRangeTable.Validate(2., fRangeTableTolerance, *fLog);
+    return 0.;
+  } // END function BuildRangeTable
+
+  AuxEvent::ProjectionCache & HsnFinderEventAlg::GetProjectionCache() {return fProjectionCache;}
+  const AuxEvent::ProjectionCache & HsnFinderEventAlg::GetProjectionCache() const {return fProjectionCache;}
+
+  std::unique_ptr<HsnFinderEventAlg::Workspace> HsnFinderEventAlg::MakeWorkspace() const
+  {
+    std::unique_ptr<Workspace> workspace(new Workspace);
+    // The range tables are built once for the whole job and shared by the candidates of every workspace
+    workspace->candidates.SetRangeTable(&fRangeTable);
+    return workspace;
+  } // END function MakeWorkspace
+
+  // This is where all the functions are executed. Gets repeated event by event.
+  void HsnFinderEventAlg::ProcessEvent(const AuxEvent::EventSource & evt, Workspace & workspace) const
+  {
+    const art::EventID id = evt.ID();
+    int run = id.run();
+    int subrun = id.subRun();
+    int event = id.event();
+    HSN_DEBUG(*fLog, "Event", "\n\n\n---------------------------------------------------\n||HSN FINDER MODULE: EVENT %i [RUN %i, SUBRUN %i]||\n", event, subrun, run);
+
+    // Determine event ID and initialize event tree filler.
+    // The event tree filler is a special class in which we fill all the information we want to know about the current event.
+    // At the end of the event the record with all the fillers is handed to the output, which fills them into the anatree.
+    AuxEvent::EventRecord & record = workspace.record;
+    AuxEvent::EventTreeFiller & eventRow = record.event;
+    AuxVertex::CandidateBatch & candidates = workspace.candidates;
+    eventRow.Initialize(run,subrun,event);
+    record.candidates.clear();
+    record.draws.clear();
+    // Stage timers: a null row turns them off
+    record.performance.Initialize(run,subrun,event);
+    AuxEvent::EventPerformance* performance = fStageTimers ? &record.performance : nullptr;
+    workspace.vertexWorkspace.performance = performance;
+
+    // Search among pfparticles and get vector of potential neutrino pfps with only two tracks. Return vectors of pfps for neutrinos, tracks and showers in event and decay vertices, which contain information about neutrino vertices with exctly two tracks.
+    workspace.hitPool.Clear();
+    fFindPandoraVertexAlg.GetPotentialNeutrinoVertices(evt, eventRow, workspace.hitPool, candidates, workspace.vertexWorkspace);
+    eventRow.nHsnCandidates = candidates.Size();
+
+    // Now, IF there are any candidates, go on. Otherwise you can stop here
+    if (candidates.Size() == 0)
+    {
+      HSN_DEBUG(*fLog, "Event", "No clean vertex candidates found. Moving to next event...\n");
+      return;
+    }
+    else
+    {
+      // IF there are candidate, continue with analysis
+      // Perform calorimetry analysis
+      const CalorimetryRadius::CalorimetryRadiusAlg::Workspace & calo = workspace.caloWorkspace;
+      {
+        AuxEvent::ScopedStageTimer timer(performance, AuxEvent::kStageCalorimetry);
+        fCalorimetryRadiusAlg.PerformCalorimetry(evt, eventRow, workspace.hitPool, candidates, workspace.caloWorkspace);
+      }
+
+      // If want to use reco-truth distance as a metric for finding best HSN candidate, do it here.
+      if ( fUseTruthDistanceMetric )
+      {
+        AuxEvent::ScopedStageTimer timer(performance, AuxEvent::kStageTruth);
+        fExtractTruthInformationAlg.FillEventTreeWithTruth(evt,eventRow,candidates);
+      }
+
+      // Now loop for each candidate and fill the rows
+      AuxEvent::ScopedStageTimer rowsTimer(performance, AuxEvent::kStageRows);
+      AuxEvent::CountWork(performance, AuxEvent::kCountCandidates, candidates.Size());
+      record.candidates.resize(candidates.Size());
+      if (fSaveDrawTree) record.draws.resize(candidates.Size());
+      for (size_t i=0; i!=candidates.Size(); i++)
+      {
+        // The candidate tree filler is a special class in which we fill all the information we want to know about the current HSN candidate.
+        // There is one in each event for every candidate.
+        AuxEvent::CandidateTreeFiller & candidateRow = record.candidates[i];
+        candidateRow.Initialize(eventRow,i,candidates,fCenterCoordinates);
+        candidateRow.calo_totChargeInRadius = calo.tree_calo_totChargeInRadius[i];
+        candidateRow.calo_prong1ChargeInRadius = calo.tree_calo_prong1ChargeInRadius[i];
+        candidateRow.calo_prong2ChargeInRadius = calo.tree_calo_prong2ChargeInRadius[i];
+        candidateRow.calo_caloRatio = calo.tree_calo_caloRatio[i];
+
+        // If requested, do the same for the draw tree
+        if (fSaveDrawTree)
+        {
+          AuxEvent::DrawTreeFiller & drawRow = record.draws[i];
+          drawRow.Initialize(eventRow,i,candidates);
+          if (fSaveTruthDrawTree)
+          {
+            // Counted as truth extraction, not as row filling
+            rowsTimer.Stop();
+            {
+              AuxEvent::ScopedStageTimer timer(performance, AuxEvent::kStageTruth);
+              fExtractTruthInformationAlg.FillDrawTreeWithTruth(evt,drawRow,workspace.truthWorkspace);
+            }
+            rowsTimer.Start(performance);
+          }
+        }
+      } // END FOR loop for each candidate
+    } // END IF there are any candidates
+  } // END function ProcessEvent
+
+} // END namespace HsnFinderEvent
@@ -0,0 +1,90 @@
+#ifndef HSNFINDEREVENTALG_H
+#define HSNFINDEREVENTALG_H
+
+// c++ includes
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+// framework includes
+#include "fhiclcpp/ParameterSet.h"
+
+// Auxiliary objects includes
+#include "larhsn/HsnFinder/Algorithms/FindPandoraVertexAlg.h"
+#include "larhsn/HsnFinder/Algorithms/CalorimetryRadiusAlg.h"
+#include "larhsn/HsnFinder/Algorithms/ExtractTruthInformationAlg.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
+#include "larhsn/HsnFinder/DataObjects/EventRecord.h"
+#include "larhsn/HsnFinder/DataObjects/EventSource.h"
+#include "larhsn/HsnFinder/DataObjects/HitPool.h"
+#include "larhsn/HsnFinder/DataObjects/ProjectionCache.h"
+#include "larhsn/HsnFinder/DataObjects/RangeMomentumTable.h"
+#include "larhsn/HsnFinder/DataObjects/EventPerformance.h"
+#include "larhsn/Logging/HsnLog.h"
+
+
+
+namespace HsnFinderEvent
+{
+
+  // The per-event work of HsnFinder: runs the algorithms on an event and makes its tree rows.
+  // Shared by the art module and the gallery runner, which only differ in where the events come from and how the detector is described.
+  class HsnFinderEventAlg
+  {
+  public:
+    HsnFinderEventAlg(fhicl::ParameterSet const & pset);
+    ~HsnFinderEventAlg();
+    void reconfigure(fhicl::ParameterSet const & pset);
+    // Logger of the caller, also given to the algorithms
+    void SetLogger(const HsnLog::Logger* logger);
+
+    // Build the range to momentum tables for the argon density [g/cm^3] and validate them if requested.
+    // Returns the largest relative deviation found by the validation (0 without it).
+    double BuildRangeTable(double density);
+    // XYZ to (channel, tick) transforms used by the algorithms, built by the caller (at every new run in the module)
+    AuxEvent::ProjectionCache & GetProjectionCache();
+    const AuxEvent::ProjectionCache & GetProjectionCache() const;
+
+    // Everything an event needs while it is processed. The module (and the gallery runner) makes one and passes it to every event,
+    // so the buffers keep their capacity from one event to the next and ProcessEvent stays const.
+    struct Workspace
+    {
+      AuxEvent::HitPool hitPool; // Hit indices referenced by the candidates
+      AuxVertex::CandidateBatch candidates; // Columns only reallocated when an event has more candidates than any before
+      FindPandoraVertex::FindPandoraVertexAlg::Workspace vertexWorkspace;
+      CalorimetryRadius::CalorimetryRadiusAlg::Workspace caloWorkspace;
+      ExtractTruthInformation::ExtractTruthInformationAlg::Workspace truthWorkspace;
+      AuxEvent::EventRecord record; // Tree rows of the event, handed to the output at the end
+    };
+    std::unique_ptr<Workspace> MakeWorkspace() const;
+
+    // Run the algorithms on an event, everything it produces goes to the workspace (workspace.record holds the rows)
+    void ProcessEvent(const AuxEvent::EventSource & evt, Workspace & workspace) const;
+
+  private:
+    // Algorithms
+    FindPandoraVertex::FindPandoraVertexAlg fFindPandoraVertexAlg;
+    CalorimetryRadius::CalorimetryRadiusAlg fCalorimetryRadiusAlg;
+    ExtractTruthInformation::ExtractTruthInformationAlg fExtractTruthInformationAlg;
+
+    // fhicl parameters
+    std::vector<double> fCenterCoordinates;
+    bool fSaveDrawTree;
+    bool fSaveTruthDrawTree;
+    bool fUseTruthDistanceMetric;
+    double fRangeTableMaxRange;
+    double fRangeTableStep;
+    bool fValidateRangeTable;
+    double fRangeTableTolerance;
+    bool fStageTimers;
+
+    // Range to momentum tables, built once per job
+    AuxVertex::RangeMomentumTable fRangeTable;
+    AuxEvent::ProjectionCache fProjectionCache;
+    const HsnLog::Logger* fLog;
+  };
+
+} // END namespace HsnFinderEvent
+
+#endif
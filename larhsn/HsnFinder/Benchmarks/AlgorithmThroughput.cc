@@ -0,0 +1,362 @@
+/******************************************************************************
+ * @file AlgorithmThroughput.cc
+ * @brief Throughput and allocations of the HsnFinder algorithm stages on synthetic events, without an art job
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  FindPandoraVertexAlg.h CalorimetryRadiusAlg.h
+ *
+ * Usage: AlgorithmThroughput [nEvents] [results.json] [nNeutrinos hitsPerPlane hitsPerTrack]
+ * Events are made in memory: a PFParticle hierarchy where half of the neutrinos have exactly two track daughters
+ * (the others three tracks and a shower), with their vertices, tracks, MCS results and hits, plus uniform background hits.
+ * The stages run as in GetPotentialNeutrinoVertices and PerformCalorimetry, except the art association lookups,
+ * which are replaced by reading the fixture tables (so "associations" only measures the candidate tables and the hit pool).
+ * Without multiplicities a default sweep is run. With a results file, every fixture is also written there as JSON,
+ * to be compared between builds. All the vertices are generated inside the TPC, so every two-track neutrino must give a candidate:
+ * the exit status is 1 if a fixture does not find exactly that number of candidates or the results file cannot be written,
+ * so the small fixture run by ctest (AlgorithmThroughput_test) also catches broken stages.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// HSN finder includes
+#include "larhsn/HsnFinder/Algorithms/FindPandoraVertexAlg.h"
+#include "larhsn/HsnFinder/Algorithms/CalorimetryRadiusAlg.h"
+#include "larhsn/HsnFinder/DataObjects/RangeMomentumTable.h"
+
+// Global allocation counter
+static std::atomic<size_t> gNumAllocations(0);
+void* operator new(size_t size)
+{
+  gNumAllocations++;
+  if (void* p = malloc(size)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {free(p);}
+void operator delete(void* p, size_t) noexcept {free(p);}
+
+namespace
+{
+  // Number of different events generated for each fixture, the benchmark cycles through them
+  constexpr size_t kNumDistinctEvents = 8;
+  constexpr size_t kPointsPerTrack = 20;
+
+  // Stages of the benchmark, in the order they run
+  enum Stage {kPfpScan, kAssociations, kVertices, kCalorimetry, kNumStages};
+  const char* const kStageNames[kNumStages] = {"pfpScan", "associations", "vertices", "calorimetry"};
+
+  struct Multiplicities
+  {
+    size_t nNeutrinos;
+    size_t hitsPerPlane; // Background hits in each plane
+    size_t hitsPerTrack;
+  };
+
+  // MicroBooNE-like TPC and readout (see hsnFinder_mc.fcl)
+  const std::vector<double> kMinTpcBound = {10., -105.53, 10.1};
+  const std::vector<double> kMaxTpcBound = {246.35, 107.47, 1026.9};
+  const int kFirstChannel[4] = {0, 2400, 4800, 8256}; // First channel of each plane, and end of the last one
+
+  void BuildProjection(AuxEvent::ProjectionCache & projection)
+  {
+    // Nominal MicroBooNE readout (in the art job it comes from the services): U and V wires at +-60 degrees from the vertical,
+    // Y wires vertical from z = 0.25 cm, 0.3 cm pitch. 0.5 us ticks at 0.1114 cm/us, x = 0 at tick 800 (TriggerOffsetTPC -400 us).
+    const float ticksPerCm = 17.9475398;
+    std::array<AuxEvent::ProjectionCache::PlaneGeometry,3> planes = {{
+      {0.3, (float) (M_PI/6.), 335., kFirstChannel[0], 2400, ticksPerCm, 800.},
+      {0.3, (float) (5.*M_PI/6.), 335., kFirstChannel[1], 2400, ticksPerCm, 800.},
+      {0.3, (float) (M_PI/2.), (float) (-0.25/0.3), kFirstChannel[2], 3456, ticksPerCm, 800.}
+    }};
+    projection.Build(planes);
+    return;
+  }
+
+  // All the reconstructed objects of an event, and the associations art would return for them (indexed by pfp)
+  struct Fixture
+  {
+    std::vector<recob::PFParticle> pfps;
+    std::vector<recob::Vertex> vertices;
+    std::vector<recob::Track> tracks;
+    std::vector<recob::MCSFitResult> mcs; // Paired to tracks by index
+    std::vector<recob::Hit> hits;
+    std::vector<int> pfpVertex; // Index in vertices, -1 if none
+    std::vector<int> pfpTrack; // Index in tracks, -1 if none
+    std::vector<std::vector<uint32_t>> trackHits; // Keys in hits
+  };
+
+  recob::Hit MakeHit(int channel, float tick, float integral, int plane)
+  {
+    return recob::Hit(channel, (int) tick - 5, (int) tick + 5, tick, 1., 3., integral/10., 1., integral, integral, 1., 1, 0, 1., 1,
+      (geo::View_t) plane, (plane == 2) ? geo::kCollection : geo::kInduction, geo::WireID(0, 0, plane, 0));
+  }
+
+  void AddTrack(Fixture & fixture, size_t pfpIndex, const double* start, std::mt19937 & engine, const Multiplicities & multiplicities, const AuxEvent::ProjectionCache & projection)
+  {
+    std::uniform_real_distribution<double> length(5., 100.), cosTheta(-1., 1.), phi(-M_PI, M_PI), integral(50., 500.);
+    const double l = length(engine), ct = cosTheta(engine), st = sqrt(1. - ct*ct), p = phi(engine);
+    const double direction[3] = {st*cos(p), st*sin(p), ct};
+
+    recob::Track::Positions_t positions;
+    recob::Track::Momenta_t momenta;
+    for (size_t i=0; i!=kPointsPerTrack; i++)
+    {
+      const double s = l*i/(kPointsPerTrack-1);
+      positions.emplace_back(start[0] + s*direction[0], start[1] + s*direction[1], start[2] + s*direction[2]);
+      momenta.emplace_back(direction[0], direction[1], direction[2]);
+    }
+    const int t = fixture.tracks.size();
+    fixture.tracks.emplace_back(std::move(positions), std::move(momenta), recob::Track::Flags_t(kPointsPerTrack), true, 13, 1., (int) kPointsPerTrack,
+      recob::tracking::SMatrixSym55(), recob::tracking::SMatrixSym55(), t);
+    fixture.mcs.emplace_back(13, 0.5, 0.1, -10., 0.5, 0.1, -10., std::vector<float>(), std::vector<float>());
+    double vertexPosition[3] = {start[0], start[1], start[2]};
+    fixture.pfpVertex[pfpIndex] = fixture.vertices.size();
+    fixture.vertices.emplace_back(vertexPosition, (int) fixture.vertices.size());
+    fixture.pfpTrack[pfpIndex] = t;
+
+    // Hits along the track, split among the planes
+    std::vector<uint32_t> keys;
+    for (size_t i=0; i!=multiplicities.hitsPerTrack; i++)
+    {
+      const double s = l*i/multiplicities.hitsPerTrack;
+      const float xyz[3] = {(float) (start[0] + s*direction[0]), (float) (start[1] + s*direction[1]), (float) (start[2] + s*direction[2])};
+      std::array<int,3> channels;
+      std::array<float,3> ticks;
+      projection.ProjectPoint(xyz, channels, ticks);
+      const int plane = i%3;
+      keys.push_back(fixture.hits.size());
+      fixture.hits.push_back(MakeHit(channels[plane], ticks[plane], integral(engine), plane));
+    }
+    fixture.trackHits.push_back(keys);
+    return;
+  }
+
+  Fixture MakeFixture(size_t seed, const Multiplicities & multiplicities, const AuxEvent::ProjectionCache & projection)
+  {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> x(kMinTpcBound[0]+10., kMaxTpcBound[0]-10.), y(kMinTpcBound[1]+10., kMaxTpcBound[1]-10.), z(kMinTpcBound[2]+10., kMaxTpcBound[2]-10.);
+    std::uniform_real_distribution<float> tick(0., 6400.), integral(50., 500.);
+    Fixture fixture;
+
+    // Hierarchy: neutrino, then its daughters. Even neutrinos have two tracks, odd ones three tracks and a shower.
+    for (size_t n=0; n!=multiplicities.nNeutrinos; n++)
+    {
+      const size_t nuIndex = fixture.pfps.size();
+      const size_t nTracks = (n%2 == 0) ? 2 : 3;
+      const size_t nDaughters = (n%2 == 0) ? 2 : 4;
+      std::vector<size_t> daughters;
+      for (size_t d=0; d!=nDaughters; d++) daughters.push_back(nuIndex+1+d);
+      fixture.pfps.emplace_back(14, nuIndex, recob::PFParticle::kPFParticlePrimary, daughters);
+      for (size_t d=0; d!=nDaughters; d++) fixture.pfps.emplace_back((d < nTracks) ? 13 : 11, nuIndex+1+d, nuIndex, std::vector<size_t>());
+      fixture.pfpVertex.resize(fixture.pfps.size(), -1);
+      fixture.pfpTrack.resize(fixture.pfps.size(), -1);
+
+      double vertex[3] = {x(engine), y(engine), z(engine)};
+      fixture.pfpVertex[nuIndex] = fixture.vertices.size();
+      fixture.vertices.emplace_back(vertex, (int) fixture.vertices.size());
+      for (size_t d=0; d!=nTracks; d++) AddTrack(fixture, nuIndex+1+d, vertex, engine, multiplicities, projection);
+    }
+
+    // Background hits, uniform over the readout
+    for (int plane=0; plane!=3; plane++)
+    {
+      std::uniform_int_distribution<int> channel(kFirstChannel[plane], kFirstChannel[plane+1]-1);
+      for (size_t i=0; i!=multiplicities.hitsPerPlane; i++) fixture.hits.push_back(MakeHit(channel(engine), tick(engine), integral(engine), plane));
+    }
+    return fixture;
+  }
+
+  // What ResolveCandidateAssociations gets from art, read from the fixture tables instead
+  void ResolveFromFixture(const Fixture & fixture, art::ProductID id, AuxEvent::HitPool & hitPool, FindPandoraVertex::FindPandoraVertexAlg::Workspace & workspace)
+  {
+    AuxEvent::CandidateAssociations & associations = workspace.candidateAssociations;
+    const size_t nCandidates = associations.NumCandidates();
+    const std::vector<art::Ptr<recob::PFParticle>> vertexQuery = associations.GetVertexQuery();
+    auto vertexOf = [&](size_t q) {const size_t v = fixture.pfpVertex[vertexQuery[q].key()]; return art::Ptr<recob::Vertex>(id, &fixture.vertices[v], v);};
+    for (size_t c=0; c!=nCandidates; c++)
+    {
+      associations.SetNuVertex(c, vertexOf(c));
+      associations.SetProngVertex(c, 0, vertexOf(nCandidates+2*c));
+      associations.SetProngVertex(c, 1, vertexOf(nCandidates+2*c+1));
+    }
+    const std::vector<art::Ptr<recob::PFParticle>> trackQuery = associations.GetTrackQuery();
+    for (size_t c=0; c!=nCandidates; c++)
+    {
+      for (int prong=0; prong!=2; prong++)
+      {
+        const size_t t = fixture.pfpTrack[trackQuery[2*c+prong].key()];
+        associations.SetProngTrack(c, prong, art::Ptr<recob::Track>(id, &fixture.tracks[t], t));
+        associations.SetProngMcs(c, prong, art::Ptr<recob::MCSFitResult>(id, &fixture.mcs[t], t));
+        associations.SetProngHits(c, prong, hitPool.AddKeys(id, &fixture.hits, fixture.trackHits[t]));
+      }
+    }
+    return;
+  }
+
+  struct Result
+  {
+    Multiplicities multiplicities;
+    size_t nEvents = 0;
+    size_t nCandidates = 0; // Built (contained) candidates over all events
+    double totalTime = 0.; // [s]
+    std::array<double,kNumStages> stageTime; // [s]
+    std::array<size_t,kNumStages> stageAllocations;
+    double checksum = 0.;
+  };
+
+  Result Run(size_t nEvents, const Multiplicities & multiplicities, const AuxEvent::ProjectionCache & projection, const AuxVertex::RangeMomentumTable & rangeTable,
+    const FindPandoraVertex::FindPandoraVertexAlg & vertexAlg, const CalorimetryRadius::CalorimetryRadiusAlg & caloAlg)
+  {
+    std::vector<Fixture> fixtures;
+    for (size_t f=0; f!=kNumDistinctEvents; f++) fixtures.push_back(MakeFixture(1000*f + 17, multiplicities, projection));
+    const art::ProductID id = art::ProductID();
+
+    // Per-event state, reused as in HsnFinder
+    FindPandoraVertex::FindPandoraVertexAlg::Workspace vertexWorkspace;
+    CalorimetryRadius::CalorimetryRadiusAlg::Workspace caloWorkspace;
+    AuxEvent::EventTreeFiller etf;
+    AuxEvent::HitPool hitPool;
+    AuxVertex::CandidateBatch candidates;
+    candidates.SetRangeTable(&rangeTable);
+
+    Result result;
+    result.multiplicities = multiplicities;
+    result.stageTime.fill(0.);
+    result.stageAllocations.fill(0);
+    // The first pass over the distinct events grows the workspaces, the measured events start after it
+    for (size_t e=0; e!=nEvents+kNumDistinctEvents; e++)
+    {
+      const bool measured = (e >= kNumDistinctEvents);
+      const Fixture & fixture = fixtures[e%kNumDistinctEvents];
+      std::array<std::chrono::steady_clock::time_point,kNumStages+1> times;
+      std::array<size_t,kNumStages+1> allocations;
+
+      times[kPfpScan] = std::chrono::steady_clock::now();
+      allocations[kPfpScan] = gNumAllocations;
+      hitPool.Clear();
+      vertexAlg.FindTwoProngedNeutrinos(fixture.pfps, [&fixture, &id](size_t i) {return art::Ptr<recob::PFParticle>(id, &fixture.pfps[i], i);}, etf, vertexWorkspace);
+
+      times[kAssociations] = std::chrono::steady_clock::now();
+      allocations[kAssociations] = gNumAllocations;
+      ResolveFromFixture(fixture, id, hitPool, vertexWorkspace);
+
+      times[kVertices] = std::chrono::steady_clock::now();
+      allocations[kVertices] = gNumAllocations;
+      vertexAlg.BuildDecayVertices(etf, hitPool, candidates, vertexWorkspace);
+
+      times[kCalorimetry] = std::chrono::steady_clock::now();
+      allocations[kCalorimetry] = gNumAllocations;
+      caloAlg.PerformCalorimetry(fixture.hits, id, etf, hitPool, candidates, caloWorkspace);
+
+      times[kNumStages] = std::chrono::steady_clock::now();
+      allocations[kNumStages] = gNumAllocations;
+      if (!measured) continue;
+
+      result.nEvents++;
+      result.nCandidates += candidates.Size();
+      for (int s=0; s!=kNumStages; s++)
+      {
+        result.stageTime[s] += std::chrono::duration<double>(times[s+1] - times[s]).count();
+        result.stageAllocations[s] += allocations[s+1] - allocations[s];
+      }
+      result.totalTime += std::chrono::duration<double>(times[kNumStages] - times[kPfpScan]).count();
+      for (const std::vector<float> & profile : caloWorkspace.tree_calo_totChargeInRadius) result.checksum += profile.back();
+    }
+    return result;
+  }
+
+  void Print(const Result & result)
+  {
+    const Multiplicities & m = result.multiplicities;
+    printf("%zu neutrinos, %zu hits per plane, %zu hits per track: %.1f events/s, %.2f candidates per event\n",
+      m.nNeutrinos, m.hitsPerPlane, m.hitsPerTrack, result.nEvents/result.totalTime, (double) result.nCandidates/result.nEvents);
+    for (int s=0; s!=kNumStages; s++)
+    {
+      printf("|_%-13s %12.1f ns/event %12.1f ns/candidate %10.2f allocations/event\n", kStageNames[s],
+        1e9*result.stageTime[s]/result.nEvents, result.nCandidates ? 1e9*result.stageTime[s]/result.nCandidates : 0., (double) result.stageAllocations[s]/result.nEvents);
+    }
+    printf("|_Checksum: %.1f\n", result.checksum);
+    return;
+  }
+
+  bool WriteJson(const char* path, const std::vector<Result> & results)
+  {
+    FILE* file = fopen(path, "w");
+    if (!file)
+    {
+      printf("Could not open %s for writing.\n", path);
+      return false;
+    }
+    fprintf(file, "{\n  \"benchmark\": \"AlgorithmThroughput\",\n  \"fixtures\": [\n");
+    for (size_t r=0; r!=results.size(); r++)
+    {
+      const Result & result = results[r];
+      const Multiplicities & m = result.multiplicities;
+      fprintf(file, "    {\"nNeutrinos\": %zu, \"hitsPerPlane\": %zu, \"hitsPerTrack\": %zu, \"events\": %zu, \"candidatesPerEvent\": %.3f, \"eventsPerSecond\": %.2f, \"checksum\": %.1f,\n",
+        m.nNeutrinos, m.hitsPerPlane, m.hitsPerTrack, result.nEvents, (double) result.nCandidates/result.nEvents, result.nEvents/result.totalTime, result.checksum);
+      fprintf(file, "     \"stages\": {");
+      for (int s=0; s!=kNumStages; s++)
+      {
+        fprintf(file, "%s\"%s\": {\"nsPerEvent\": %.1f, \"nsPerCandidate\": %.1f, \"allocationsPerEvent\": %.2f}", (s == 0) ? "" : ", ", kStageNames[s],
+          1e9*result.stageTime[s]/result.nEvents, result.nCandidates ? 1e9*result.stageTime[s]/result.nCandidates : 0., (double) result.stageAllocations[s]/result.nEvents);
+      }
+      fprintf(file, "}}%s\n", (r+1 == results.size()) ? "" : ",");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+  }
+} // END anonymous namespace
+
+int main(int argc, char** argv)
+{
+  const size_t nEvents = (argc > 1) ? atoi(argv[1]) : 200;
+  const char* jsonPath = (argc > 2) ? argv[2] : nullptr;
+  std::vector<Multiplicities> sweep;
+  if (argc > 5) sweep.push_back({(size_t) atoi(argv[3]), (size_t) atoi(argv[4]), (size_t) atoi(argv[5])});
+  else sweep = {{2, 10000, 100}, {4, 10000, 300}, {4, 30000, 300}, {16, 30000, 300}, {16, 100000, 1000}};
+
+  // Labels, TPC bounds and profile as in hsnFinder_mc.fcl (the labels only name the fixture products)
+  fhicl::ParameterSet pset;
+  pset.put<std::string>("PfpLabel", "pandoraNu");
+  pset.put<std::string>("McsLabel", "pandoraNuMCSMu");
+  pset.put<std::string>("HitLabel", "gaushit");
+  pset.put<std::vector<double>>("MinTpcBound", kMinTpcBound);
+  pset.put<std::vector<double>>("MaxTpcBound", kMaxTpcBound);
+  pset.put<std::vector<double>>("RadiusProfileLimits", {0., 20.});
+  pset.put<int>("RadiusProfileBins", 20);
+  pset.put<double>("ChannelNorm", 3.3);
+  pset.put<double>("TickNorm", 17.9);
+
+  AuxEvent::ProjectionCache projection;
+  BuildProjection(projection);
+  AuxVertex::RangeMomentumTable rangeTable;
+  rangeTable.Build(1000., 0.5, 1.38065); // Argon density at 89 K [g/cm3]
+  FindPandoraVertex::FindPandoraVertexAlg vertexAlg(pset);
+  vertexAlg.SetProjectionCache(&projection);
+  CalorimetryRadius::CalorimetryRadiusAlg caloAlg(pset);
+
+  printf("%zu events per fixture (%zu distinct events, cycled).\n", nEvents, kNumDistinctEvents);
+  std::vector<Result> results;
+  int status = 0;
+  for (const Multiplicities & multiplicities : sweep)
+  {
+    results.push_back(Run(nEvents, multiplicities, projection, rangeTable, vertexAlg, caloAlg));
+    Print(results.back());
+    // The even neutrinos of every fixture are contained two-track candidates, any other count means the stages are broken
+    const size_t expected = results.back().nEvents*((multiplicities.nNeutrinos + 1)/2);
+    if (results.back().nCandidates != expected)
+    {
+      printf("Found %zu candidates with %zu neutrinos per event, expected %zu.\n", results.back().nCandidates, multiplicities.nNeutrinos, expected);
+      status = 1;
+    }
+  }
+  if (jsonPath && !WriteJson(jsonPath, results)) status = 1;
+  return status;
+} // END function main
@@ -0,0 +1,433 @@
+/******************************************************************************
+ * @file CandidateBatchAllocations.cc
+ * @brief Count heap allocations per candidate for the old DecayVertex layout and the CandidateBatch layout
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateBatch.h
+ *
+ * Usage: CandidateBatchAllocations [nEvents] [nCandidatesPerEvent] [nHitsPerProng]
+ * The old layout is a copy of AuxVertex::DecayVertex as it was before CandidateBatch (same members, same constructor and setters),
+ * kept here since the class is gone from the library. Only the reads of the art objects are replaced by fixture values,
+ * and trkf::TrackMomentumCalculator by a stand-in that does not allocate, so the old layout is counted without the calculator
+ * it used to build for every candidate.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <vector>
+
+// HSN finder includes
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
+
+// Global allocation counter
+static std::atomic<size_t> gNumAllocations(0);
+void* operator new(size_t size)
+{
+  gNumAllocations++;
+  if (void* p = malloc(size)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept {free(p);}
+void operator delete(void* p, size_t) noexcept {free(p);}
+
+namespace
+{
+  // What the old constructor read from the recob::Vertex, recob::Track and recob::MCSFitResult of a prong
+  struct ProngFixture
+  {
+    float vertex[3];
+    float start[3], end[3];
+    float length, theta, phi;
+    float momentumDirection[3];
+    double startDirection[3];
+    int mcsPdgCode;
+    bool mcsIsBestFwd;
+    float mcsFwdMomentum, mcsBestMomentum;
+  };
+
+  // Stand-in for TrackMomentumCalculator::GetTrackMomentum(length, 13), muon CSDA range to momentum [GeV]
+  double RangeMomentum(double length) {return 0.0143*pow(length, 0.79) + 0.0434;}
+
+  // Copy of the baseline AuxVertex::DecayVertex (DecayVertex.h and DecayVertex.cxx), data members and calculations unchanged
+  class BaselineDecayVertex
+  {
+  public:
+    BaselineDecayVertex(
+            const float nuVertex[3],
+            const ProngFixture &t1,
+            const ProngFixture &t2,
+            const std::vector<art::Ptr<recob::Hit>> &t1Hits,
+            const std::vector<art::Ptr<recob::Hit>> &t2Hits)
+    {
+      // Set default mock attributes for the Decay Vertex candidate
+      fChannelLoc = {-1,-1,-1};
+      fTickLoc = {-1.,-1.,-1.};
+      fProngChannelLoc = {{-1,-1,-1}, {-1,-1,-1}};
+      fProngTickLoc = {{-1.,-1.,-1.}, {-1.,-1.,-1.}};
+      fIsDetLocAssigned = false;
+      fIsInsideTPC = false;
+
+      // Store pointers to reconstructed objects provided as input in internal attributes
+      fNuVertex = art::Ptr<recob::Vertex>();
+      fProngVertex = {art::Ptr<recob::Vertex>(), art::Ptr<recob::Vertex>()};
+      fProngTrack = {art::Ptr<recob::Track>(), art::Ptr<recob::Track>()};
+      fProngHits = {t1Hits, t2Hits};
+      fProngMcs = {art::Ptr<recob::MCSFitResult>(), art::Ptr<recob::MCSFitResult>()};
+      fProng = {t1, t2};
+
+      fX = nuVertex[0];
+      fY = nuVertex[1];
+      fZ = nuVertex[2];
+      fProngX = {t1.vertex[0], t2.vertex[0]};
+      fProngY = {t1.vertex[1], t2.vertex[1]};
+      fProngZ = {t1.vertex[2], t2.vertex[2]};
+      // Do the same for tracks.
+      fProngStartX = {t1.start[0], t2.start[0]};
+      fProngStartY = {t1.start[1], t2.start[1]};
+      fProngStartZ = {t1.start[2], t2.start[2]};
+      fProngEndX = {t1.end[0], t2.end[0]};
+      fProngEndY = {t1.end[1], t2.end[1]};
+      fProngEndZ = {t1.end[2], t2.end[2]};
+
+      // Calculate length, theta, phi and number of hits
+      fProngLength = {t1.length, t2.length};
+      fProngTheta = {t1.theta, t2.theta};
+      fProngPhi = {t1.phi, t2.phi};
+      fProngNumHits = {(int) t1Hits.size(), (int) t2Hits.size()};
+
+      // Calculate track directions
+      fProngDirX = {t1.momentumDirection[0], t2.momentumDirection[0]};
+      fProngDirY = {t1.momentumDirection[1], t2.momentumDirection[1]};
+      fProngDirZ = {t1.momentumDirection[2], t2.momentumDirection[2]};
+
+      // Calculate momenta and quantities related to them, using range and MCS method
+      SetHypothesisLabels();
+      SetMomentumQuantities_ByRange();
+      SetMomentumQuantities_ByMCS();
+    }
+
+    void SetTotHits(std::vector<art::Ptr<recob::Hit>> totHitsInMaxRadius) {fTotHitsInMaxRadius = totHitsInMaxRadius; return;}
+
+    void SetHypothesisLabels()
+    {
+      float muonMass = 0.10566;
+      float pionMass = 0.13957;
+      int longTrackInd = (fProngLength[0]>=fProngLength[1]) ? 0 : 1;
+      int shortTrackInd = 1 - longTrackInd;
+      fProngPdgCode_h1 = {-1,-1};
+      fProngPdgCode_h2 = {-1,-1};
+      fProngMass_h1 = {-1.,-1.};
+      fProngMass_h2 = {-1.,-1.};
+      fProngPdgCode_h1[longTrackInd] = 13;
+      fProngPdgCode_h1[shortTrackInd] = 211;
+      fProngPdgCode_h2[longTrackInd] = 211;
+      fProngPdgCode_h2[shortTrackInd] = 13;
+      fProngMass_h1[longTrackInd] = muonMass;
+      fProngMass_h1[shortTrackInd] = pionMass;
+      fProngMass_h2[longTrackInd] = pionMass;
+      fProngMass_h2[shortTrackInd] = muonMass;
+    }
+
+    void SetMomentumQuantities_ByRange()
+    {
+      fProngMomMag_ByRange_h1 = {(float) RangeMomentum(fProngLength[0]), (float) RangeMomentum(fProngLength[1])};
+      fProngMomMag_ByRange_h2 = {(float) RangeMomentum(fProngLength[0]), (float) RangeMomentum(fProngLength[1])};
+      float e1, e2, muonMass = 0.10566;
+      for(int i=0; i<2; i++)
+      {
+        fProngMomMag_ByRange_h1[i] = fProngMomMag_ByRange_h1[i]*fProngMass_h1[i]/muonMass;
+        fProngMomMag_ByRange_h2[i] = fProngMomMag_ByRange_h2[i]*fProngMass_h2[i]/muonMass;
+      }
+      fProngMom_ByRange_h1_X = {fProngDirX[0]*fProngMomMag_ByRange_h1[0], fProngDirX[1]*fProngMomMag_ByRange_h1[1]};
+      fProngMom_ByRange_h1_Y = {fProngDirY[0]*fProngMomMag_ByRange_h1[0], fProngDirY[1]*fProngMomMag_ByRange_h1[1]};
+      fProngMom_ByRange_h1_Z = {fProngDirZ[0]*fProngMomMag_ByRange_h1[0], fProngDirZ[1]*fProngMomMag_ByRange_h1[1]};
+      fProngMom_ByRange_h2_X = {fProngDirX[0]*fProngMomMag_ByRange_h2[0], fProngDirX[1]*fProngMomMag_ByRange_h2[1]};
+      fProngMom_ByRange_h2_Y = {fProngDirY[0]*fProngMomMag_ByRange_h2[0], fProngDirY[1]*fProngMomMag_ByRange_h2[1]};
+      fProngMom_ByRange_h2_Z = {fProngDirZ[0]*fProngMomMag_ByRange_h2[0], fProngDirZ[1]*fProngMomMag_ByRange_h2[1]};
+      e1 = sqrt(pow(fProngMass_h1[0],2.) + pow(fProngMomMag_ByRange_h1[0],2.));
+      e2 = sqrt(pow(fProngMass_h1[1],2.) + pow(fProngMomMag_ByRange_h1[1],2.));
+      fProngEnergy_ByRange_h1 = {e1, e2};
+      e1 = sqrt(pow(fProngMass_h2[0],2.) + pow(fProngMomMag_ByRange_h2[0],2.));
+      e2 = sqrt(pow(fProngMass_h2[1],2.) + pow(fProngMomMag_ByRange_h2[1],2.));
+      fProngEnergy_ByRange_h2 = {e1, e2};
+      fTotMom_ByRange_h1_X = fProngMom_ByRange_h1_X[0] + fProngMom_ByRange_h1_X[1];
+      fTotMom_ByRange_h1_Y = fProngMom_ByRange_h1_Y[0] + fProngMom_ByRange_h1_Y[1];
+      fTotMom_ByRange_h1_Z = fProngMom_ByRange_h1_Z[0] + fProngMom_ByRange_h1_Z[1];
+      fTotMom_ByRange_h2_X = fProngMom_ByRange_h2_X[0] + fProngMom_ByRange_h2_X[1];
+      fTotMom_ByRange_h2_Y = fProngMom_ByRange_h2_Y[0] + fProngMom_ByRange_h2_Y[1];
+      fTotMom_ByRange_h2_Z = fProngMom_ByRange_h2_Z[0] + fProngMom_ByRange_h2_Z[1];
+      fTotMomMag_ByRange_h1 = sqrt(pow(fTotMom_ByRange_h1_X,2.) + pow(fTotMom_ByRange_h1_Y,2.) + pow(fTotMom_ByRange_h1_Z,2.));
+      fTotMomMag_ByRange_h2 = sqrt(pow(fTotMom_ByRange_h2_X,2.) + pow(fTotMom_ByRange_h2_Y,2.) + pow(fTotMom_ByRange_h2_Z,2.));
+      fTotDir_ByRange_h1_X = fTotMom_ByRange_h1_X/fTotMomMag_ByRange_h1;
+      fTotDir_ByRange_h1_Y = fTotMom_ByRange_h1_Y/fTotMomMag_ByRange_h1;
+      fTotDir_ByRange_h1_Z = fTotMom_ByRange_h1_Z/fTotMomMag_ByRange_h1;
+      fTotDir_ByRange_h2_X = fTotMom_ByRange_h2_X/fTotMomMag_ByRange_h2;
+      fTotDir_ByRange_h2_Y = fTotMom_ByRange_h2_Y/fTotMomMag_ByRange_h2;
+      fTotDir_ByRange_h2_Z = fTotMom_ByRange_h2_Z/fTotMomMag_ByRange_h2;
+      fTotTheta_ByRange_h1 = acos(fTotDir_ByRange_h1_Z);
+      fTotPhi_ByRange_h1 = atan2(fTotDir_ByRange_h1_Y,fTotDir_ByRange_h1_X);
+      fTotTheta_ByRange_h2 = acos(fTotDir_ByRange_h2_Z);
+      fTotPhi_ByRange_h2 = atan2(fTotDir_ByRange_h2_Y,fTotDir_ByRange_h2_X);
+      fTotEnergy_ByRange_h1 = fProngEnergy_ByRange_h1[0] + fProngEnergy_ByRange_h1[1];
+      fTotEnergy_ByRange_h2 = fProngEnergy_ByRange_h2[0] + fProngEnergy_ByRange_h2[1];
+      fInvMass_ByRange_h1 = sqrt(pow(fTotEnergy_ByRange_h1,2.) - pow(fTotMomMag_ByRange_h1,2.));
+      fInvMass_ByRange_h2 = sqrt(pow(fTotEnergy_ByRange_h2,2.) - pow(fTotMomMag_ByRange_h2,2.));
+      SetOpeningAngleAndDistances();
+    }
+
+    void SetMomentumQuantities_ByMCS()
+    {
+      float e1, e2;
+      fProngPdgCodeHypothesis_ByMcs = {fProng[0].mcsPdgCode, fProng[1].mcsPdgCode};
+      fProngIsBestFwd_ByMcs = {fProng[0].mcsIsBestFwd, fProng[1].mcsIsBestFwd};
+      fProngMomMag_ByMcs_fwd_h1 = {fProng[0].mcsFwdMomentum, fProng[1].mcsFwdMomentum};
+      fProngMomMag_ByMcs_best_h1 = {fProng[0].mcsBestMomentum, fProng[1].mcsBestMomentum};
+      fProngMomMag_ByMcs_fwd_h2 = {fProng[0].mcsFwdMomentum, fProng[1].mcsFwdMomentum};
+      fProngMomMag_ByMcs_best_h2 = {fProng[0].mcsBestMomentum, fProng[1].mcsBestMomentum};
+      fProngMom_ByMcs_fwd_h1_X = {fProngDirX[0]*fProngMomMag_ByMcs_fwd_h1[0],fProngDirX[1]*fProngMomMag_ByMcs_fwd_h1[1]};
+      fProngMom_ByMcs_fwd_h1_Y = {fProngDirY[0]*fProngMomMag_ByMcs_fwd_h1[0],fProngDirY[1]*fProngMomMag_ByMcs_fwd_h1[1]};
+      fProngMom_ByMcs_fwd_h1_Z = {fProngDirZ[0]*fProngMomMag_ByMcs_fwd_h1[0],fProngDirZ[1]*fProngMomMag_ByMcs_fwd_h1[1]};
+      fProngMom_ByMcs_best_h1_X = {fProngDirX[0]*fProngMomMag_ByMcs_best_h1[0],fProngDirX[1]*fProngMomMag_ByMcs_best_h1[1]};
+      fProngMom_ByMcs_best_h1_Y = {fProngDirY[0]*fProngMomMag_ByMcs_best_h1[0],fProngDirY[1]*fProngMomMag_ByMcs_best_h1[1]};
+      fProngMom_ByMcs_best_h1_Z = {fProngDirZ[0]*fProngMomMag_ByMcs_best_h1[0],fProngDirZ[1]*fProngMomMag_ByMcs_best_h1[1]};
+      fProngMom_ByMcs_fwd_h2_X = {fProngDirX[0]*fProngMomMag_ByMcs_fwd_h2[0],fProngDirX[1]*fProngMomMag_ByMcs_fwd_h2[1]};
+      fProngMom_ByMcs_fwd_h2_Y = {fProngDirY[0]*fProngMomMag_ByMcs_fwd_h2[0],fProngDirY[1]*fProngMomMag_ByMcs_fwd_h2[1]};
+      fProngMom_ByMcs_fwd_h2_Z = {fProngDirZ[0]*fProngMomMag_ByMcs_fwd_h2[0],fProngDirZ[1]*fProngMomMag_ByMcs_fwd_h2[1]};
+      fProngMom_ByMcs_best_h2_X = {fProngDirX[0]*fProngMomMag_ByMcs_best_h2[0],fProngDirX[1]*fProngMomMag_ByMcs_best_h2[1]};
+      fProngMom_ByMcs_best_h2_Y = {fProngDirY[0]*fProngMomMag_ByMcs_best_h2[0],fProngDirY[1]*fProngMomMag_ByMcs_best_h2[1]};
+      fProngMom_ByMcs_best_h2_Z = {fProngDirZ[0]*fProngMomMag_ByMcs_best_h2[0],fProngDirZ[1]*fProngMomMag_ByMcs_best_h2[1]};
+      e1 = sqrt(pow(fProngMass_h1[0],2.) + pow(fProngMomMag_ByMcs_fwd_h1[0],2.));
+      e2 = sqrt(pow(fProngMass_h1[1],2.) + pow(fProngMomMag_ByMcs_fwd_h1[1],2.));
+      fProngEnergy_ByMcs_fwd_h1 = {e1, e2};
+      e1 = sqrt(pow(fProngMass_h1[0],2.) + pow(fProngMomMag_ByMcs_best_h1[0],2.));
+      e2 = sqrt(pow(fProngMass_h1[1],2.) + pow(fProngMomMag_ByMcs_best_h1[1],2.));
+      fProngEnergy_ByMcs_best_h1 = {e1, e2};
+      e1 = sqrt(pow(fProngMass_h2[0],2.) + pow(fProngMomMag_ByMcs_fwd_h2[0],2.));
+      e2 = sqrt(pow(fProngMass_h2[1],2.) + pow(fProngMomMag_ByMcs_fwd_h2[1],2.));
+      fProngEnergy_ByMcs_fwd_h2 = {e1, e2};
+      e1 = sqrt(pow(fProngMass_h2[0],2.) + pow(fProngMomMag_ByMcs_best_h2[0],2.));
+      e2 = sqrt(pow(fProngMass_h2[1],2.) + pow(fProngMomMag_ByMcs_best_h2[1],2.));
+      fProngEnergy_ByMcs_best_h2 = {e1, e2};
+      fTotMom_ByMcs_fwd_h1_X = fProngMom_ByMcs_fwd_h1_X[0] + fProngMom_ByMcs_fwd_h1_X[1];
+      fTotMom_ByMcs_fwd_h1_Y = fProngMom_ByMcs_fwd_h1_Y[0] + fProngMom_ByMcs_fwd_h1_Y[1];
+      fTotMom_ByMcs_fwd_h1_Z = fProngMom_ByMcs_fwd_h1_Z[0] + fProngMom_ByMcs_fwd_h1_Z[1];
+      fTotMom_ByMcs_best_h1_X = fProngMom_ByMcs_best_h1_X[0] + fProngMom_ByMcs_best_h1_X[1];
+      fTotMom_ByMcs_best_h1_Y = fProngMom_ByMcs_best_h1_Y[0] + fProngMom_ByMcs_best_h1_Y[1];
+      fTotMom_ByMcs_best_h1_Z = fProngMom_ByMcs_best_h1_Z[0] + fProngMom_ByMcs_best_h1_Z[1];
+      fTotMom_ByMcs_fwd_h2_X = fProngMom_ByMcs_fwd_h2_X[0] + fProngMom_ByMcs_fwd_h2_X[1];
+      fTotMom_ByMcs_fwd_h2_Y = fProngMom_ByMcs_fwd_h2_Y[0] + fProngMom_ByMcs_fwd_h2_Y[1];
+      fTotMom_ByMcs_fwd_h2_Z = fProngMom_ByMcs_fwd_h2_Z[0] + fProngMom_ByMcs_fwd_h2_Z[1];
+      fTotMom_ByMcs_best_h2_X = fProngMom_ByMcs_best_h2_X[0] + fProngMom_ByMcs_best_h2_X[1];
+      fTotMom_ByMcs_best_h2_Y = fProngMom_ByMcs_best_h2_Y[0] + fProngMom_ByMcs_best_h2_Y[1];
+      fTotMom_ByMcs_best_h2_Z = fProngMom_ByMcs_best_h2_Z[0] + fProngMom_ByMcs_best_h2_Z[1];
+      fTotMomMag_ByMcs_fwd_h1 = sqrt(pow(fTotMom_ByMcs_fwd_h1_X,2.) + pow(fTotMom_ByMcs_fwd_h1_Y,2.) + pow(fTotMom_ByMcs_fwd_h1_Z,2.));
+      fTotMomMag_ByMcs_best_h1 = sqrt(pow(fTotMom_ByMcs_best_h1_X,2.) + pow(fTotMom_ByMcs_best_h1_Y,2.) + pow(fTotMom_ByMcs_best_h1_Z,2.));
+      fTotMomMag_ByMcs_fwd_h2 = sqrt(pow(fTotMom_ByMcs_fwd_h2_X,2.) + pow(fTotMom_ByMcs_fwd_h2_Y,2.) + pow(fTotMom_ByMcs_fwd_h2_Z,2.));
+      fTotMomMag_ByMcs_best_h2 = sqrt(pow(fTotMom_ByMcs_best_h2_X,2.) + pow(fTotMom_ByMcs_best_h2_Y,2.) + pow(fTotMom_ByMcs_best_h2_Z,2.));
+      fTotDir_ByMcs_fwd_h1_X = fTotMom_ByMcs_fwd_h1_X/fTotMomMag_ByMcs_fwd_h1;
+      fTotDir_ByMcs_fwd_h1_Y = fTotMom_ByMcs_fwd_h1_Y/fTotMomMag_ByMcs_fwd_h1;
+      fTotDir_ByMcs_fwd_h1_Z = fTotMom_ByMcs_fwd_h1_Z/fTotMomMag_ByMcs_fwd_h1;
+      fTotDir_ByMcs_best_h1_X = fTotMom_ByMcs_best_h1_X/fTotMomMag_ByMcs_best_h1;
+      fTotDir_ByMcs_best_h1_Y = fTotMom_ByMcs_best_h1_Y/fTotMomMag_ByMcs_best_h1;
+      fTotDir_ByMcs_best_h1_Z = fTotMom_ByMcs_best_h1_Z/fTotMomMag_ByMcs_best_h1;
+      fTotDir_ByMcs_fwd_h2_X = fTotMom_ByMcs_fwd_h2_X/fTotMomMag_ByMcs_fwd_h2;
+      fTotDir_ByMcs_fwd_h2_Y = fTotMom_ByMcs_fwd_h2_Y/fTotMomMag_ByMcs_fwd_h2;
+      fTotDir_ByMcs_fwd_h2_Z = fTotMom_ByMcs_fwd_h2_Z/fTotMomMag_ByMcs_fwd_h2;
+      fTotDir_ByMcs_best_h2_X = fTotMom_ByMcs_best_h2_X/fTotMomMag_ByMcs_best_h2;
+      fTotDir_ByMcs_best_h2_Y = fTotMom_ByMcs_best_h2_Y/fTotMomMag_ByMcs_best_h2;
+      fTotDir_ByMcs_best_h2_Z = fTotMom_ByMcs_best_h2_Z/fTotMomMag_ByMcs_best_h2;
+      fTotTheta_ByMcs_fwd_h1 = acos(fTotDir_ByMcs_fwd_h1_Z);
+      fTotPhi_ByMcs_fwd_h1 = atan2(fTotDir_ByMcs_fwd_h1_Y,fTotDir_ByMcs_fwd_h1_X);
+      fTotTheta_ByMcs_best_h1 = acos(fTotDir_ByMcs_best_h1_Z);
+      fTotPhi_ByMcs_best_h1 = atan2(fTotDir_ByMcs_best_h1_Y,fTotDir_ByMcs_best_h1_X);
+      fTotTheta_ByMcs_fwd_h2 = acos(fTotDir_ByMcs_fwd_h2_Z);
+      fTotPhi_ByMcs_fwd_h2 = atan2(fTotDir_ByMcs_fwd_h2_Y,fTotDir_ByMcs_fwd_h2_X);
+      fTotTheta_ByMcs_best_h2 = acos(fTotDir_ByMcs_best_h2_Z);
+      fTotPhi_ByMcs_best_h2 = atan2(fTotDir_ByMcs_best_h2_Y,fTotDir_ByMcs_best_h2_X);
+      fTotEnergy_ByMcs_fwd_h1 = fProngEnergy_ByMcs_fwd_h1[0] + fProngEnergy_ByMcs_fwd_h1[1];
+      fTotEnergy_ByMcs_best_h1 = fProngEnergy_ByMcs_best_h1[0] + fProngEnergy_ByMcs_best_h1[1];
+      fTotEnergy_ByMcs_fwd_h2 = fProngEnergy_ByMcs_fwd_h2[0] + fProngEnergy_ByMcs_fwd_h2[1];
+      fTotEnergy_ByMcs_best_h2 = fProngEnergy_ByMcs_best_h2[0] + fProngEnergy_ByMcs_best_h2[1];
+      fInvMass_ByMcs_fwd_h1 = sqrt(pow(fTotEnergy_ByMcs_fwd_h1,2.) - pow(fTotMomMag_ByMcs_fwd_h1,2.));
+      fInvMass_ByMcs_best_h1 = sqrt(pow(fTotEnergy_ByMcs_best_h1,2.) - pow(fTotMomMag_ByMcs_best_h1,2.));
+      fInvMass_ByMcs_fwd_h2 = sqrt(pow(fTotEnergy_ByMcs_fwd_h2,2.) - pow(fTotMomMag_ByMcs_fwd_h2,2.));
+      fInvMass_ByMcs_best_h2 = sqrt(pow(fTotEnergy_ByMcs_best_h2,2.) - pow(fTotMomMag_ByMcs_best_h2,2.));
+      SetOpeningAngleAndDistances();
+    }
+
+    // Tail shared by both momentum setters in the baseline, with its two temporary direction vectors
+    void SetOpeningAngleAndDistances()
+    {
+      std::vector<double> startDirection1 = {fProng[0].startDirection[0], fProng[0].startDirection[1], fProng[0].startDirection[2]};
+      std::vector<double> startDirection2 = {fProng[1].startDirection[0], fProng[1].startDirection[1], fProng[1].startDirection[2]};
+      float magnitude1 = sqrt(startDirection1[0]*startDirection1[0] + startDirection1[1]*startDirection1[1] + startDirection1[2]*startDirection1[2]);
+      float magnitude2 = sqrt(startDirection2[0]*startDirection2[0] + startDirection2[1]*startDirection2[1] + startDirection2[2]*startDirection2[2]);
+      float dotProduct = startDirection1[0]*startDirection2[0] + startDirection1[1]*startDirection2[1] + startDirection1[2]*startDirection2[2];
+      fOpeningAngle = acos(dotProduct / (magnitude1*magnitude2));
+      float prong1_distance = sqrt(pow(fX - fProngX[0],2.) + pow(fY - fProngY[0],2.) + pow(fZ - fProngZ[0],2.));
+      float prong2_distance = sqrt(pow(fX - fProngX[1],2.) + pow(fY - fProngY[1],2.) + pow(fZ - fProngZ[1],2.));
+      fProngStartToNeutrinoDistance = {prong1_distance,prong2_distance};
+    }
+
+    // Fixture values standing in for the art objects behind the pointers below
+    std::array<ProngFixture,2> fProng;
+
+    // Data products pointers
+    art::Ptr<recob::Vertex> fNuVertex;
+    std::vector<art::Ptr<recob::Vertex>> fProngVertex;
+    std::vector<art::Ptr<recob::Track>> fProngTrack;
+    std::vector<art::Ptr<recob::MCSFitResult>> fProngMcs;
+    std::vector<std::vector<art::Ptr<recob::Hit>>> fProngHits;
+    std::vector<art::Ptr<recob::Hit>> fTotHitsInMaxRadius;
+
+    float fX, fY, fZ;
+    std::vector<int> fChannelLoc;
+    std::vector<float> fTickLoc;
+    std::vector<float> fProngX, fProngY, fProngZ;
+    std::vector<std::vector<int>> fProngChannelLoc;
+    std::vector<std::vector<float>> fProngTickLoc;
+    std::vector<float> fProngStartX, fProngStartY, fProngStartZ;
+    std::vector<float> fProngEndX, fProngEndY, fProngEndZ;
+    std::vector<float> fProngDirX, fProngDirY, fProngDirZ;
+    std::vector<float> fProngTheta, fProngPhi;
+    std::vector<int> fProngPdgCode_h1, fProngPdgCode_h2;
+    std::vector<float> fProngMass_h1, fProngMass_h2;
+
+    std::vector<float> fProngMom_ByRange_h1_X, fProngMom_ByRange_h1_Y, fProngMom_ByRange_h1_Z;
+    std::vector<float> fProngMom_ByRange_h2_X, fProngMom_ByRange_h2_Y, fProngMom_ByRange_h2_Z;
+    std::vector<float> fProngMomMag_ByRange_h1, fProngEnergy_ByRange_h1;
+    std::vector<float> fProngMomMag_ByRange_h2, fProngEnergy_ByRange_h2;
+    float fTotMom_ByRange_h1_X, fTotMom_ByRange_h1_Y, fTotMom_ByRange_h1_Z;
+    float fTotMom_ByRange_h2_X, fTotMom_ByRange_h2_Y, fTotMom_ByRange_h2_Z;
+    float fTotDir_ByRange_h1_X, fTotDir_ByRange_h1_Y, fTotDir_ByRange_h1_Z;
+    float fTotDir_ByRange_h2_X, fTotDir_ByRange_h2_Y, fTotDir_ByRange_h2_Z;
+    float fTotTheta_ByRange_h1, fTotPhi_ByRange_h1;
+    float fTotTheta_ByRange_h2, fTotPhi_ByRange_h2;
+    float fTotMomMag_ByRange_h1, fTotEnergy_ByRange_h1, fInvMass_ByRange_h1;
+    float fTotMomMag_ByRange_h2, fTotEnergy_ByRange_h2, fInvMass_ByRange_h2;
+
+    std::vector<int> fProngPdgCodeHypothesis_ByMcs;
+    std::vector<bool> fProngIsBestFwd_ByMcs;
+    std::vector<float> fProngMomMag_ByMcs_fwd_h1, fProngMomMag_ByMcs_best_h1;
+    std::vector<float> fProngMomMag_ByMcs_fwd_h2, fProngMomMag_ByMcs_best_h2;
+    std::vector<float> fProngMom_ByMcs_fwd_h1_X, fProngMom_ByMcs_fwd_h1_Y, fProngMom_ByMcs_fwd_h1_Z;
+    std::vector<float> fProngMom_ByMcs_best_h1_X, fProngMom_ByMcs_best_h1_Y, fProngMom_ByMcs_best_h1_Z;
+    std::vector<float> fProngMom_ByMcs_fwd_h2_X, fProngMom_ByMcs_fwd_h2_Y, fProngMom_ByMcs_fwd_h2_Z;
+    std::vector<float> fProngMom_ByMcs_best_h2_X, fProngMom_ByMcs_best_h2_Y, fProngMom_ByMcs_best_h2_Z;
+    std::vector<float> fProngEnergy_ByMcs_fwd_h1, fProngEnergy_ByMcs_best_h1;
+    std::vector<float> fProngEnergy_ByMcs_fwd_h2, fProngEnergy_ByMcs_best_h2;
+    float fTotMom_ByMcs_fwd_h1_X, fTotMom_ByMcs_fwd_h1_Y, fTotMom_ByMcs_fwd_h1_Z;
+    float fTotMom_ByMcs_best_h1_X, fTotMom_ByMcs_best_h1_Y, fTotMom_ByMcs_best_h1_Z;
+    float fTotDir_ByMcs_fwd_h1_X, fTotDir_ByMcs_fwd_h1_Y, fTotDir_ByMcs_fwd_h1_Z;
+    float fTotDir_ByMcs_best_h1_X, fTotDir_ByMcs_best_h1_Y, fTotDir_ByMcs_best_h1_Z;
+    float fTotTheta_ByMcs_fwd_h1, fTotPhi_ByMcs_fwd_h1;
+    float fTotTheta_ByMcs_best_h1, fTotPhi_ByMcs_best_h1;
+    float fTotMomMag_ByMcs_fwd_h1, fTotEnergy_ByMcs_fwd_h1, fInvMass_ByMcs_fwd_h1;
+    float fTotMomMag_ByMcs_best_h1, fTotEnergy_ByMcs_best_h1, fInvMass_ByMcs_best_h1;
+    float fTotMom_ByMcs_fwd_h2_X, fTotMom_ByMcs_fwd_h2_Y, fTotMom_ByMcs_fwd_h2_Z;
+    float fTotMom_ByMcs_best_h2_X, fTotMom_ByMcs_best_h2_Y, fTotMom_ByMcs_best_h2_Z;
+    float fTotDir_ByMcs_fwd_h2_X, fTotDir_ByMcs_fwd_h2_Y, fTotDir_ByMcs_fwd_h2_Z;
+    float fTotDir_ByMcs_best_h2_X, fTotDir_ByMcs_best_h2_Y, fTotDir_ByMcs_best_h2_Z;
+    float fTotTheta_ByMcs_fwd_h2, fTotPhi_ByMcs_fwd_h2;
+    float fTotTheta_ByMcs_best_h2, fTotPhi_ByMcs_best_h2;
+    float fTotMomMag_ByMcs_fwd_h2, fTotEnergy_ByMcs_fwd_h2, fInvMass_ByMcs_fwd_h2;
+    float fTotMomMag_ByMcs_best_h2, fTotEnergy_ByMcs_best_h2, fInvMass_ByMcs_best_h2;
+
+    std::vector<float> fProngLength;
+    float fOpeningAngle;
+    std::vector<float> fProngStartToNeutrinoDistance;
+    std::vector<int> fProngNumHits;
+
+    bool fIsInsideTPC;
+    bool fIsDetLocAssigned;
+  };
+
+  ProngFixture MakeProng(float value, int prong)
+  {
+    const float sign = (prong == 0) ? 1. : -1.;
+    ProngFixture p = {
+      {value, value, value},
+      {value, value, value}, {value + sign*30.f, value + 10.f, value + 40.f},
+      50.f + 10.f*prong + value, 0.7f, sign*0.4f,
+      {0.6f*sign, 0.2f, 0.77f},
+      {0.6*sign, 0.2, 0.77},
+      13, true, 0.3f + 0.01f*value, 0.32f + 0.01f*value
+    };
+    return p;
+  }
+
+  void FillBatchCandidate(AuxVertex::CandidateBatch & batch, size_t c, float value, const AuxEvent::HitRange & prongHits, const AuxEvent::HitRange & totHits)
+  {
+    // Write a representative subset of columns, storage is inline so the amount written does not change the allocations
+    batch.fX[c] = value;
+    batch.fProngX[c] = {{value, value}};
+    batch.fProngLength[c] = {{value, value}};
+    batch.fKinematics_ByRange[c].prongMomMag[0] = {{value, value}};
+    batch.fChannelLoc[c] = {{-1,-1,-1}};
+    batch.fProngTickLoc[c] = {{ {{-1.,-1.,-1.}}, {{-1.,-1.,-1.}} }};
+    batch.fProngHits[c] = {{prongHits, prongHits}};
+    batch.SetTotHits(c, totHits);
+  }
+} // END anonymous namespace
+
+int main(int argc, char** argv)
+{
+  const size_t nEvents = (argc > 1) ? atoi(argv[1]) : 10000;
+  const size_t nCandidates = (argc > 2) ? atoi(argv[2]) : 4;
+  const size_t nHits = (argc > 3) ? atoi(argv[3]) : 100;
+  printf("Filling %zu events with %zu candidates each, %zu hits per prong.\n", nEvents, nCandidates, nHits);
+
+  // Hits of the event, as the art::Ptr vectors the old algorithms got from the associations (the hits in the maximum radius are the two prongs)
+  const std::vector<art::Ptr<recob::Hit>> prongHits(nHits);
+  const std::vector<art::Ptr<recob::Hit>> totHits(2*nHits);
+  const float nuVertex[3] = {100., 0., 500.};
+
+  // Old layout: candidates are built one by one, then copied into the event vector (as in FindPandoraVertexAlg) and once more when read back (as in ExtractTruthInformationAlg).
+  size_t start = gNumAllocations;
+  auto t0 = std::chrono::steady_clock::now();
+  float checksum = 0.;
+  for (size_t e=0; e!=nEvents; e++)
+  {
+    std::vector<BaselineDecayVertex> candidates;
+    for (size_t c=0; c!=nCandidates; c++)
+    {
+      BaselineDecayVertex candidate(nuVertex, MakeProng(c, 0), MakeProng(c, 1), prongHits, prongHits);
+      candidates.push_back(candidate);
+    }
+    for (BaselineDecayVertex & candidate : candidates) candidate.SetTotHits(totHits);
+    for (size_t c=0; c!=candidates.size(); c++)
+    {
+      BaselineDecayVertex copy = candidates[c];
+      checksum += copy.fProngLength[1] + copy.fInvMass_ByRange_h1;
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  size_t legacyAllocations = gNumAllocations - start;
+
+  // CandidateBatch: one batch reused for every event, the hits are ranges of the event hit pool.
+  start = gNumAllocations;
+  auto t2 = std::chrono::steady_clock::now();
+  AuxVertex::CandidateBatch batch;
+  AuxEvent::HitRange prongRange, totRange;
+  prongRange.end = nHits;
+  totRange.end = 2*nHits;
+  for (size_t e=0; e!=nEvents; e++)
+  {
+    batch.Clear();
+    for (size_t c=0; c!=nCandidates; c++) FillBatchCandidate(batch, batch.AddEmptyCandidate(), c, prongRange, totRange);
+    for (size_t c=0; c!=batch.Size(); c++) checksum += batch.fProngX[c][1];
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  size_t batchAllocations = gNumAllocations - start;
+
+  const double nTot = nEvents*nCandidates;
+  printf("|_DecayVertex layout:    %10zu allocations (%.2f per candidate), %.1f ms\n", legacyAllocations, legacyAllocations/nTot, std::chrono::duration<double,std::milli>(t1-t0).count());
+  printf("|_CandidateBatch layout: %10zu allocations (%.2f per candidate), %.1f ms\n", batchAllocations, batchAllocations/nTot, std::chrono::duration<double,std::milli>(t3-t2).count());
+  printf("|_Checksum: %.1f\n", checksum);
+  return 0;
+} // END function main
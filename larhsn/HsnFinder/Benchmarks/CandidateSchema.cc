@@ -0,0 +1,150 @@
+/******************************************************************************
+ * @file CandidateSchema.cc
+ * @brief Size on disk and read throughput of the candidate data with the streamed (v1) and flat (v2) schemas
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateFlatRow.h CandidateReader.h
+ *
+ * Usage: CandidateSchema <hsnFinder output> [module directory] [repetitions]
+ * The candidate data of an HsnFinder output is written again with both schemas, to CandidateSchema_v1.root and CandidateSchema_v2.root
+ * (each with the MetaData tree, as HsnFinder writes it). Both are read back through CandidateReader, once with all the columns
+ * and once with only the calorimetry columns, and the rows read from the two files are compared.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TTree.h"
+
+// HSN finder includes
+#include "larhsn/HsnFinder/DataObjects/CandidateTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateFlatRow.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateReader.h"
+#include "larhsn/HsnFinder/DataObjects/FieldBinders.h"
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+  double Seconds(Clock::time_point t0) {return std::chrono::duration<double>(Clock::now() - t0).count();}
+
+  // Write the rows with a schema, in a file laid out as an HsnFinder output
+  void Write(const std::string & path, const std::vector<AuxEvent::CandidateTreeFiller> & rows, int schemaVersion, int nRadii, bool withTruthDistance)
+  {
+    TFile file(path.c_str(), "RECREATE");
+    TTree* metaTree = new TTree("MetaData", "");
+    metaTree->SetDirectory(&file);
+    metaTree->Branch("candidateSchemaVersion", &schemaVersion, "candidateSchemaVersion/I");
+    metaTree->Branch("radiusProfileBins", &nRadii, "radiusProfileBins/I");
+    metaTree->Fill();
+
+    TTree* tree = new TTree("CandidateData", "");
+    tree->SetDirectory(&file);
+    AuxEvent::CandidateTreeFiller ctf;
+    AuxEvent::CandidateFlatRow cfr;
+    if (schemaVersion == AuxEvent::kCandidateSchemaFlat)
+    {
+      cfr.SetNumRadii(nRadii);
+      AuxEvent::FlatBranchBinder binder(tree);
+      cfr.BindFields(binder, withTruthDistance);
+    }
+    else
+    {
+      AuxEvent::TreeBranchBinder binder(tree);
+      ctf.BindFields(binder, withTruthDistance);
+    }
+    for (const AuxEvent::CandidateTreeFiller & row : rows)
+    {
+      ctf = row;
+      if (schemaVersion == AuxEvent::kCandidateSchemaFlat) cfr.Set(ctf);
+      tree->Fill();
+    }
+    file.Write();
+    return;
+  }
+
+  // Read all the rows back. Returns a checksum of a few quantities of every column group.
+  double Read(const std::string & path, const std::string & columns)
+  {
+    TFile file(path.c_str(), "READ");
+    AuxEvent::CandidateReader reader(file);
+    if (!columns.empty()) reader.SelectColumns(columns);
+    double checksum = 0.;
+    for (long long i=0; i!=reader.GetEntries(); i++)
+    {
+      const AuxEvent::CandidateFlatRow & row = reader.GetEntry(i);
+      if (columns.empty()) checksum += row.event + row.geo_prongLength[0] + row.range_prongMom_X[0][1] + row.mcs_prongPdgCodeHypothesis[1];
+      if (row.NumRadii() > 0) checksum += row.calo_totChargeInRadius.back();
+    }
+    return checksum;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    printf("Usage: CandidateSchema <hsnFinder output> [module directory] [repetitions]\n");
+    return 1;
+  }
+  const std::string directory = (argc > 2) ? argv[2] : "hsnFinder";
+  const int repetitions = (argc > 3) ? atoi(argv[3]) : 5;
+
+  // Load the candidate rows into memory
+  std::vector<AuxEvent::CandidateTreeFiller> rows;
+  bool withTruthDistance = false;
+  int nRadii = 0;
+  {
+    TFile input(argv[1], "READ");
+    AuxEvent::CandidateReader reader(*input.GetDirectory(directory.c_str()));
+    if (reader.GetSchemaVersion() != AuxEvent::kCandidateSchemaStreamed)
+    {
+      printf("The input must have CandidateSchemaVersion 1.\n");
+      return 1;
+    }
+    TTree* tree = reader.GetTree();
+    withTruthDistance = reader.HasTruthDistance();
+    AuxEvent::CandidateTreeFiller ctf;
+    AuxEvent::TreeAddressBinder binder(tree);
+    ctf.BindFields(binder, withTruthDistance);
+    for (Long64_t i=0; i!=tree->GetEntries(); i++)
+    {
+      tree->GetEntry(i);
+      rows.push_back(ctf);
+      nRadii = std::max(nRadii, (int) ctf.calo_totChargeInRadius.size());
+    }
+  }
+  printf("%zu candidates, %d radii.\n", rows.size(), nRadii);
+
+  const std::vector<std::string> paths = {"CandidateSchema_v1.root", "CandidateSchema_v2.root"};
+  std::vector<double> writeTime(2, 0.), readTime(2, 0.), caloTime(2, 0.), checksum(2, 0.);
+  for (int r=0; r!=repetitions; r++)
+  {
+    for (int s=0; s!=2; s++)
+    {
+      auto t0 = Clock::now();
+      Write(paths[s], rows, s+1, nRadii, withTruthDistance);
+      writeTime[s] += Seconds(t0);
+      t0 = Clock::now();
+      checksum[s] = Read(paths[s], "");
+      readTime[s] += Seconds(t0);
+      t0 = Clock::now();
+      Read(paths[s], "calo_");
+      caloTime[s] += Seconds(t0);
+    }
+  }
+
+  const double nRows = rows.size()*repetitions;
+  printf("                          %12s %12s\n", "v1", "v2");
+  printf("Size on disk [MB]         %12.2f %12.2f\n", TFile(paths[0].c_str()).GetSize()/1048576., TFile(paths[1].c_str()).GetSize()/1048576.);
+  printf("Write [rows/s]            %12.0f %12.0f\n", nRows/writeTime[0], nRows/writeTime[1]);
+  printf("Read all [rows/s]         %12.0f %12.0f\n", nRows/readTime[0], nRows/readTime[1]);
+  printf("Read calorimetry [rows/s] %12.0f %12.0f\n", nRows/caloTime[0], nRows/caloTime[1]);
+  printf("Rows read back %s\n", (checksum[0] == checksum[1]) ? "agree" : "DISAGREE");
+  return 0;
+} // END function main
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * @file RadiusProfileKernel.cc
+ * @brief Compare the scalar and AVX2 radius profile kernels on events with realistic hit multiplicities
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  RadiusProfileKernel.h
+ *
+ * Usage: RadiusProfileKernel [nRepetitions]
+ * Every hit of a plane is compared with the vertex of each candidate, as in the calorimetry without the hit grid.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+// HSN finder includes
+#include "larhsn/HsnFinder/DataObjects/RadiusProfileKernel.h"
+
+namespace
+{
+  // MicroBooNE-like plane: 3456 channels and 9600 ticks, normalized with the default ChannelNorm and TickNorm
+  constexpr float kChannelNorm = 3.3;
+  constexpr float kTickNorm = 17.9;
+  constexpr size_t kNumCandidates = 4;
+  constexpr size_t kNumRadii = 20;
+
+  struct PlaneHits
+  {
+    std::vector<float> u, v, charge;
+    std::vector<uint32_t> keys;
+    AuxEvent::HitColumns Columns() const {return {u.data(), v.data(), charge.data(), keys.data(), u.size()};}
+  };
+
+  // Hits spread over the plane, with half of them clustered around the candidate vertices like real interactions
+  PlaneHits MakeHits(size_t nHits, const std::vector<float> & vertexU, const std::vector<float> & vertexV, std::mt19937 & engine)
+  {
+    std::uniform_real_distribution<float> channel(0., 3456.), tick(0., 9600.), integral(50., 500.);
+    std::normal_distribution<float> cluster(0., 10.);
+    PlaneHits hits;
+    for (size_t i=0; i!=nHits; i++)
+    {
+      if (i%2 == 0)
+      {
+        hits.u.push_back(channel(engine)/kChannelNorm);
+        hits.v.push_back(tick(engine)/kTickNorm);
+      }
+      else
+      {
+        size_t c = (i/2)%vertexU.size();
+        hits.u.push_back(vertexU[c] + cluster(engine));
+        hits.v.push_back(vertexV[c] + cluster(engine));
+      }
+      hits.charge.push_back(integral(engine));
+      hits.keys.push_back(i);
+    }
+    return hits;
+  }
+
+  template <typename Kernel> double Run(Kernel kernel, const PlaneHits & hits, const std::vector<float> & vertexU, const std::vector<float> & vertexV, const std::vector<float> & radii2, size_t nRepetitions, std::vector<float> & profiles, size_t & nKeys)
+  {
+    std::vector<uint32_t> keys;
+    profiles.assign(kNumCandidates*kNumRadii, 0.);
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r=0; r!=nRepetitions; r++)
+    {
+      for (size_t c=0; c!=kNumCandidates; c++)
+      {
+        keys.clear();
+        kernel(hits.Columns(), vertexU[c], vertexV[c], radii2.data(), radii2.size(), profiles.data() + c*kNumRadii, &keys);
+      }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    nKeys = keys.size();
+    return std::chrono::duration<double,std::nano>(t1-t0).count();
+  }
+}
+
+int main(int argc, char** argv)
+{
+  const size_t nRepetitions = (argc > 1) ? atoi(argv[1]) : 200;
+  std::mt19937 engine(12345);
+
+  // Candidate vertices and profile radii (RadiusProfileLimits [0,20] cm with 20 bins)
+  std::vector<float> vertexU, vertexV, radii2;
+  std::uniform_real_distribution<float> channel(200., 3256.), tick(500., 9100.);
+  for (size_t c=0; c!=kNumCandidates; c++)
+  {
+    vertexU.push_back(channel(engine)/kChannelNorm);
+    vertexV.push_back(tick(engine)/kTickNorm);
+  }
+  for (size_t j=1; j<=kNumRadii; j++) radii2.push_back(j*j);
+
+  printf("AVX2 kernel %s on this CPU. %zu candidates, %zu radii, %zu repetitions.\n", AuxEvent::RadiusProfileHasAvx2() ? "available" : "NOT available", kNumCandidates, kNumRadii, nRepetitions);
+  for (size_t nHits : {10000, 30000, 100000})
+  {
+    PlaneHits hits = MakeHits(nHits, vertexU, vertexV, engine);
+    std::vector<float> scalarProfiles, avx2Profiles;
+    size_t scalarKeys = 0, avx2Keys = 0;
+    double scalarTime = Run(AuxEvent::AccumulateRadiusProfile_Scalar, hits, vertexU, vertexV, radii2, nRepetitions, scalarProfiles, scalarKeys);
+    double avx2Time = Run(AuxEvent::AccumulateRadiusProfile_Avx2, hits, vertexU, vertexV, radii2, nRepetitions, avx2Profiles, avx2Keys);
+
+    float maxDeviation = 0.;
+    for (size_t k=0; k!=scalarProfiles.size(); k++)
+    {
+      if (scalarProfiles[k] > 0.) maxDeviation = std::max(maxDeviation, (float) fabs(avx2Profiles[k]/scalarProfiles[k] - 1.));
+    }
+    double nComparisons = (double) nHits*kNumCandidates*nRepetitions;
+    printf("%6zu hits: scalar %.2f ns/hit, avx2 %.2f ns/hit (x%.1f). Keys in max radius %zu/%zu, max relative profile difference %.1e\n",
+      nHits, scalarTime/nComparisons, avx2Time/nComparisons, scalarTime/avx2Time, scalarKeys, avx2Keys, maxDeviation);
+  }
+  return 0;
+} // END function main
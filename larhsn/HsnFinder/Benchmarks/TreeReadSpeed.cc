@@ -0,0 +1,75 @@
+/******************************************************************************
+ * @file TreeReadSpeed.cc
+ * @brief Size and full read throughput of the output trees of every HsnFinder directory in a file
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  TreeIOPolicy.h hsnFinder_ioSweep.fcl
+ *
+ * Usage: TreeReadSpeed <hsnFinder output> [repetitions]
+ * Meant for the output of hsnFinder_ioSweep.fcl, where each directory holds the same rows written with a different OutputPolicy.
+ * Every entry of EventData, CandidateData and DrawData is read, all branches included. The first repetition warms the page cache,
+ * so the rates are decompression and deserialization rates rather than disk rates.
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TTree.h"
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+  double Seconds(Clock::time_point t0) {return std::chrono::duration<double>(Clock::now() - t0).count();}
+
+  // Read all the entries of a tree. Returns the bytes read (uncompressed).
+  long long ReadAll(TTree* tree)
+  {
+    long long nBytes = 0;
+    for (Long64_t i=0; i!=tree->GetEntries(); i++) nBytes += tree->GetEntry(i);
+    return nBytes;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    printf("Usage: TreeReadSpeed <hsnFinder output> [repetitions]\n");
+    return 1;
+  }
+  const int repetitions = (argc > 2) ? atoi(argv[2]) : 5;
+  const std::vector<std::string> treeNames = {"EventData", "CandidateData", "DrawData"};
+
+  TFile file(argv[1], "READ");
+  printf("%-20s %-14s %10s %12s %12s %7s %12s\n", "Directory", "Tree", "Entries", "Uncomp. [MB]", "Comp. [MB]", "Ratio", "Read [MB/s]");
+  TIter nextKey(file.GetListOfKeys());
+  while (TKey* key = (TKey*) nextKey())
+  {
+    TDirectory* directory = file.GetDirectory(key->GetName());
+    if (!directory) continue;
+    for (const std::string & treeName : treeNames)
+    {
+      TTree* tree = nullptr;
+      directory->GetObject(treeName.c_str(), tree);
+      if (!tree) continue;
+
+      ReadAll(tree);
+      long long nBytes = 0;
+      auto t0 = Clock::now();
+      for (int r=0; r!=repetitions; r++) nBytes += ReadAll(tree);
+      const double seconds = Seconds(t0);
+      const double totBytes = tree->GetTotBytes();
+      const double zipBytes = tree->GetZipBytes();
+      printf("%-20s %-14s %10lld %12.2f %12.2f %7.2f %12.1f\n", key->GetName(), treeName.c_str(), (long long) tree->GetEntries(), totBytes/1048576., zipBytes/1048576.,
+        (zipBytes > 0.) ? totBytes/zipBytes : 0., (seconds > 0.) ? nBytes/1048576./seconds : 0.);
+    }
+  }
+  return 0;
+} // END function main
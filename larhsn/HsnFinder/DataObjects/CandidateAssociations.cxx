@@ -0,0 +1,96 @@
+/******************************************************************************
+ * @file CandidateAssociations.cxx
+ * @brief Event-wide tables of the associations needed by the HSN candidates
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateAssociations.h
+ * ****************************************************************************/
+
+// Candidate associations header
+#include "CandidateAssociations.h"
+
+namespace AuxEvent
+{
+  CandidateAssociations::CandidateAssociations()
+  {}
+  CandidateAssociations::~CandidateAssociations()
+  {}
+
+  void CandidateAssociations::Clear()
+  {
+    fNuPfp.clear();
+    fProngPfp.clear();
+    fNuVertex.clear();
+    fProngVertex.clear();
+    fProngTrack.clear();
+    fProngMcs.clear();
+    fProngHits.clear();
+  } // END function Clear
+
+  size_t CandidateAssociations::AddCandidate(
+    const art::Ptr<recob::PFParticle> &nuPfp,
+    const art::Ptr<recob::PFParticle> &t1Pfp,
+    const art::Ptr<recob::PFParticle> &t2Pfp)
+  {
+    // Associations are left null until they are resolved
+    fNuPfp.push_back(nuPfp);
+    fProngPfp.push_back({{t1Pfp, t2Pfp}});
+    fNuVertex.emplace_back();
+    fProngVertex.emplace_back();
+    fProngTrack.emplace_back();
+    fProngMcs.emplace_back();
+    fProngHits.emplace_back();
+    return fNuPfp.size()-1;
+  } // END function AddCandidate
+
+  size_t CandidateAssociations::NumCandidates() const {return fNuPfp.size();}
+
+  std::vector<art::Ptr<recob::PFParticle>> CandidateAssociations::GetVertexQuery() const
+  {
+    // Layout: [nu_0 ... nu_N-1, c0_t1, c0_t2, c1_t1, c1_t2, ...]
+    std::vector<art::Ptr<recob::PFParticle>> query;
+    query.reserve(3*NumCandidates());
+    query.insert(query.end(), fNuPfp.begin(), fNuPfp.end());
+    for (auto const& prongs : fProngPfp) query.insert(query.end(), prongs.begin(), prongs.end());
+    return query;
+  } // END function GetVertexQuery
+
+  std::vector<art::Ptr<recob::PFParticle>> CandidateAssociations::GetTrackQuery() const
+  {
+    // Layout: [c0_t1, c0_t2, c1_t1, c1_t2, ...]
+    std::vector<art::Ptr<recob::PFParticle>> query;
+    query.reserve(2*NumCandidates());
+    for (auto const& prongs : fProngPfp) query.insert(query.end(), prongs.begin(), prongs.end());
+    return query;
+  } // END function GetTrackQuery
+
+  // Setters
+  void CandidateAssociations::SetNuVertex(size_t cand, const art::Ptr<recob::Vertex> &vertex) {fNuVertex[cand] = vertex; return;}
+  void CandidateAssociations::SetProngVertex(size_t cand, int prong, const art::Ptr<recob::Vertex> &vertex) {fProngVertex[cand][prong] = vertex; return;}
+  void CandidateAssociations::SetProngTrack(size_t cand, int prong, const art::Ptr<recob::Track> &track) {fProngTrack[cand][prong] = track; return;}
+  void CandidateAssociations::SetProngMcs(size_t cand, int prong, const art::Ptr<recob::MCSFitResult> &mcs) {fProngMcs[cand][prong] = mcs; return;}
+  void CandidateAssociations::SetProngHits(size_t cand, int prong, const AuxEvent::HitRange &hits) {fProngHits[cand][prong] = hits; return;}
+
+  // Getters
+  const art::Ptr<recob::PFParticle> & CandidateAssociations::GetNuPfp(size_t cand) const {return fNuPfp[cand];}
+  const art::Ptr<recob::Vertex> & CandidateAssociations::GetNuVertex(size_t cand) const {return fNuVertex[cand];}
+  const art::Ptr<recob::Vertex> & CandidateAssociations::GetProngVertex(size_t cand, int prong) const {return fProngVertex[cand][prong];}
+  const art::Ptr<recob::Track> & CandidateAssociations::GetProngTrack(size_t cand, int prong) const {return fProngTrack[cand][prong];}
+  const art::Ptr<recob::MCSFitResult> & CandidateAssociations::GetProngMcs(size_t cand, int prong) const {return fProngMcs[cand][prong];}
+  const AuxEvent::HitRange & CandidateAssociations::GetProngHits(size_t cand, int prong) const {return fProngHits[cand][prong];}
+  size_t CandidateAssociations::GetNumProngHits(size_t cand, int prong) const {return fProngHits[cand][prong].size();}
+
+  // Status
+  bool CandidateAssociations::HasVertices(size_t cand) const
+  {
+    return (fNuVertex[cand].isNonnull() && fProngVertex[cand][0].isNonnull() && fProngVertex[cand][1].isNonnull());
+  }
+  bool CandidateAssociations::HasTracks(size_t cand) const
+  {
+    return (fProngTrack[cand][0].isNonnull() && fProngTrack[cand][1].isNonnull());
+  }
+  bool CandidateAssociations::HasHits(size_t cand) const
+  {
+    return (GetNumProngHits(cand,0)>1 && GetNumProngHits(cand,1)>1);
+  }
+
+} // END namespace AuxEvent
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * @file CandidateAssociations.h
+ * @brief Event-wide tables of the associations needed by the HSN candidates
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateAssociations.cxx
+ * ****************************************************************************/
+
+#ifndef CANDIDATEASSOCIATIONS_H
+#define CANDIDATEASSOCIATIONS_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <array>
+#include <vector>
+#include "canvas/Persistency/Common/Ptr.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Vertex.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/MCSFitResult.h"
+#include "larhsn/HsnFinder/DataObjects/HitPool.h"
+
+namespace AuxEvent
+{
+
+  // CandidateAssociations class and functions
+  // Candidates (neutrino pfp with exactly two track daughters) are registered first, then all their associations are resolved with one query per association type.
+  // Every table is addressed by the candidate index returned by AddCandidate (and by prong index 0/1 where relevant).
+  class CandidateAssociations
+  {
+  public:
+    // Constructor and destructor
+    CandidateAssociations();
+    virtual ~CandidateAssociations();
+
+    void Clear();
+
+    // Registration stage
+    size_t AddCandidate(
+      const art::Ptr<recob::PFParticle> &nuPfp,
+      const art::Ptr<recob::PFParticle> &t1Pfp,
+      const art::Ptr<recob::PFParticle> &t2Pfp);
+    size_t NumCandidates() const;
+
+    // Flat lists of pfps used to query the associations (neutrinos first, then prongs of each candidate in order)
+    std::vector<art::Ptr<recob::PFParticle>> GetVertexQuery() const;
+    std::vector<art::Ptr<recob::PFParticle>> GetTrackQuery() const;
+
+    // Resolution stage (filled from the results of the queries above)
+    void SetNuVertex(size_t cand, const art::Ptr<recob::Vertex> &vertex);
+    void SetProngVertex(size_t cand, int prong, const art::Ptr<recob::Vertex> &vertex);
+    void SetProngTrack(size_t cand, int prong, const art::Ptr<recob::Track> &track);
+    void SetProngMcs(size_t cand, int prong, const art::Ptr<recob::MCSFitResult> &mcs);
+    void SetProngHits(size_t cand, int prong, const AuxEvent::HitRange &hits);
+
+    // Index-addressed tables
+    const art::Ptr<recob::PFParticle> & GetNuPfp(size_t cand) const;
+    const art::Ptr<recob::Vertex> & GetNuVertex(size_t cand) const;
+    const art::Ptr<recob::Vertex> & GetProngVertex(size_t cand, int prong) const;
+    const art::Ptr<recob::Track> & GetProngTrack(size_t cand, int prong) const;
+    const art::Ptr<recob::MCSFitResult> & GetProngMcs(size_t cand, int prong) const;
+    const AuxEvent::HitRange & GetProngHits(size_t cand, int prong) const;
+    size_t GetNumProngHits(size_t cand, int prong) const;
+
+    // Status of each candidate
+    bool HasVertices(size_t cand) const;
+    bool HasTracks(size_t cand) const;
+    bool HasHits(size_t cand) const;
+
+  private:
+    std::vector<art::Ptr<recob::PFParticle>> fNuPfp;
+    std::vector<std::array<art::Ptr<recob::PFParticle>,2>> fProngPfp;
+    std::vector<art::Ptr<recob::Vertex>> fNuVertex;
+    std::vector<std::array<art::Ptr<recob::Vertex>,2>> fProngVertex;
+    std::vector<std::array<art::Ptr<recob::Track>,2>> fProngTrack;
+    std::vector<std::array<art::Ptr<recob::MCSFitResult>,2>> fProngMcs;
+    std::vector<std::array<AuxEvent::HitRange,2>> fProngHits; // Ranges in the event hit pool
+  };
+
+} //END namespace AuxEvent
+
+#endif
@@ -0,0 +1,348 @@
+/******************************************************************************
+ * @file CandidateBatch.cxx
+ * @brief Struct-of-arrays storage for all the HSN decay vertex candidates of an event
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateBatch.h
+ * ****************************************************************************/
+
+// Candidate batch header
+#include "CandidateBatch.h"
+
+namespace AuxVertex
+{
+  CandidateBatch::CandidateBatch() : fHitPool(nullptr), fRangeTable(nullptr), fSize(0)
+  {}
+  CandidateBatch::~CandidateBatch()
+  {}
+
+  template <typename F> void CandidateBatch::ForEachColumn(F && f)
+  {
+    f(fNuVertex);
+    f(fProngVertex);
+    f(fProngTrack);
+    f(fProngMcs);
+    f(fProngHits);
+    f(fTotHitsInMaxRadius);
+    f(fX);
+    f(fY);
+    f(fZ);
+    f(fChannelLoc);
+    f(fTickLoc);
+    f(fProngX);
+    f(fProngY);
+    f(fProngZ);
+    f(fProngChannelLoc);
+    f(fProngTickLoc);
+    f(fProngStartX);
+    f(fProngStartY);
+    f(fProngStartZ);
+    f(fProngEndX);
+    f(fProngEndY);
+    f(fProngEndZ);
+    f(fProngDirX);
+    f(fProngDirY);
+    f(fProngDirZ);
+    f(fProngTheta);
+    f(fProngPhi);
+    f(fProngPdgCode);
+    f(fProngMass);
+    f(fKinematics_ByRange);
+    f(fKinematics_ByMcs_fwd);
+    f(fKinematics_ByMcs_best);
+    f(fProngPdgCodeHypothesis_ByMcs);
+    f(fProngIsBestFwd_ByMcs);
+    f(fProngLength);
+    f(fOpeningAngle);
+    f(fProngStartToNeutrinoDistance);
+    f(fProngNumHits);
+    f(fIsInsideTPC);
+    f(fIsDetLocAssigned);
+  } // END function ForEachColumn
+
+  // Batch handling
+  void CandidateBatch::Clear()
+  {
+    // Columns keep their capacity, so the next event can reuse it
+    ForEachColumn([](auto & column){column.clear();});
+    fSize = 0;
+  } // END function Clear
+
+  void CandidateBatch::Reserve(size_t n)
+  {
+    ForEachColumn([n](auto & column){column.reserve(n);});
+  } // END function Reserve
+
+  size_t CandidateBatch::AddEmptyCandidate()
+  {
+    ForEachColumn([](auto & column){column.emplace_back();});
+    return fSize++;
+  } // END function AddEmptyCandidate
+
+  void CandidateBatch::PopBack()
+  {
+    if (fSize == 0) return;
+    ForEachColumn([](auto & column){column.pop_back();});
+    fSize--;
+  } // END function PopBack
+
+  size_t CandidateBatch::Size() const {return fSize;}
+  void CandidateBatch::SetHitPool(const AuxEvent::HitPool* hitPool) {fHitPool = hitPool; return;}
+  void CandidateBatch::SetRangeTable(const AuxVertex::RangeMomentumTable* rangeTable) {fRangeTable = rangeTable; return;}
+
+  size_t CandidateBatch::AddCandidate(
+            const art::Ptr<recob::Vertex> &nuVertex,
+            const art::Ptr<recob::Vertex> &t1Vertex,
+            const art::Ptr<recob::Vertex> &t2Vertex,
+            const art::Ptr<recob::Track> &t1Track,
+            const art::Ptr<recob::Track> &t2Track,
+            const AuxEvent::HitRange &t1Hits,
+            const AuxEvent::HitRange &t2Hits,
+            const art::Ptr<recob::MCSFitResult> &t1Mcs,
+            const art::Ptr<recob::MCSFitResult> &t2Mcs)
+  {
+    /*
+    This function appends a HSN decay vertex candidate to the batch and returns its index.
+    It is assigned when a neutrino with two (and only two) track daughters has been found.
+    The candidate is build using the vertex pointers to the neutrino and the two start points of the tracks, the actual track objects and all the hits associated with the two track objects.
+    Hits are not copied, only their ranges in the event hit pool are stored.
+    */
+
+    const size_t c = AddEmptyCandidate();
+
+    // Set default mock attributes for the Decay Vertex candidate
+    // The real values for these attributes will be assigned later
+    fChannelLoc[c] = {-1,-1,-1};
+    fTickLoc[c] = {-1.,-1.,-1.};
+    fProngChannelLoc[c] = {{ {{-1,-1,-1}}, {{-1,-1,-1}} }};
+    fProngTickLoc[c] = {{ {{-1.,-1.,-1.}}, {{-1.,-1.,-1.}} }};
+    fIsDetLocAssigned[c] = false;
+    fIsInsideTPC[c] = false;
+
+    // Store pointers to reconstructed objects provided as input in internal attributes
+    fNuVertex[c] = nuVertex;
+    fProngVertex[c] = {t1Vertex, t2Vertex};
+    fProngTrack[c] = {t1Track, t2Track};
+    fProngHits[c] = {{t1Hits, t2Hits}};
+    fProngMcs[c] = {t1Mcs, t2Mcs};
+
+    // Use pointers to reconstructed objects to obtain start coordinates for vertices.
+    double nuVertexPosition[3], t1VertexPosition[3], t2VertexPosition[3];
+    nuVertex->XYZ(nuVertexPosition);
+    t1Vertex->XYZ(t1VertexPosition);
+    t2Vertex->XYZ(t2VertexPosition);
+    fX[c] = nuVertexPosition[0];
+    fY[c] = nuVertexPosition[1];
+    fZ[c] = nuVertexPosition[2];
+    fProngX[c] = {(float) t1VertexPosition[0], (float) t2VertexPosition[0]};
+    fProngY[c] = {(float) t1VertexPosition[1], (float) t2VertexPosition[1]};
+    fProngZ[c] = {(float) t1VertexPosition[2], (float) t2VertexPosition[2]};
+    // Do the same for tracks.
+    fProngStartX[c] = {(float) fProngTrack[c][0]->Start().X(), (float) fProngTrack[c][1]->Start().X()};
+    fProngStartY[c] = {(float) fProngTrack[c][0]->Start().Y(), (float) fProngTrack[c][1]->Start().Y()};
+    fProngStartZ[c] = {(float) fProngTrack[c][0]->Start().Z(), (float) fProngTrack[c][1]->Start().Z()};
+    fProngEndX[c] = {(float) fProngTrack[c][0]->End()[0], (float) fProngTrack[c][1]->End()[0]};
+    fProngEndY[c] = {(float) fProngTrack[c][0]->End()[1], (float) fProngTrack[c][1]->End()[1]};
+    fProngEndZ[c] = {(float) fProngTrack[c][0]->End()[2], (float) fProngTrack[c][1]->End()[2]};
+
+    // Calculate length, theta, phi and number of hits
+    fProngLength[c] = {(float) fProngTrack[c][0]->Length(), (float) fProngTrack[c][1]->Length()};
+    fProngTheta[c] = {(float) fProngTrack[c][0]->Theta(), (float) fProngTrack[c][1]->Theta()};
+    fProngPhi[c] = {(float) fProngTrack[c][0]->Phi(), (float) fProngTrack[c][1]->Phi()};
+    fProngNumHits[c] = {(int) t1Hits.size(), (int) t2Hits.size()};
+
+    // Calculate track directions
+    fProngDirX[c] = {(float) fProngTrack[c][0]->VertexMomentumVector().X(), (float) fProngTrack[c][1]->VertexMomentumVector().X()};
+    fProngDirY[c] = {(float) fProngTrack[c][0]->VertexMomentumVector().Y(), (float) fProngTrack[c][1]->VertexMomentumVector().Y()};
+    fProngDirZ[c] = {(float) fProngTrack[c][0]->VertexMomentumVector().Z(), (float) fProngTrack[c][1]->VertexMomentumVector().Z()};
+
+    // Calculate opening angle
+    double startDirection1[3] = {
+      fProngTrack[c][0]->StartDirection().X(),
+      fProngTrack[c][0]->StartDirection().Y(),
+      fProngTrack[c][0]->StartDirection().Z()
+    };
+    double startDirection2[3] = {
+      fProngTrack[c][1]->StartDirection().X(),
+      fProngTrack[c][1]->StartDirection().Y(),
+      fProngTrack[c][1]->StartDirection().Z()
+    };
+    float magnitude1 = sqrt(startDirection1[0]*startDirection1[0] + startDirection1[1]*startDirection1[1] + startDirection1[2]*startDirection1[2]);
+    float magnitude2 = sqrt(startDirection2[0]*startDirection2[0] + startDirection2[1]*startDirection2[1] + startDirection2[2]*startDirection2[2]);
+    float dotProduct = startDirection1[0]*startDirection2[0] + startDirection1[1]*startDirection2[1] + startDirection1[2]*startDirection2[2];
+    fOpeningAngle[c] = acos(dotProduct / (magnitude1*magnitude2));
+    // Calculate start point to neutrino vertex distance
+    float prong1_distance = sqrt(pow(fX[c] - fProngX[c][0],2.) + pow(fY[c] - fProngY[c][0],2.) + pow(fZ[c] - fProngZ[c][0],2.));
+    float prong2_distance = sqrt(pow(fX[c] - fProngX[c][1],2.) + pow(fY[c] - fProngY[c][1],2.) + pow(fZ[c] - fProngZ[c][1],2.));
+    fProngStartToNeutrinoDistance[c] = {prong1_distance,prong2_distance};
+
+    // Calculate momenta and quantities related to them, using range and MCS method
+    SetHypothesisLabels(c);
+    SetMomentumQuantities_ByRange(c);
+    SetMomentumQuantities_ByMCS(c);
+    return c;
+  } //  END function AddCandidate
+
+  // Getters
+  // Pointers
+  art::Ptr<recob::Vertex> CandidateBatch::GetNuVertex(size_t c) const {return fNuVertex[c];}
+  art::Ptr<recob::Vertex> CandidateBatch::GetProngVertex(size_t c, int prong) const {return fProngVertex[c][prong];}
+  art::Ptr<recob::Track> CandidateBatch::GetProngTrack(size_t c, int prong) const {return fProngTrack[c][prong];}
+  AuxEvent::HitView CandidateBatch::GetProngHits(size_t c, int prong) const {return fHitPool ? fHitPool->GetView(fProngHits[c][prong]) : AuxEvent::HitView();}
+  AuxEvent::HitView CandidateBatch::GetTotHits(size_t c) const {return fHitPool ? fHitPool->GetView(fTotHitsInMaxRadius[c]) : AuxEvent::HitView();}
+
+  // Setters
+  void CandidateBatch::SetChannelLoc(size_t c, int channel0, int channel1, int channel2) {fChannelLoc[c] = {channel0,channel1,channel2}; return;}
+  void CandidateBatch::SetTickLoc(size_t c, float tick0, float tick1, float tick2) {fTickLoc[c] = {tick0, tick1, tick2}; return;}
+  void CandidateBatch::SetProngChannelLoc(size_t c, int prong, int channel0, int channel1, int channel2) {fProngChannelLoc[c][prong] =  {channel0,channel1,channel2}; return;}
+  void CandidateBatch::SetProngTickLoc(size_t c, int prong, float tick0, float tick1, float tick2) {fProngTickLoc[c][prong] = {tick0, tick1, tick2}; return;}
+  void CandidateBatch::SetProngXYZ(size_t c, int prong, float x, float y, float z) {fProngX[c][prong] = x; fProngY[c][prong] = y; fProngZ[c][prong] = z; return;}
+  void CandidateBatch::SetIsInsideTPC(size_t c, bool val) {fIsInsideTPC[c] = val; return;}
+  void CandidateBatch::SetIsDetLocAssigned(size_t c, bool val) {fIsDetLocAssigned[c] = val; return;}
+  void CandidateBatch::SetTotHits(size_t c, const AuxEvent::HitRange &totHitsInMaxRadius) {fTotHitsInMaxRadius[c] = totHitsInMaxRadius; return;}
+
+  void CandidateBatch::SetDetectorCoordinates(
+    size_t c,
+    const std::vector<double>& minTpcBound,
+    const std::vector<double>& maxTpcBound,
+    const AuxEvent::ProjectionCache & projection)
+  {
+    /* Translate the x,y,z coordinates of the vertex and of the two prong vertices in wire,tick coordinates.
+    This allows the determination of the vertices location in the event display.
+    The three points are converted together by the per-run projection cache.
+    */
+
+    // Get spatial coordinates (neutrino, prong1, prong2) and mark vertex as assigned
+    const float x[3] = {fX[c],fProngX[c][0],fProngX[c][1]};
+    const float y[3] = {fY[c],fProngY[c][0],fProngY[c][1]};
+    const float z[3] = {fZ[c],fProngZ[c][0],fProngZ[c][1]};
+
+    fIsDetLocAssigned[c] = true;
+
+    // Check whether coordinates are inside TPC
+    double extraEdge = 0;
+    bool allInside = true;
+    for (int i=0; i!=3; i++)
+    {
+      bool isInsideX = (x[i]>minTpcBound[0]+extraEdge &&
+        x[i]<maxTpcBound[0]-extraEdge);
+      bool isInsideY = (y[i]>minTpcBound[1]+extraEdge &&
+        y[i]<maxTpcBound[1]-extraEdge);
+      bool isInsideZ = (z[i]>minTpcBound[2]+extraEdge &&
+        z[i]<maxTpcBound[2]-extraEdge);
+      allInside = allInside && isInsideX && isInsideY && isInsideZ;
+    }
+
+    // If vertex is inside TPC, determine channel/tick coordinates and assign them
+    if (allInside)
+    {
+      fIsInsideTPC[c] = true;
+      Planes<int> channels[3];
+      Planes<float> ticks[3];
+      projection.ProjectPoints(x, y, z, 3, channels, ticks);
+      fChannelLoc[c] = channels[0];
+      fTickLoc[c] = ticks[0];
+      fProngChannelLoc[c] = {{channels[1], channels[2]}};
+      fProngTickLoc[c] = {{ticks[1], ticks[2]}};
+      return;
+    }
+
+    // Else flag it as outside the TPC and exit function
+    else
+      {
+        fIsInsideTPC[c] = false;
+        return;
+      }
+  } // END function SetDetectorCoordinates
+
+
+  void CandidateBatch::SetHypothesisLabels(size_t c)
+  {
+    /* Determine PDG code and mass for the two particles in every hypothesis of kMassHypotheses.
+    Each hypothesis assigns a particle to the longest and one to the shortest track, e.g.
+    h1: Longest track is muon (13), shortest is pion (211)
+    h2: Longest track is pion (211), shortest is muon (13)
+    */
+    int longTrackInd = (fProngLength[c][0]>=fProngLength[c][1]) ? 0 : 1;
+    SetHypothesisMasses(longTrackInd, fProngPdgCode[c], fProngMass[c]);
+  } // END function SetHypothesisLabels
+
+
+  // Internal setters
+  void CandidateBatch::SetMomentumQuantities_ByRange(size_t c)
+  {
+    /* Use internal attributes (like prong lengths and position) for the decay vertex to determine prong momenta and quantities determined from them (total momentum, energy, invariant mass, etc.).
+    Momenta in this case are determined by range, for every hypothesis.
+
+    The momentum of each prong is read from the range table of the particle assigned to it by the hypothesis.
+    */
+    if (!fRangeTable)
+    {
+      throw cet::exception("CandidateBatch") << "Range momentum requested without a range table.\n";
+    }
+    HypothesisKinematics & kin = fKinematics_ByRange[c];
+    for (size_t h=0; h!=kNumHypotheses; h++)
+    {
+      for (size_t p=0; p!=2; p++)
+      {
+        RangeSpecies species = RangeMomentumTable::SpeciesFromPdg(fProngPdgCode[c][h][p]);
+        kin.prongMomMag[h][p] = fRangeTable->GetMomentum(species, fProngLength[c][p]);
+      }
+    }
+    ComputeHypothesisKinematics(fProngMass[c], fProngDirX[c], fProngDirY[c], fProngDirZ[c], kin);
+    return;
+  } // END function SetMomentumQuatities_ByRange
+
+
+  void CandidateBatch::SetMomentumQuantities_ByMCS(size_t c)
+  {
+    /* Use internal attributes (like prong lengths and position) for the decay vertex to determine prong momenta and quantities determined from them (total momentum, energy, invariant mass, etc.).
+    Momenta in this case are determined by Multiple Coulomb Scattering, for every hypothesis. Two fits are used.
+    fwd: Forward fit is used for momentum
+    best: Best fit between forward and backward is used for particle momentum
+    */
+    fProngPdgCodeHypothesis_ByMcs[c] = {{fProngMcs[c][0]->particleIdHyp(),fProngMcs[c][1]->particleIdHyp()}};
+    fProngIsBestFwd_ByMcs[c] = {{fProngMcs[c][0]->isBestFwd(),fProngMcs[c][1]->isBestFwd()}};
+
+    // Prong momentum magnitude (the MCS fit momentum is used as is for every hypothesis)
+    HypothesisKinematics & fwd = fKinematics_ByMcs_fwd[c];
+    HypothesisKinematics & best = fKinematics_ByMcs_best[c];
+    for (size_t h=0; h!=kNumHypotheses; h++)
+    {
+      for (size_t p=0; p!=2; p++)
+      {
+        fwd.prongMomMag[h][p] = fProngMcs[c][p]->fwdMomentum();
+        best.prongMomMag[h][p] = fProngMcs[c][p]->bestMomentum();
+      }
+    }
+    ComputeHypothesisKinematics(fProngMass[c], fProngDirX[c], fProngDirY[c], fProngDirZ[c], fwd);
+    ComputeHypothesisKinematics(fProngMass[c], fProngDirX[c], fProngDirY[c], fProngDirZ[c], best);
+    return;
+  } // END function SetMomentumQuantities_ByMCS
+
+
+
+
+  // Printers
+  void CandidateBatch::PrintInformation(size_t c, const HsnLog::Logger & log) const
+  {
+    // One message for the whole block, nothing is formatted below the Debug level
+    if (HsnLog::kDebug < HSN_LOG_MIN_LEVEL || !log.IsEnabled(HsnLog::kDebug)) return;
+    int fStartWire[3] = {0,2399,4798};
+    std::string text = "\n-|Vertex information|\n";
+    text += HsnLog::Format("|_Vertex inside TPC: %d\n", (int) fIsInsideTPC[c]);
+    text += HsnLog::Format("|_Spatial Coordinates: [%.1f, %.1f, %.1f]\n",fX[c],fY[c],fZ[c]);
+    text += HsnLog::Format("|_Prongs lengths: [%.1f,%.1f]\n", fProngLength[c][0], fProngLength[c][1]);
+    text += HsnLog::Format("|_Prongs theta: [%.1f,%.1f]\n", fProngTheta[c][0], fProngTheta[c][1]);
+    text += HsnLog::Format("|_Prongs phi: [%.1f,%.1f]\n", fProngPhi[c][0], fProngPhi[c][1]);
+    text += HsnLog::Format("|_Prongs hit number: [%i,%i]\n", fProngNumHits[c][0], fProngNumHits[c][1]);
+    text += HsnLog::Format("|_Detector location assigned: %d\n", (int) fIsDetLocAssigned[c]);
+    if (fIsDetLocAssigned[c])
+    {
+      text += HsnLog::Format("|_Channel coordinates: [%i, %i, %i]\n",fChannelLoc[c][0]-fStartWire[0],fChannelLoc[c][1]-fStartWire[1],fChannelLoc[c][2]-fStartWire[2]);
+      text += HsnLog::Format("|_Ticks coordinates: [%.1f, %.1f, %.1f]\n",fTickLoc[c][0],fTickLoc[c][1],fTickLoc[c][2]);
+    }
+    HSN_DEBUG(log, "Candidate", "%s", text.c_str());
+    return;
+  }
+
+} // END namespace AuxVertex
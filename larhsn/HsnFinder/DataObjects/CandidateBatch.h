@@ -0,0 +1,154 @@
+/******************************************************************************
+ * @file CandidateBatch.h
+ * @brief Struct-of-arrays storage for all the HSN decay vertex candidates of an event
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateBatch.cxx
+ * ****************************************************************************/
+
+#ifndef CANDIDATEBATCH_H
+#define CANDIDATEBATCH_H
+
+#include <iostream>
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string>
+#include <array>
+#include <vector>
+#include <stdexcept>
+#include "canvas/Persistency/Common/Ptr.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Vertex.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/MCSFitResult.h"
+#include "larcorealg/Geometry/geo.h"
+#include "larcore/Geometry/Geometry.h"
+#include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom<>()
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+#include "larhsn/HsnFinder/DataObjects/HitPool.h"
+#include "larhsn/HsnFinder/DataObjects/MassHypotheses.h"
+#include "larhsn/HsnFinder/DataObjects/ProjectionCache.h"
+#include "larhsn/HsnFinder/DataObjects/RangeMomentumTable.h"
+#include "larhsn/Logging/HsnLog.h"
+
+namespace AuxVertex
+{
+  // CandidateBatch class and functions
+  // Each member is a column with one entry per candidate. Candidates are addressed by their index in the batch (the hsnID).
+  // Columns only grow when the batch grows beyond its previous size, so a batch reused across events stops allocating once it has seen its largest event.
+  class CandidateBatch
+  {
+  public:
+    // Constructor and destructor
+    CandidateBatch();
+    virtual ~CandidateBatch();
+
+    // Batch handling
+    void Clear();
+    void Reserve(size_t n);
+    size_t Size() const;
+    size_t AddEmptyCandidate(); // Append a candidate with default values, return its index.
+    void PopBack(); // Remove the last candidate.
+    void SetHitPool(const AuxEvent::HitPool* hitPool);
+    void SetRangeTable(const AuxVertex::RangeMomentumTable* rangeTable);
+
+    // Append a HSN decay vertex candidate built from a neutrino with two (and only two) track daughters and calculate its quantities
+    size_t AddCandidate(
+            const art::Ptr<recob::Vertex> &nuVertex,
+            const art::Ptr<recob::Vertex> &t1Vertex,
+            const art::Ptr<recob::Vertex> &t2Vertex,
+            const art::Ptr<recob::Track> &t1Track,
+            const art::Ptr<recob::Track> &t2Track,
+            const AuxEvent::HitRange &t1Hits,
+            const AuxEvent::HitRange &t2Hits,
+            const art::Ptr<recob::MCSFitResult> &t1Mcs,
+            const art::Ptr<recob::MCSFitResult> &t2Mcs);
+
+    // Getters
+    art::Ptr<recob::Vertex> GetNuVertex(size_t c) const;
+    art::Ptr<recob::Vertex> GetProngVertex(size_t c, int prong) const;
+    art::Ptr<recob::Track> GetProngTrack(size_t c, int prong) const;
+    // Views over the hits in the event hit pool (no copy, valid while the pool is not modified)
+    AuxEvent::HitView GetProngHits(size_t c, int prong) const;
+    AuxEvent::HitView GetTotHits(size_t c) const;
+
+    // Setters
+    void SetDetectorCoordinates(
+      size_t c,
+      const std::vector<double>& minTpcBound,
+      const std::vector<double>& maxTpcBound,
+      const AuxEvent::ProjectionCache & projection);
+    void SetChannelLoc(size_t c, int channel0, int channel1, int channel2);
+    void SetTickLoc(size_t c, float tick0, float tick1, float tick2);
+    void SetProngChannelLoc(size_t c, int prong, int channel0, int channel1, int channel2);
+    void SetProngTickLoc(size_t c, int prong, float tick0, float tick1, float tick2);
+    void SetProngXYZ(size_t c, int prong, float x, float y, float z);
+    void SetIsInsideTPC(size_t c, bool val);
+    void SetIsDetLocAssigned(size_t c, bool val);
+    void SetTotHits(size_t c, const AuxEvent::HitRange &totHitsInMaxRadius);
+    void SetHypothesisLabels(size_t c);
+    void SetMomentumQuantities_ByRange(size_t c);
+    void SetMomentumQuantities_ByMCS(size_t c);
+
+    // Printers
+    void PrintInformation(size_t c, const HsnLog::Logger & log) const; // Debug level
+
+    // Data products pointers
+    const AuxEvent::HitPool* fHitPool; // Per-event hit pool owning the hit indices below.
+    const AuxVertex::RangeMomentumTable* fRangeTable; // Job-wide range to momentum tables.
+    std::vector<art::Ptr<recob::Vertex>> fNuVertex;
+    std::vector<Prongs<art::Ptr<recob::Vertex>>> fProngVertex;
+    std::vector<Prongs<art::Ptr<recob::Track>>> fProngTrack;
+    std::vector<Prongs<art::Ptr<recob::MCSFitResult>>> fProngMcs;
+    std::vector<Prongs<AuxEvent::HitRange>> fProngHits;
+    std::vector<AuxEvent::HitRange> fTotHitsInMaxRadius;
+
+    // Coordinates of the pandora neutrino recob::Vertex object
+    std::vector<float> fX, fY, fZ; // Spatial coordinates of the vertex inside the detector.
+    std::vector<Planes<int>> fChannelLoc; // Nearest channel in each plane.
+    std::vector<Planes<float>> fTickLoc; // Nearest time tick in each plane.
+    /**/
+    // Coordinates of the two prongs recob::Vertex objects
+    std::vector<Prongs<float>> fProngX, fProngY, fProngZ; // Spatial coordinates of the vertex of the track inside the detector.
+    std::vector<Prongs<Planes<int>>> fProngChannelLoc; // Nearest channel in each plane for the vertex parent.
+    std::vector<Prongs<Planes<float>>> fProngTickLoc; // Nearest time tick in each plane for the vertex parent.
+    /**/
+    // Coordinates of the two prongs start and end points for the recob::Track objects
+    std::vector<Prongs<float>> fProngStartX, fProngStartY, fProngStartZ; // Spatial coordinates for the start of the track.
+    std::vector<Prongs<float>> fProngEndX, fProngEndY, fProngEndZ; // Spatial coordinates for the end of the track.
+
+    // Track direction (no calorimetry data)
+    std::vector<Prongs<float>> fProngDirX, fProngDirY, fProngDirZ; // Direction of momentum for each track.
+    std::vector<Prongs<float>> fProngTheta, fProngPhi; // Direction angles of each prong.
+
+    // Pdg code and mass of each prong for every hypothesis in kMassHypotheses
+    std::vector<Hypotheses<Prongs<int>>> fProngPdgCode;
+    std::vector<Hypotheses<Prongs<float>>> fProngMass;
+
+    // Momentum information for every hypothesis (measured by range, by MCS with forward fit and by MCS with best fit)
+    std::vector<HypothesisKinematics> fKinematics_ByRange;
+    std::vector<HypothesisKinematics> fKinematics_ByMcs_fwd, fKinematics_ByMcs_best;
+    std::vector<Prongs<int>> fProngPdgCodeHypothesis_ByMcs;
+    std::vector<Prongs<bool>> fProngIsBestFwd_ByMcs;
+
+    // Other variables
+    std::vector<Prongs<float>> fProngLength; // Length of each prong
+    std::vector<float> fOpeningAngle; // Opening angle between the two prongs
+    std::vector<Prongs<float>> fProngStartToNeutrinoDistance; // Distance from start point to neutrino vertex for each prong
+    std::vector<Prongs<int>> fProngNumHits; // Number of hits associated with each prong
+
+    // Status
+    std::vector<bool> fIsInsideTPC; // Whetehr the vertex is inside the TPC.
+    std::vector<bool> fIsDetLocAssigned; // Whether channel/tick coordinates have been determined.
+
+  private:
+    // Apply the same operation to every column of the batch
+    template <typename F> void ForEachColumn(F && f);
+    size_t fSize;
+  };
+
+} //END namespace AuxVertex
+
+#endif
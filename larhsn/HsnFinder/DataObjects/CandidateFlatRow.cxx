@@ -0,0 +1,142 @@
+/******************************************************************************
+ * @file CandidateFlatRow.cxx
+ * @brief Flat (schema v2) layout of a candidate data row: fixed-size per-prong arrays and narrowed types, no streamed vectors
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateFlatRow.h
+ * ****************************************************************************/
+
+#include "CandidateFlatRow.h"
+
+namespace
+{
+  // Element-wise copies from the streamed layout, missing values are -999
+  template <typename T, typename U, size_t N>
+  void Assign(std::array<T,N> & dst, const std::vector<U> & src)
+  {
+    for (size_t i=0; i!=N; i++) dst[i] = (i < src.size()) ? T(src[i]) : T(-999);
+    return;
+  }
+  template <typename T, typename U, size_t N, size_t H>
+  void Assign(std::array<std::array<T,N>,H> & dst, const std::array<std::vector<U>,H> & src)
+  {
+    for (size_t h=0; h!=H; h++) Assign(dst[h], src[h]);
+    return;
+  }
+  void Assign(std::vector<float> & dst, const std::vector<float> & src)
+  {
+    // Keeps the length of dst, its data is bound to the branches
+    for (size_t i=0; i!=dst.size(); i++) dst[i] = (i < src.size()) ? src[i] : -999.;
+    return;
+  }
+}
+
+namespace AuxEvent
+{
+  CandidateFlatRow::CandidateFlatRow()
+  {}
+  CandidateFlatRow::~CandidateFlatRow()
+  {}
+
+  void CandidateFlatRow::SetNumRadii(size_t nRadii)
+  {
+    calo_totChargeInRadius.assign(nRadii, -999.);
+    calo_prong1ChargeInRadius.assign(nRadii, -999.);
+    calo_prong2ChargeInRadius.assign(nRadii, -999.);
+    calo_caloRatio.assign(nRadii, -999.);
+    return;
+  } // END function SetNumRadii
+
+  size_t CandidateFlatRow::NumRadii() const {return calo_totChargeInRadius.size();}
+
+  void CandidateFlatRow::Set(const CandidateTreeFiller & ctf)
+  {
+    // General
+    run = ctf.run;
+    subrun = ctf.subrun;
+    event = ctf.event;
+    hsnID = ctf.hsnID;
+    nHsnCandidatesInSameEvent = ctf.nHsnCandidatesInSameEvent;
+    // Cheat reco-truth
+    recoTruthDistance = ctf.recoTruthDistance;
+    isClosestToTruth = ctf.isClosestToTruth;
+    Assign(truthCoordinates, ctf.truthCoordinates);
+    // Coordinates
+    geo_nuPosX = ctf.geo_nuPosX;
+    geo_nuPosY = ctf.geo_nuPosY;
+    geo_nuPosZ = ctf.geo_nuPosZ;
+    Assign(geo_prongPosX, ctf.geo_prongPosX);
+    Assign(geo_prongPosY, ctf.geo_prongPosY);
+    Assign(geo_prongPosZ, ctf.geo_prongPosZ);
+    Assign(geo_prongStartPosX, ctf.geo_prongStartPosX);
+    Assign(geo_prongStartPosY, ctf.geo_prongStartPosY);
+    Assign(geo_prongStartPosZ, ctf.geo_prongStartPosZ);
+    Assign(geo_prongEndPosX, ctf.geo_prongEndPosX);
+    Assign(geo_prongEndPosY, ctf.geo_prongEndPosY);
+    Assign(geo_prongEndPosZ, ctf.geo_prongEndPosZ);
+    Assign(geo_prongLength, ctf.geo_prongLength);
+    geo_openingAngle = ctf.geo_openingAngle;
+    // Direction
+    Assign(geo_prongDirX, ctf.geo_prongDirX);
+    Assign(geo_prongDirY, ctf.geo_prongDirY);
+    Assign(geo_prongDirZ, ctf.geo_prongDirZ);
+    Assign(geo_prongTheta, ctf.geo_prongTheta);
+    Assign(geo_prongPhi, ctf.geo_prongPhi);
+    // Hypothesis information and prong momenta
+    Assign(hypo_prongPdgCode, ctf.hypo_prongPdgCode);
+    Assign(hypo_prongMass, ctf.hypo_prongMass);
+    Assign(range_prongMomMag, ctf.range_prongMomMag);
+    Assign(range_prongEnergy, ctf.range_prongEnergy);
+    Assign(range_prongMom_X, ctf.range_prongMom_X);
+    Assign(range_prongMom_Y, ctf.range_prongMom_Y);
+    Assign(range_prongMom_Z, ctf.range_prongMom_Z);
+    Assign(mcs_prongMomMag_best, ctf.mcs_prongMomMag_best);
+    Assign(mcs_prongEnergy_best, ctf.mcs_prongEnergy_best);
+    Assign(mcs_prongMom_best_X, ctf.mcs_prongMom_best_X);
+    Assign(mcs_prongMom_best_Y, ctf.mcs_prongMom_best_Y);
+    Assign(mcs_prongMom_best_Z, ctf.mcs_prongMom_best_Z);
+    // Totals (same layout in both schemas)
+    range_totMomMag = ctf.range_totMomMag;
+    range_totEnergy = ctf.range_totEnergy;
+    range_invariantMass = ctf.range_invariantMass;
+    range_totMom_X = ctf.range_totMom_X;
+    range_totMom_Y = ctf.range_totMom_Y;
+    range_totMom_Z = ctf.range_totMom_Z;
+    range_totTheta = ctf.range_totTheta;
+    range_totPhi = ctf.range_totPhi;
+    range_totDir_X = ctf.range_totDir_X;
+    range_totDir_Y = ctf.range_totDir_Y;
+    range_totDir_Z = ctf.range_totDir_Z;
+    mcs_totMomMag_best = ctf.mcs_totMomMag_best;
+    mcs_totEnergy_best = ctf.mcs_totEnergy_best;
+    mcs_invariantMass_best = ctf.mcs_invariantMass_best;
+    mcs_totMom_best_X = ctf.mcs_totMom_best_X;
+    mcs_totMom_best_Y = ctf.mcs_totMom_best_Y;
+    mcs_totMom_best_Z = ctf.mcs_totMom_best_Z;
+    mcs_totTheta_best = ctf.mcs_totTheta_best;
+    mcs_totPhi_best = ctf.mcs_totPhi_best;
+    mcs_totDir_best_X = ctf.mcs_totDir_best_X;
+    mcs_totDir_best_Y = ctf.mcs_totDir_best_Y;
+    mcs_totDir_best_Z = ctf.mcs_totDir_best_Z;
+    // MCS variables
+    Assign(mcs_prongPdgCodeHypothesis, ctf.mcs_prongPdgCodeHypothesis);
+    Assign(mcs_prongIsBestFwd, ctf.mcs_prongIsBestFwd);
+    // Extra
+    Assign(prongStartToNeutrinoDistance, ctf.prongStartToNeutrinoDistance);
+    Assign(prongNumHits, ctf.prongNumHits);
+    maxEndPointX = ctf.maxEndPointX;
+    maxEndPointY = ctf.maxEndPointY;
+    maxEndPointZ = ctf.maxEndPointZ;
+    deltaPhi = ctf.deltaPhi;
+    deltaTheta = ctf.deltaTheta;
+    maxStartToNeutrinoDistance = ctf.maxStartToNeutrinoDistance;
+    lengthDiff = ctf.lengthDiff;
+    lengthRatio = ctf.lengthRatio;
+    // Calorimetry
+    Assign(calo_totChargeInRadius, ctf.calo_totChargeInRadius);
+    Assign(calo_prong1ChargeInRadius, ctf.calo_prong1ChargeInRadius);
+    Assign(calo_prong2ChargeInRadius, ctf.calo_prong2ChargeInRadius);
+    Assign(calo_caloRatio, ctf.calo_caloRatio);
+    return;
+  } // END function Set
+
+} // END namespace AuxEvent
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * @file CandidateFlatRow.h
+ * @brief Flat (schema v2) layout of a candidate data row: fixed-size per-prong arrays and narrowed types, no streamed vectors
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateFlatRow.cxx CandidateTreeFiller.h
+ * ****************************************************************************/
+
+#ifndef CANDIDATEFLATROW_H
+#define CANDIDATEFLATROW_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <array>
+#include <string>
+#include <vector>
+#include "larhsn/HsnFinder/DataObjects/MassHypotheses.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateTreeFiller.h"
+
+namespace AuxEvent
+{
+
+  // Candidate data schema versions
+  // 1: CandidateTreeFiller layout, with a std::vector branch for every per-prong quantity
+  // 2: CandidateFlatRow layout, with plain leaves only
+  constexpr int kCandidateSchemaStreamed = 1;
+  constexpr int kCandidateSchemaFlat = 2;
+
+  // CandidateFlatRow class and functions
+  // Same columns, with the same names, as CandidateTreeFiller. Per-prong quantities are [2] leaves and the radius profiles are [nRadii] leaves,
+  // so reading an entry copies plain numbers instead of running a vector streamer and allocating. PDG codes and counters are shorts.
+  class CandidateFlatRow
+  {
+  public:
+    // Constructor and destructor
+    CandidateFlatRow();
+    virtual ~CandidateFlatRow();
+
+    // Fix the length of the radius profiles, before the row is bound to a tree
+    void SetNumRadii(size_t nRadii);
+    size_t NumRadii() const;
+    // Copy a row of the streamed layout. Profiles longer than the fixed length are cut, shorter ones are padded with -999.
+    void Set(const CandidateTreeFiller & ctf);
+
+    // Output columns, see BindCandidateColumns
+    template <typename Binder> void BindFields(Binder & bind, bool withTruthDistance);
+
+    // General
+    int run;
+    int subrun;
+    int event;
+    short hsnID;
+    short nHsnCandidatesInSameEvent;
+    // Cheat reco-truth
+    float recoTruthDistance;
+    bool isClosestToTruth;
+    std::array<float,3> truthCoordinates;
+    // Coordinates
+    float geo_nuPosX, geo_nuPosY, geo_nuPosZ;
+    AuxVertex::Prongs<float> geo_prongPosX, geo_prongPosY, geo_prongPosZ;
+    AuxVertex::Prongs<float> geo_prongStartPosX, geo_prongStartPosY, geo_prongStartPosZ;
+    AuxVertex::Prongs<float> geo_prongEndPosX, geo_prongEndPosY, geo_prongEndPosZ;
+    AuxVertex::Prongs<float> geo_prongLength;
+    float geo_openingAngle;
+    // Direction
+    AuxVertex::Prongs<float> geo_prongDirX, geo_prongDirY, geo_prongDirZ;
+    AuxVertex::Prongs<float> geo_prongTheta, geo_prongPhi;
+    // Hypothesis information
+    AuxVertex::Hypotheses<AuxVertex::Prongs<short>> hypo_prongPdgCode;
+    AuxVertex::Hypotheses<AuxVertex::Prongs<float>> hypo_prongMass;
+    // Prong momentum (by range)
+    AuxVertex::Hypotheses<AuxVertex::Prongs<float>> range_prongMomMag, range_prongEnergy;
+    AuxVertex::Hypotheses<AuxVertex::Prongs<float>> range_prongMom_X, range_prongMom_Y, range_prongMom_Z;
+    // Tot momentum (by range)
+    AuxVertex::Hypotheses<float> range_totMomMag, range_totEnergy, range_invariantMass;
+    AuxVertex::Hypotheses<float> range_totMom_X, range_totMom_Y, range_totMom_Z;
+    AuxVertex::Hypotheses<float> range_totTheta, range_totPhi;
+    AuxVertex::Hypotheses<float> range_totDir_X, range_totDir_Y, range_totDir_Z;
+    // MCS variables
+    AuxVertex::Prongs<short> mcs_prongPdgCodeHypothesis;
+    AuxVertex::Prongs<bool> mcs_prongIsBestFwd;
+    // Prong Momentum (By MCS, best)
+    AuxVertex::Hypotheses<AuxVertex::Prongs<float>> mcs_prongMomMag_best, mcs_prongEnergy_best;
+    AuxVertex::Hypotheses<AuxVertex::Prongs<float>> mcs_prongMom_best_X, mcs_prongMom_best_Y, mcs_prongMom_best_Z;
+    // Tot momentum (by MCS, best)
+    AuxVertex::Hypotheses<float> mcs_totMomMag_best, mcs_totEnergy_best, mcs_invariantMass_best;
+    AuxVertex::Hypotheses<float> mcs_totMom_best_X, mcs_totMom_best_Y, mcs_totMom_best_Z;
+    AuxVertex::Hypotheses<float> mcs_totTheta_best, mcs_totPhi_best;
+    AuxVertex::Hypotheses<float> mcs_totDir_best_X, mcs_totDir_best_Y, mcs_totDir_best_Z;
+    // Extra
+    AuxVertex::Prongs<float> prongStartToNeutrinoDistance;
+    AuxVertex::Prongs<int> prongNumHits;
+    float maxEndPointX, maxEndPointY, maxEndPointZ;
+    float deltaPhi, deltaTheta;
+    float maxStartToNeutrinoDistance;
+    float lengthDiff, lengthRatio;
+    // Pandora calo (fixed length, see SetNumRadii)
+    std::vector<float> calo_totChargeInRadius;
+    std::vector<float> calo_prong1ChargeInRadius;
+    std::vector<float> calo_prong2ChargeInRadius;
+    std::vector<float> calo_caloRatio;
+  };
+
+  template <typename Binder>
+  void CandidateFlatRow::BindFields(Binder & bind, bool withTruthDistance)
+  {
+    BindCandidateColumns(*this, bind, withTruthDistance);
+    return;
+  } // END function BindFields
+
+} //END namespace AuxEvent
+
+#endif
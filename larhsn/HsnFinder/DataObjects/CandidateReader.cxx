@@ -0,0 +1,81 @@
+/******************************************************************************
+ * @file CandidateReader.cxx
+ * @brief Reader of the candidate data of an HsnFinder output, with either schema version
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateReader.h
+ * ****************************************************************************/
+
+#include "CandidateReader.h"
+
+namespace AuxEvent
+{
+  CandidateReader::CandidateReader(TDirectory & directory) :
+    fTree(nullptr),
+    fSchemaVersion(kCandidateSchemaStreamed),
+    fHasTruthDistance(false)
+  {
+    directory.GetObject("CandidateData", fTree);
+    if (!fTree) throw cet::exception("CandidateReader") << "No CandidateData tree in directory " << directory.GetName() << ".\n";
+    fHasTruthDistance = (fTree->GetBranch("recoTruthDistance") != nullptr);
+
+    // Schema version and profile length from the job configuration
+    TTree* metaTree = nullptr;
+    directory.GetObject("MetaData", metaTree);
+    int nRadii = 0;
+    if (metaTree)
+    {
+      if (metaTree->GetBranch("candidateSchemaVersion")) metaTree->SetBranchAddress("candidateSchemaVersion", &fSchemaVersion);
+      if (metaTree->GetBranch("radiusProfileBins")) metaTree->SetBranchAddress("radiusProfileBins", &nRadii);
+      metaTree->GetEntry(0);
+      metaTree->ResetBranchAddresses();
+    }
+
+    if (fSchemaVersion == kCandidateSchemaFlat)
+    {
+      // The profile lengths come from the leaves
+      FlatAddressBinder binder(fTree);
+      fRow.BindFields(binder, fHasTruthDistance);
+    }
+    else if (fSchemaVersion == kCandidateSchemaStreamed)
+    {
+      TreeAddressBinder binder(fTree);
+      fFiller.BindFields(binder, fHasTruthDistance);
+      fRow.SetNumRadii(nRadii);
+    }
+    else throw cet::exception("CandidateReader") << "Unknown candidate schema version " << fSchemaVersion << ".\n";
+  } // END constructor CandidateReader
+
+  CandidateReader::~CandidateReader()
+  {
+    fTree->ResetBranchAddresses();
+  } // END destructor CandidateReader
+
+  long long CandidateReader::GetEntries() const {return fTree->GetEntries();}
+
+  const CandidateFlatRow & CandidateReader::GetEntry(long long entry)
+  {
+    fTree->GetEntry(entry);
+    if (fSchemaVersion == kCandidateSchemaStreamed) fRow.Set(fFiller);
+    return fRow;
+  } // END function GetEntry
+
+  void CandidateReader::SelectColumns(const std::string & prefixes)
+  {
+    fTree->SetBranchStatus("*", false);
+    size_t begin = 0;
+    while (begin <= prefixes.size())
+    {
+      size_t end = prefixes.find(',', begin);
+      if (end == std::string::npos) end = prefixes.size();
+      if (end > begin) fTree->SetBranchStatus((prefixes.substr(begin, end-begin)+"*").c_str(), true);
+      begin = end+1;
+    }
+    return;
+  } // END function SelectColumns
+
+  // Getters
+  int CandidateReader::GetSchemaVersion() const {return fSchemaVersion;}
+  bool CandidateReader::HasTruthDistance() const {return fHasTruthDistance;}
+  TTree* CandidateReader::GetTree() const {return fTree;}
+
+} // END namespace AuxEvent
@@ -0,0 +1,55 @@
+/******************************************************************************
+ * @file CandidateReader.h
+ * @brief Reader of the candidate data of an HsnFinder output, with either schema version
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateReader.cxx CandidateFlatRow.h
+ * ****************************************************************************/
+
+#ifndef CANDIDATEREADER_H
+#define CANDIDATEREADER_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <string>
+#include "cetlib/exception.h"
+#include "TDirectory.h"
+#include "TTree.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateFlatRow.h"
+#include "larhsn/HsnFinder/DataObjects/FieldBinders.h"
+
+namespace AuxEvent
+{
+
+  // CandidateReader class and functions
+  // Opens CandidateData in the directory of an HsnFinder module and finds the schema version in MetaData (files without it are version 1).
+  // Every entry is returned as a CandidateFlatRow: version 2 files are read straight into it, version 1 files go through a CandidateTreeFiller.
+  // Analysis code reads the same named quantities from both, e.g. row.geo_prongLength[0] or row.calo_totChargeInRadius[j].
+  class CandidateReader
+  {
+  public:
+    // Constructor and destructor
+    explicit CandidateReader(TDirectory & directory);
+    virtual ~CandidateReader();
+
+    long long GetEntries() const;
+    const CandidateFlatRow & GetEntry(long long entry);
+    // Read only the columns whose name starts with one of the prefixes (comma separated, e.g. "run,event,calo_"), the others keep their last value
+    void SelectColumns(const std::string & prefixes);
+
+    // Getters
+    int GetSchemaVersion() const;
+    bool HasTruthDistance() const;
+    TTree* GetTree() const;
+
+  private:
+    TTree* fTree;
+    int fSchemaVersion;
+    bool fHasTruthDistance;
+    CandidateTreeFiller fFiller; // Version 1 only
+    CandidateFlatRow fRow;
+  };
+
+} //END namespace AuxEvent
+
+#endif
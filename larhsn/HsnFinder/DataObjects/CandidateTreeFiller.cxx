@@ -15,7 +15,7 @@ namespace AuxEvent
   CandidateTreeFiller::~CandidateTreeFiller()
   {}
 
-  void CandidateTreeFiller::Initialize( AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::DecayVertex & dv, std::vector<double> centerCoordinates)
+  void CandidateTreeFiller::Initialize( AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::CandidateBatch & candidates, std::vector<double> centerCoordinates)
   {
     // General
     run = etf.run;
@@ -37,109 +37,78 @@ namespace AuxEvent
       isClosestToTruth = etf.isClosestToTruth[hsnID];
     }
     // Coordinates
-    geo_nuPosX = dv.fX;
-    geo_nuPosY = dv.fY;
-    geo_nuPosZ = dv.fZ;
-    geo_prongPosX = {dv.fProngX[0],dv.fProngX[1]};
-    geo_prongPosY = {dv.fProngY[0],dv.fProngY[1]};
-    geo_prongPosZ = {dv.fProngZ[0],dv.fProngZ[1]};
-    geo_prongStartPosX = {dv.fProngStartX[0],dv.fProngStartX[1]};
-    geo_prongStartPosY = {dv.fProngStartY[0],dv.fProngStartY[1]};
-    geo_prongStartPosZ = {dv.fProngStartZ[0],dv.fProngStartZ[1]};
-    geo_prongEndPosX = {dv.fProngEndX[0],dv.fProngEndX[1]};
-    geo_prongEndPosY = {dv.fProngEndY[0],dv.fProngEndY[1]};
-    geo_prongEndPosZ = {dv.fProngEndZ[0],dv.fProngEndZ[1]};
-    geo_prongLength = {dv.fProngLength[0],dv.fProngLength[1]};
-    geo_openingAngle = dv.fOpeningAngle;
+    geo_nuPosX = candidates.fX[hsnID];
+    geo_nuPosY = candidates.fY[hsnID];
+    geo_nuPosZ = candidates.fZ[hsnID];
+    geo_prongPosX = {candidates.fProngX[hsnID][0],candidates.fProngX[hsnID][1]};
+    geo_prongPosY = {candidates.fProngY[hsnID][0],candidates.fProngY[hsnID][1]};
+    geo_prongPosZ = {candidates.fProngZ[hsnID][0],candidates.fProngZ[hsnID][1]};
+    geo_prongStartPosX = {candidates.fProngStartX[hsnID][0],candidates.fProngStartX[hsnID][1]};
+    geo_prongStartPosY = {candidates.fProngStartY[hsnID][0],candidates.fProngStartY[hsnID][1]};
+    geo_prongStartPosZ = {candidates.fProngStartZ[hsnID][0],candidates.fProngStartZ[hsnID][1]};
+    geo_prongEndPosX = {candidates.fProngEndX[hsnID][0],candidates.fProngEndX[hsnID][1]};
+    geo_prongEndPosY = {candidates.fProngEndY[hsnID][0],candidates.fProngEndY[hsnID][1]};
+    geo_prongEndPosZ = {candidates.fProngEndZ[hsnID][0],candidates.fProngEndZ[hsnID][1]};
+    geo_prongLength = {candidates.fProngLength[hsnID][0],candidates.fProngLength[hsnID][1]};
+    geo_openingAngle = candidates.fOpeningAngle[hsnID];
     // Direction
-    geo_prongDirX = {dv.fProngDirX[0],dv.fProngDirX[1]};
-    geo_prongDirY = {dv.fProngDirY[0],dv.fProngDirY[1]};
-    geo_prongDirZ = {dv.fProngDirZ[0],dv.fProngDirZ[1]};
-    geo_prongTheta = {dv.fProngTheta[0],dv.fProngTheta[1]};
-    geo_prongPhi = {dv.fProngPhi[0],dv.fProngPhi[1]};
-    // Prong momentum (by range, assuming both muons)
-    hypo_prongPdgCode_h1 = {dv.fProngPdgCode_h1[0],dv.fProngPdgCode_h1[1]};
-    hypo_prongMass_h1 = {dv.fProngMass_h1[0],dv.fProngMass_h1[1]};
-    range_prongMomMag_h1 = {dv.fProngMomMag_ByRange_h1[0],dv.fProngMomMag_ByRange_h1[1]};
-    range_prongEnergy_h1 = {dv.fProngEnergy_ByRange_h1[0],dv.fProngEnergy_ByRange_h1[1]};
-    range_prongMom_h1_X = {dv.fProngMom_ByRange_h1_X[0],dv.fProngMom_ByRange_h1_X[1]};
-    range_prongMom_h1_Y = {dv.fProngMom_ByRange_h1_Y[0],dv.fProngMom_ByRange_h1_Y[1]};
-    range_prongMom_h1_Z = {dv.fProngMom_ByRange_h1_Z[0],dv.fProngMom_ByRange_h1_Z[1]};
-    //
-    hypo_prongPdgCode_h2 = {dv.fProngPdgCode_h2[0],dv.fProngPdgCode_h2[1]};
-    hypo_prongMass_h2 = {dv.fProngMass_h2[0],dv.fProngMass_h2[1]};
-    range_prongMomMag_h2 = {dv.fProngMomMag_ByRange_h2[0],dv.fProngMomMag_ByRange_h2[1]};
-    range_prongEnergy_h2 = {dv.fProngEnergy_ByRange_h2[0],dv.fProngEnergy_ByRange_h2[1]};
-    range_prongMom_h2_X = {dv.fProngMom_ByRange_h2_X[0],dv.fProngMom_ByRange_h2_X[1]};
-    range_prongMom_h2_Y = {dv.fProngMom_ByRange_h2_Y[0],dv.fProngMom_ByRange_h2_Y[1]};
-    range_prongMom_h2_Z = {dv.fProngMom_ByRange_h2_Z[0],dv.fProngMom_ByRange_h2_Z[1]};
-    // Tot momentum (by direction, assuming both muons)
-    range_totMomMag_h1 = dv.fTotMomMag_ByRange_h1;
-    range_totEnergy_h1 = dv.fTotEnergy_ByRange_h1;
-    range_invariantMass_h1 = dv.fInvMass_ByRange_h1;
-    range_totMom_h1_X = dv.fTotMom_ByRange_h1_X;
-    range_totMom_h1_Y = dv.fTotMom_ByRange_h1_Y;
-    range_totMom_h1_Z = dv.fTotMom_ByRange_h1_Z;
-    //
-    range_totMomMag_h2 = dv.fTotMomMag_ByRange_h2;
-    range_totEnergy_h2 = dv.fTotEnergy_ByRange_h2;
-    range_invariantMass_h2 = dv.fInvMass_ByRange_h2;
-    range_totMom_h2_X = dv.fTotMom_ByRange_h2_X;
-    range_totMom_h2_Y = dv.fTotMom_ByRange_h2_Y;
-    range_totMom_h2_Z = dv.fTotMom_ByRange_h2_Z;
-    // Tot momentum direction (by direction, assuming both muons)
-    range_totTheta_h1 = dv.fTotTheta_ByRange_h1;
-    range_totPhi_h1 = dv.fTotPhi_ByRange_h1;
-    range_totDir_h1_X = dv.fTotDir_ByRange_h1_X;
-    range_totDir_h1_Y = dv.fTotDir_ByRange_h1_Y;
-    range_totDir_h1_Z = dv.fTotDir_ByRange_h1_Z;
-    //
-    range_totTheta_h2 = dv.fTotTheta_ByRange_h2;
-    range_totPhi_h2 = dv.fTotPhi_ByRange_h2;
-    range_totDir_h2_X = dv.fTotDir_ByRange_h2_X;
-    range_totDir_h2_Y = dv.fTotDir_ByRange_h2_Y;
-    range_totDir_h2_Z = dv.fTotDir_ByRange_h2_Z;
+    geo_prongDirX = {candidates.fProngDirX[hsnID][0],candidates.fProngDirX[hsnID][1]};
+    geo_prongDirY = {candidates.fProngDirY[hsnID][0],candidates.fProngDirY[hsnID][1]};
+    geo_prongDirZ = {candidates.fProngDirZ[hsnID][0],candidates.fProngDirZ[hsnID][1]};
+    geo_prongTheta = {candidates.fProngTheta[hsnID][0],candidates.fProngTheta[hsnID][1]};
+    geo_prongPhi = {candidates.fProngPhi[hsnID][0],candidates.fProngPhi[hsnID][1]};
+    // Hypotheses, momentum and derived quantities (by range and by MCS, best fit), for every hypothesis
+    const AuxVertex::HypothesisKinematics & range = candidates.fKinematics_ByRange[hsnID];
+    const AuxVertex::HypothesisKinematics & mcs = candidates.fKinematics_ByMcs_best[hsnID];
+    for (size_t h=0; h!=AuxVertex::kNumHypotheses; h++)
+    {
+      hypo_prongPdgCode[h] = {candidates.fProngPdgCode[hsnID][h][0],candidates.fProngPdgCode[hsnID][h][1]};
+      hypo_prongMass[h] = {candidates.fProngMass[hsnID][h][0],candidates.fProngMass[hsnID][h][1]};
+      // Prong momentum (by range)
+      range_prongMomMag[h] = {range.prongMomMag[h][0],range.prongMomMag[h][1]};
+      range_prongEnergy[h] = {range.prongEnergy[h][0],range.prongEnergy[h][1]};
+      range_prongMom_X[h] = {range.prongMomX[h][0],range.prongMomX[h][1]};
+      range_prongMom_Y[h] = {range.prongMomY[h][0],range.prongMomY[h][1]};
+      range_prongMom_Z[h] = {range.prongMomZ[h][0],range.prongMomZ[h][1]};
+      // Tot momentum (by range)
+      range_totMomMag[h] = range.totMomMag[h];
+      range_totEnergy[h] = range.totEnergy[h];
+      range_invariantMass[h] = range.invMass[h];
+      range_totMom_X[h] = range.totMomX[h];
+      range_totMom_Y[h] = range.totMomY[h];
+      range_totMom_Z[h] = range.totMomZ[h];
+      // Tot momentum direction (by range)
+      range_totTheta[h] = range.totTheta[h];
+      range_totPhi[h] = range.totPhi[h];
+      range_totDir_X[h] = range.totDirX[h];
+      range_totDir_Y[h] = range.totDirY[h];
+      range_totDir_Z[h] = range.totDirZ[h];
+      // Prong Momentum (By Mcs, best)
+      mcs_prongMomMag_best[h] = {mcs.prongMomMag[h][0],mcs.prongMomMag[h][1]};
+      mcs_prongEnergy_best[h] = {mcs.prongEnergy[h][0],mcs.prongEnergy[h][1]};
+      mcs_prongMom_best_X[h] = {mcs.prongMomX[h][0],mcs.prongMomX[h][1]};
+      mcs_prongMom_best_Y[h] = {mcs.prongMomY[h][0],mcs.prongMomY[h][1]};
+      mcs_prongMom_best_Z[h] = {mcs.prongMomZ[h][0],mcs.prongMomZ[h][1]};
+      // Tot momentum (by MCS, best)
+      mcs_totMomMag_best[h] = mcs.totMomMag[h];
+      mcs_totEnergy_best[h] = mcs.totEnergy[h];
+      mcs_invariantMass_best[h] = mcs.invMass[h];
+      mcs_totMom_best_X[h] = mcs.totMomX[h];
+      mcs_totMom_best_Y[h] = mcs.totMomY[h];
+      mcs_totMom_best_Z[h] = mcs.totMomZ[h];
+      // Tot momentum direction (by MCS, best)
+      mcs_totTheta_best[h] = mcs.totTheta[h];
+      mcs_totPhi_best[h] = mcs.totPhi[h];
+      mcs_totDir_best_X[h] = mcs.totDirX[h];
+      mcs_totDir_best_Y[h] = mcs.totDirY[h];
+      mcs_totDir_best_Z[h] = mcs.totDirZ[h];
+    }
     // Momentum (By Mcs)
-    mcs_prongPdgCodeHypothesis = dv.fProngPdgCodeHypothesis_ByMcs;
-    mcs_prongIsBestFwd = dv.fProngIsBestFwd_ByMcs;
-    // Prong Momentum (By Mcs, best)
-    mcs_prongMomMag_best_h1 = dv.fProngMomMag_ByMcs_best_h1;
-    mcs_prongEnergy_best_h1 = dv.fProngEnergy_ByMcs_best_h1;
-    mcs_prongMom_best_h1_X = dv.fProngMom_ByMcs_best_h1_X;
-    mcs_prongMom_best_h1_Y = dv.fProngMom_ByMcs_best_h1_Y;
-    mcs_prongMom_best_h1_Z = dv.fProngMom_ByMcs_best_h1_Z;
-    mcs_prongMomMag_best_h2 = dv.fProngMomMag_ByMcs_best_h2;
-    mcs_prongEnergy_best_h2 = dv.fProngEnergy_ByMcs_best_h2;
-    mcs_prongMom_best_h2_X = dv.fProngMom_ByMcs_best_h2_X;
-    mcs_prongMom_best_h2_Y = dv.fProngMom_ByMcs_best_h2_Y;
-    mcs_prongMom_best_h2_Z = dv.fProngMom_ByMcs_best_h2_Z;
-    // Tot momentum (by range, assuming both muons, best)
-    mcs_totMomMag_best_h1 = dv.fTotMomMag_ByMcs_best_h1;
-    mcs_totEnergy_best_h1 = dv.fTotEnergy_ByMcs_best_h1;
-    mcs_invariantMass_best_h1 = dv.fInvMass_ByMcs_best_h1;
-    mcs_totMom_best_h1_X = dv.fTotMom_ByMcs_best_h1_X;
-    mcs_totMom_best_h1_Y = dv.fTotMom_ByMcs_best_h1_Y;
-    mcs_totMom_best_h1_Z = dv.fTotMom_ByMcs_best_h1_Z;
-    mcs_totMomMag_best_h2 = dv.fTotMomMag_ByMcs_best_h2;
-    mcs_totEnergy_best_h2 = dv.fTotEnergy_ByMcs_best_h2;
-    mcs_invariantMass_best_h2 = dv.fInvMass_ByMcs_best_h2;
-    mcs_totMom_best_h2_X = dv.fTotMom_ByMcs_best_h2_X;
-    mcs_totMom_best_h2_Y = dv.fTotMom_ByMcs_best_h2_Y;
-    mcs_totMom_best_h2_Z = dv.fTotMom_ByMcs_best_h2_Z;
-    // Tot momentum direction (by range, assuming both muons, best)
-    mcs_totTheta_best_h1 = dv.fTotTheta_ByMcs_best_h1;
-    mcs_totPhi_best_h1 = dv.fTotPhi_ByMcs_best_h1;
-    mcs_totDir_best_h1_X = dv.fTotDir_ByMcs_best_h1_X;
-    mcs_totDir_best_h1_Y = dv.fTotDir_ByMcs_best_h1_Y;
-    mcs_totDir_best_h1_Z = dv.fTotDir_ByMcs_best_h1_Z;
-    mcs_totTheta_best_h2 = dv.fTotTheta_ByMcs_best_h2;
-    mcs_totPhi_best_h2 = dv.fTotPhi_ByMcs_best_h2;
-    mcs_totDir_best_h2_X = dv.fTotDir_ByMcs_best_h2_X;
-    mcs_totDir_best_h2_Y = dv.fTotDir_ByMcs_best_h2_Y;
-    mcs_totDir_best_h2_Z = dv.fTotDir_ByMcs_best_h2_Z;
+    mcs_prongPdgCodeHypothesis = {candidates.fProngPdgCodeHypothesis_ByMcs[hsnID][0],candidates.fProngPdgCodeHypothesis_ByMcs[hsnID][1]};
+    mcs_prongIsBestFwd = {candidates.fProngIsBestFwd_ByMcs[hsnID][0],candidates.fProngIsBestFwd_ByMcs[hsnID][1]};
     // Extra
-    prongNumHits = {dv.fProngNumHits[0],dv.fProngNumHits[1]};
-    prongStartToNeutrinoDistance = {dv.fProngStartToNeutrinoDistance[0],dv.fProngStartToNeutrinoDistance[1]};
+    prongNumHits = {candidates.fProngNumHits[hsnID][0],candidates.fProngNumHits[hsnID][1]};
+    prongStartToNeutrinoDistance = {candidates.fProngStartToNeutrinoDistance[hsnID][0],candidates.fProngStartToNeutrinoDistance[hsnID][1]};
 
     // Calculate extra quantities
     // Calculate end points
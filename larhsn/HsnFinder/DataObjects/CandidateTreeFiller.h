@@ -33,7 +33,7 @@
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom<>()
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
-#include "larhsn/HsnFinder/DataObjects/DecayVertex.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
 #include "EventTreeFiller.h"
 
 
@@ -47,8 +47,15 @@ namespace AuxEvent
     // Constructor and destructor
     CandidateTreeFiller();
     virtual ~CandidateTreeFiller();
+    // Movable, so filled instances can be handed to the tree writer without copying their vectors
+    CandidateTreeFiller(const CandidateTreeFiller &) = default;
+    CandidateTreeFiller(CandidateTreeFiller &&) = default;
+    CandidateTreeFiller & operator=(const CandidateTreeFiller &) = default;
+    CandidateTreeFiller & operator=(CandidateTreeFiller &&) = default;
 
-    void Initialize(AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::DecayVertex & decayVertex, std::vector<double> centerCoordinates);
+    void Initialize(AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::CandidateBatch & candidates, std::vector<double> centerCoordinates);
+    // Output columns: calls bind(name, &member) for each of them, in output order. Used by the output trees and the readers.
+    template <typename Binder> void BindFields(Binder & bind, bool withTruthDistance);
 
     // General
     int run;
@@ -70,57 +77,30 @@ namespace AuxEvent
     // Direction
     std::vector<float> geo_prongDirX, geo_prongDirY, geo_prongDirZ;
     std::vector<float> geo_prongTheta, geo_prongPhi;
-    // Hypothesis information
-    std::vector<int> hypo_prongPdgCode_h1, hypo_prongPdgCode_h2;
-    std::vector<float> hypo_prongMass_h1, hypo_prongMass_h2;
-    // Prong momentum (by range, assuming both muons)
-    std::vector<float> range_prongMomMag_h1, range_prongEnergy_h1;
-    std::vector<float> range_prongMom_h1_X, range_prongMom_h1_Y, range_prongMom_h1_Z;
-    std::vector<float> range_prongMomMag_h2, range_prongEnergy_h2;
-    std::vector<float> range_prongMom_h2_X, range_prongMom_h2_Y, range_prongMom_h2_Z;
-    // Tot momentum (by range, assuming both muons)
-    float range_totMomMag_h1, range_totEnergy_h1, range_invariantMass_h1;
-    float range_totMom_h1_X, range_totMom_h1_Y, range_totMom_h1_Z;
-    float range_totMomMag_h2, range_totEnergy_h2, range_invariantMass_h2;
-    float range_totMom_h2_X, range_totMom_h2_Y, range_totMom_h2_Z;
-    // Tot momentum direction (by range, assuming both muons)
-    float range_totTheta_h1, range_totPhi_h1;
-    float range_totDir_h1_X, range_totDir_h1_Y, range_totDir_h1_Z;
-    float range_totTheta_h2, range_totPhi_h2;
-    float range_totDir_h2_X, range_totDir_h2_Y, range_totDir_h2_Z;
+    // Hypothesis information (one entry per hypothesis in AuxVertex::kMassHypotheses)
+    AuxVertex::Hypotheses<std::vector<int>> hypo_prongPdgCode;
+    AuxVertex::Hypotheses<std::vector<float>> hypo_prongMass;
+    // Prong momentum (by range)
+    AuxVertex::Hypotheses<std::vector<float>> range_prongMomMag, range_prongEnergy;
+    AuxVertex::Hypotheses<std::vector<float>> range_prongMom_X, range_prongMom_Y, range_prongMom_Z;
+    // Tot momentum (by range)
+    AuxVertex::Hypotheses<float> range_totMomMag, range_totEnergy, range_invariantMass;
+    AuxVertex::Hypotheses<float> range_totMom_X, range_totMom_Y, range_totMom_Z;
+    // Tot momentum direction (by range)
+    AuxVertex::Hypotheses<float> range_totTheta, range_totPhi;
+    AuxVertex::Hypotheses<float> range_totDir_X, range_totDir_Y, range_totDir_Z;
     // MCS variables
     std::vector<int> mcs_prongPdgCodeHypothesis;
     std::vector<bool>  mcs_prongIsBestFwd;
-    // Prong Momentum (By MCS, forward)
-    std::vector<float> mcs_prongMomMag_fwd_h1, mcs_prongEnergy_fwd_h1;
-    std::vector<float> mcs_prongMom_fwd_h1_X, mcs_prongMom_fwd_h1_Y, mcs_prongMom_fwd_h1_Z;
-    std::vector<float> mcs_prongMomMag_fwd_h2, mcs_prongEnergy_fwd_h2;
-    std::vector<float> mcs_prongMom_fwd_h2_X, mcs_prongMom_fwd_h2_Y, mcs_prongMom_fwd_h2_Z;
-    // Tot momentum (by MCS, assuming both muons, forward)
-    float mcs_totMomMag_fwd_h1, mcs_totEnergy_fwd_h1, mcs_invariantMass_fwd_h1;
-    float mcs_totMom_fwd_h1_X, mcs_totMom_fwd_h1_Y, _totMom_fwd_h1_Z;
-    float mcs_totMomMag_fwd_h2, mcs_totEnergy_fwd_h2, mcs_invariantMass_fwd_h2;
-    float mcs_totMom_fwd_h2_X, mcs_totMom_fwd_h2_Y, mcs_totMom_fwd_h2_Z;
-    // Tot momentum direction (by MCS, assuming both muons, forward)
-    float mcs_totTheta_fwd_h1, mcs_totPhi_fwd_h1;
-    float mcs_totDir_fwd_h1_X, mcs_totDir_fwd_h1_Y, mcs_totDir_fwd_h1_Z;
-    float mcs_totTheta_fwd_h2, mcs_totPhi_fwd_h2;
-    float mcs_totDir_fwd_h2_X, mcs_totDir_fwd_h2_Y, mcs_totDir_fwd_h2_Z;
     // Prong Momentum (By MCS, best)
-    std::vector<float> mcs_prongMomMag_best_h1, mcs_prongEnergy_best_h1;
-    std::vector<float> mcs_prongMom_best_h1_X, mcs_prongMom_best_h1_Y, mcs_prongMom_best_h1_Z;
-    std::vector<float> mcs_prongMomMag_best_h2, mcs_prongEnergy_best_h2;
-    std::vector<float> mcs_prongMom_best_h2_X, mcs_prongMom_best_h2_Y, mcs_prongMom_best_h2_Z;
-    // Tot momentum (by MCS, assuming both muons, best)
-    float mcs_totMomMag_best_h1, mcs_totEnergy_best_h1, mcs_invariantMass_best_h1;
-    float mcs_totMom_best_h1_X, mcs_totMom_best_h1_Y, mcs_totMom_best_h1_Z;
-    float mcs_totMomMag_best_h2, mcs_totEnergy_best_h2, mcs_invariantMass_best_h2;
-    float mcs_totMom_best_h2_X, mcs_totMom_best_h2_Y, mcs_totMom_best_h2_Z;
-    // Tot momentum direction (by MCS, assuming both muons, best)
-    float mcs_totTheta_best_h1, mcs_totPhi_best_h1;
-    float mcs_totDir_best_h1_X, mcs_totDir_best_h1_Y, mcs_totDir_best_h1_Z;
-    float mcs_totTheta_best_h2, mcs_totPhi_best_h2;
-    float mcs_totDir_best_h2_X, mcs_totDir_best_h2_Y, mcs_totDir_best_h2_Z;
+    AuxVertex::Hypotheses<std::vector<float>> mcs_prongMomMag_best, mcs_prongEnergy_best;
+    AuxVertex::Hypotheses<std::vector<float>> mcs_prongMom_best_X, mcs_prongMom_best_Y, mcs_prongMom_best_Z;
+    // Tot momentum (by MCS, best)
+    AuxVertex::Hypotheses<float> mcs_totMomMag_best, mcs_totEnergy_best, mcs_invariantMass_best;
+    AuxVertex::Hypotheses<float> mcs_totMom_best_X, mcs_totMom_best_Y, mcs_totMom_best_Z;
+    // Tot momentum direction (by MCS, best)
+    AuxVertex::Hypotheses<float> mcs_totTheta_best, mcs_totPhi_best;
+    AuxVertex::Hypotheses<float> mcs_totDir_best_X, mcs_totDir_best_Y, mcs_totDir_best_Z;
     // Extra
     std::vector<float> prongStartToNeutrinoDistance;
     std::vector<int> prongNumHits;
@@ -132,13 +112,129 @@ namespace AuxEvent
     int status_nuWithMissingAssociatedVertex;
     int status_nuWithMissingAssociatedTrack;
     int status_nuProngWithMissingAssociatedHits;
-    // Pandora calo
-    std::vector<std::vector<float>> calo_totChargeInRadius;
-    std::vector<std::vector<float>> calo_prong1ChargeInRadius;
-    std::vector<std::vector<float>> calo_prong2ChargeInRadius;
-    std::vector<std::vector<float>> calo_caloRatio;
+    // Pandora calo (one entry for each radius of the profile, filled from CalorimetryRadiusAlg)
+    std::vector<float> calo_totChargeInRadius;
+    std::vector<float> calo_prong1ChargeInRadius;
+    std::vector<float> calo_prong2ChargeInRadius;
+    std::vector<float> calo_caloRatio;
   };
 
+  // Column list of the candidate data, shared by the layouts that store it (CandidateTreeFiller and CandidateFlatRow have members with the same names)
+  template <typename Row, typename Binder>
+  void BindCandidateColumns(Row & row, Binder & bind, bool withTruthDistance)
+  {
+    // HSN ID
+    bind("run", &row.run);
+    bind("subrun", &row.subrun);
+    bind("event", &row.event);
+    bind("hsnID", &row.hsnID);
+    bind("nHsnCandidatesInSameEvent", &row.nHsnCandidatesInSameEvent);
+    // Cheat reco-truth
+    if (withTruthDistance)
+    {
+      bind("recoTruthDistance", &row.recoTruthDistance);
+      bind("isClosestToTruth", &row.isClosestToTruth);
+      bind("truthCoordinates", &row.truthCoordinates);
+    }
+    // Coordinates
+    bind("geo_nuPositionX", &row.geo_nuPosX);
+    bind("geo_nuPositionY", &row.geo_nuPosY);
+    bind("geo_nuPositionZ", &row.geo_nuPosZ);
+    bind("geo_prongPositionX", &row.geo_prongPosX);
+    bind("geo_prongPositionY", &row.geo_prongPosY);
+    bind("geo_prongPositionZ", &row.geo_prongPosZ);
+    bind("geo_prongStartPositionX", &row.geo_prongStartPosX);
+    bind("geo_prongStartPositionY", &row.geo_prongStartPosY);
+    bind("geo_prongStartPositionZ", &row.geo_prongStartPosZ);
+    bind("geo_prongEndPositionX", &row.geo_prongEndPosX);
+    bind("geo_prongEndPositionY", &row.geo_prongEndPosY);
+    bind("geo_prongEndPositionZ", &row.geo_prongEndPosZ);
+    bind("geo_prongLength", &row.geo_prongLength);
+    bind("geo_openingAngle", &row.geo_openingAngle);
+    // Direction
+    bind("geo_prongDirectionX", &row.geo_prongDirX);
+    bind("geo_prongDirectionY", &row.geo_prongDirY);
+    bind("geo_prongDirectionZ", &row.geo_prongDirZ);
+    bind("geo_prongTheta", &row.geo_prongTheta);
+    bind("geo_prongPhi", &row.geo_prongPhi);
+    // Momentum (By Mcs)
+    bind("mcs_prongPdgCodeHypothesis", &row.mcs_prongPdgCodeHypothesis);
+    bind("mcs_prongIsBestFwd", &row.mcs_prongIsBestFwd);
+    // Hypothesis-dependent fields, one set per entry of the mass-hypothesis table
+    for (size_t h=0; h!=AuxVertex::kNumHypotheses; h++)
+    {
+      const std::string hl = AuxVertex::kMassHypotheses[h].label;
+      // Hypothesis info
+      bind("hypo_prongPdgCode_"+hl, &row.hypo_prongPdgCode[h]);
+      bind("hypo_prongMass_"+hl, &row.hypo_prongMass[h]);
+      // Prong momentum (by range)
+      bind("range_prongEnergy_"+hl, &row.range_prongEnergy[h]);
+      bind("range_prongMomMag_"+hl, &row.range_prongMomMag[h]);
+      bind("range_prongMom_"+hl+"_X", &row.range_prongMom_X[h]);
+      bind("range_prongMom_"+hl+"_Y", &row.range_prongMom_Y[h]);
+      bind("range_prongMom_"+hl+"_Z", &row.range_prongMom_Z[h]);
+      // Tot momentum (by range)
+      bind("range_invariantMass_"+hl, &row.range_invariantMass[h]);
+      bind("range_totEnergy_"+hl, &row.range_totEnergy[h]);
+      bind("range_totMomMag_"+hl, &row.range_totMomMag[h]);
+      bind("range_totMom_"+hl+"_X", &row.range_totMom_X[h]);
+      bind("range_totMom_"+hl+"_Y", &row.range_totMom_Y[h]);
+      bind("range_totMom_"+hl+"_Z", &row.range_totMom_Z[h]);
+      // Tot momentum direction (by range)
+      bind("range_totDirection_"+hl+"_X", &row.range_totDir_X[h]);
+      bind("range_totDirection_"+hl+"_Y", &row.range_totDir_Y[h]);
+      bind("range_totDirection_"+hl+"_Z", &row.range_totDir_Z[h]);
+      bind("range_totTheta_"+hl, &row.range_totTheta[h]);
+      bind("range_totPhi_"+hl, &row.range_totPhi[h]);
+      // Prong Momentum (By Mcs, best)
+      bind("mcs_prongMomMag_best_"+hl, &row.mcs_prongMomMag_best[h]);
+      bind("mcs_prongEnergy_best_"+hl, &row.mcs_prongEnergy_best[h]);
+      bind("mcs_prongMom_best_"+hl+"_X", &row.mcs_prongMom_best_X[h]);
+      bind("mcs_prongMom_best_"+hl+"_Y", &row.mcs_prongMom_best_Y[h]);
+      bind("mcs_prongMom_best_"+hl+"_Z", &row.mcs_prongMom_best_Z[h]);
+      // Tot momentum (by MCS, best)
+      bind("mcs_totMomMag_best_"+hl, &row.mcs_totMomMag_best[h]);
+      bind("mcs_totEnergy_best_"+hl, &row.mcs_totEnergy_best[h]);
+      bind("mcs_invariantMass_best_"+hl, &row.mcs_invariantMass_best[h]);
+      bind("mcs_totMom_best_"+hl+"_X", &row.mcs_totMom_best_X[h]);
+      bind("mcs_totMom_best_"+hl+"_Y", &row.mcs_totMom_best_Y[h]);
+      bind("mcs_totMom_best_"+hl+"_Z", &row.mcs_totMom_best_Z[h]);
+      // Tot momentum direction (by MCS, best)
+      bind("mcs_totTheta_best_"+hl, &row.mcs_totTheta_best[h]);
+      bind("mcs_totPhi_best_"+hl, &row.mcs_totPhi_best[h]);
+      bind("mcs_totDir_best_"+hl+"_X", &row.mcs_totDir_best_X[h]);
+      bind("mcs_totDir_best_"+hl+"_Y", &row.mcs_totDir_best_Y[h]);
+      bind("mcs_totDir_best_"+hl+"_Z", &row.mcs_totDir_best_Z[h]);
+    }
+    // Others
+    bind("prongStartToNeutrinoDistance", &row.prongStartToNeutrinoDistance);
+    bind("prongNumHits", &row.prongNumHits);
+    bind("maxEndPointX", &row.maxEndPointX);
+    bind("maxEndPointY", &row.maxEndPointY);
+    bind("maxEndPointZ", &row.maxEndPointZ);
+    bind("deltaPhi", &row.deltaPhi);
+    bind("deltaTheta", &row.deltaTheta);
+    bind("lengthDiff", &row.lengthDiff);
+    bind("lengthRatio", &row.lengthRatio);
+    bind("maxStartToNeutrinoDistance", &row.maxStartToNeutrinoDistance);
+    // Calorimetry
+    bind("calo_totChargeInRadius", &row.calo_totChargeInRadius);
+    bind("calo_prong1ChargeInRadius", &row.calo_prong1ChargeInRadius);
+    bind("calo_prong2ChargeInRadius", &row.calo_prong2ChargeInRadius);
+    bind("calo_caloRatio", &row.calo_caloRatio);
+    // // Status
+    // bind("status_nuWithMissingAssociatedVertex", &row.status_nuWithMissingAssociatedVertex);
+    // bind("status_nuWithMissingAssociatedTrack", &row.status_nuWithMissingAssociatedTrack);
+    // bind("status_nuProngWithMissingAssociatedHits", &row.status_nuProngWithMissingAssociatedHits);
+  } // END function BindCandidateColumns
+
+  template <typename Binder>
+  void CandidateTreeFiller::BindFields(Binder & bind, bool withTruthDistance)
+  {
+    BindCandidateColumns(*this, bind, withTruthDistance);
+    return;
+  } // END function BindFields
+
 
 } //END namespace AuxEvent
 
@@ -15,7 +15,7 @@ namespace AuxEvent
   DrawTreeFiller::~DrawTreeFiller()
   {}
 
-  void DrawTreeFiller::Initialize(AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::DecayVertex & decayVertex)
+  void DrawTreeFiller::Initialize(AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::CandidateBatch & candidates)
   {
     // General
     run = etf.run;
@@ -38,10 +38,10 @@ namespace AuxEvent
     p2_maxWire = -1e6;
     p2_minWire = 1e6;
 
-    // Get vector of hits
-    std::vector<art::Ptr<recob::Hit>> prong1_hits = decayVertex.GetProngHits(0);
-    std::vector<art::Ptr<recob::Hit>> prong2_hits = decayVertex.GetProngHits(1);
-    std::vector<art::Ptr<recob::Hit>> thisTot_hits = decayVertex.GetTotHits();
+    // Get views of the hits (no copy)
+    AuxEvent::HitView prong1_hits = candidates.GetProngHits(hsnID,0);
+    AuxEvent::HitView prong2_hits = candidates.GetProngHits(hsnID,1);
+    AuxEvent::HitView thisTot_hits = candidates.GetTotHits(hsnID);
 
     // Fill prong1
     prong1_hits_p0_wireCoordinates.clear();
@@ -50,11 +50,11 @@ namespace AuxEvent
     prong1_hits_p1_tickCoordinates.clear();
     prong1_hits_p2_wireCoordinates.clear();
     prong1_hits_p2_tickCoordinates.clear();
-    for (auto hit : prong1_hits)
+    for (const recob::Hit & hit : prong1_hits)
     {
-      float meanTick = (hit->StartTick() + hit->EndTick())/2.;
-      int channel = hit->Channel();
-      if (hit->View() == 0) {
+      float meanTick = (hit.StartTick() + hit.EndTick())/2.;
+      int channel = hit.Channel();
+      if (hit.View() == 0) {
         prong1_hits_p0_wireCoordinates.push_back(channel);
         prong1_hits_p0_tickCoordinates.push_back(meanTick);
         if (channel<p0_minWire) p0_minWire = channel;
@@ -62,7 +62,7 @@ namespace AuxEvent
         if (meanTick<p0_minTick) p0_minTick = meanTick;
         if (meanTick>p0_maxTick) p0_maxTick = meanTick;
       }
-      if (hit->View() == 1) {
+      if (hit.View() == 1) {
         prong1_hits_p1_wireCoordinates.push_back(channel);
         prong1_hits_p1_tickCoordinates.push_back(meanTick);
         if (channel<p1_minWire) p1_minWire = channel;
@@ -70,7 +70,7 @@ namespace AuxEvent
         if (meanTick<p1_minTick) p1_minTick = meanTick;
         if (meanTick>p1_maxTick) p1_maxTick = meanTick;
       }
-      if (hit->View() == 2) {
+      if (hit.View() == 2) {
         prong1_hits_p2_wireCoordinates.push_back(channel);
         prong1_hits_p2_tickCoordinates.push_back(meanTick);
         if (channel<p2_minWire) p2_minWire = channel;
@@ -87,11 +87,11 @@ namespace AuxEvent
     prong2_hits_p1_tickCoordinates.clear();
     prong2_hits_p2_wireCoordinates.clear();
     prong2_hits_p2_tickCoordinates.clear();
-    for (auto hit : prong2_hits)
+    for (const recob::Hit & hit : prong2_hits)
     {
-      float meanTick = (hit->StartTick() + hit->EndTick())/2.;
-      int channel = hit->Channel();
-      if (hit->View() == 0) {
+      float meanTick = (hit.StartTick() + hit.EndTick())/2.;
+      int channel = hit.Channel();
+      if (hit.View() == 0) {
         prong2_hits_p0_wireCoordinates.push_back(channel);
         prong2_hits_p0_tickCoordinates.push_back(meanTick);
         if (channel<p0_minWire) p0_minWire = channel;
@@ -99,7 +99,7 @@ namespace AuxEvent
         if (meanTick<p0_minTick) p0_minTick = meanTick;
         if (meanTick>p0_maxTick) p0_maxTick = meanTick;
       }
-      if (hit->View() == 1) {
+      if (hit.View() == 1) {
         prong2_hits_p1_wireCoordinates.push_back(channel);
         prong2_hits_p1_tickCoordinates.push_back(meanTick);
         if (channel<p1_minWire) p1_minWire = channel;
@@ -107,7 +107,7 @@ namespace AuxEvent
         if (meanTick<p1_minTick) p1_minTick = meanTick;
         if (meanTick>p1_maxTick) p1_maxTick = meanTick;
       }
-      if (hit->View() == 2) {
+      if (hit.View() == 2) {
         prong2_hits_p2_wireCoordinates.push_back(channel);
         prong2_hits_p2_tickCoordinates.push_back(meanTick);
         if (channel<p2_minWire) p2_minWire = channel;
@@ -124,11 +124,11 @@ namespace AuxEvent
     tot_hits_p1_tickCoordinates.clear();
     tot_hits_p2_wireCoordinates.clear();
     tot_hits_p2_tickCoordinates.clear();
-    for (auto hit : thisTot_hits)
+    for (const recob::Hit & hit : thisTot_hits)
     {
-      float meanTick = (hit->StartTick() + hit->EndTick())/2.;
-      int channel = hit->Channel();
-      if (hit->View() == 0) {
+      float meanTick = (hit.StartTick() + hit.EndTick())/2.;
+      int channel = hit.Channel();
+      if (hit.View() == 0) {
         tot_hits_p0_wireCoordinates.push_back(channel);
         tot_hits_p0_tickCoordinates.push_back(meanTick);
         if (channel<p0_minWire) p0_minWire = channel;
@@ -136,7 +136,7 @@ namespace AuxEvent
         if (meanTick<p0_minTick) p0_minTick = meanTick;
         if (meanTick>p0_maxTick) p0_maxTick = meanTick;
       }
-      if (hit->View() == 1) {
+      if (hit.View() == 1) {
         tot_hits_p1_wireCoordinates.push_back(channel);
         tot_hits_p1_tickCoordinates.push_back(meanTick);
         if (channel<p1_minWire) p1_minWire = channel;
@@ -144,7 +144,7 @@ namespace AuxEvent
         if (meanTick<p1_minTick) p1_minTick = meanTick;
         if (meanTick>p1_maxTick) p1_maxTick = meanTick;
       }
-      if (hit->View() == 2) {
+      if (hit.View() == 2) {
         tot_hits_p2_wireCoordinates.push_back(channel);
         tot_hits_p2_tickCoordinates.push_back(meanTick);
         if (channel<p2_minWire) p2_minWire = channel;
@@ -155,12 +155,12 @@ namespace AuxEvent
     }
 
     // Get coordinates
-    dv_p0_wireCoordinates = decayVertex.fChannelLoc[0];
-    dv_p0_tickCoordinates = decayVertex.fTickLoc[0];
-    dv_p1_wireCoordinates = decayVertex.fChannelLoc[1];
-    dv_p1_tickCoordinates = decayVertex.fTickLoc[1];
-    dv_p2_wireCoordinates = decayVertex.fChannelLoc[2];
-    dv_p2_tickCoordinates = decayVertex.fTickLoc[2];
+    dv_p0_wireCoordinates = candidates.fChannelLoc[hsnID][0];
+    dv_p0_tickCoordinates = candidates.fTickLoc[hsnID][0];
+    dv_p1_wireCoordinates = candidates.fChannelLoc[hsnID][1];
+    dv_p1_tickCoordinates = candidates.fTickLoc[hsnID][1];
+    dv_p2_wireCoordinates = candidates.fChannelLoc[hsnID][2];
+    dv_p2_tickCoordinates = candidates.fTickLoc[hsnID][2];
     if (dv_p0_wireCoordinates<p0_minWire) p0_minWire = dv_p0_wireCoordinates;
     if (dv_p0_wireCoordinates>p0_maxWire) p0_maxWire = dv_p0_wireCoordinates;
     if (dv_p1_wireCoordinates<p1_minWire) p1_minWire = dv_p1_wireCoordinates;
@@ -174,12 +174,12 @@ namespace AuxEvent
     if (dv_p2_tickCoordinates<p2_minTick) p2_minTick = dv_p2_tickCoordinates;
     if (dv_p2_tickCoordinates>p2_maxTick) p2_maxTick = dv_p2_tickCoordinates;
 
-    prong1_p0_wireCoordinates = decayVertex.fProngChannelLoc[0][0];
-    prong1_p0_tickCoordinates = decayVertex.fProngTickLoc[0][0];
-    prong1_p1_wireCoordinates = decayVertex.fProngChannelLoc[0][1];
-    prong1_p1_tickCoordinates = decayVertex.fProngTickLoc[0][1];
-    prong1_p2_wireCoordinates = decayVertex.fProngChannelLoc[0][2];
-    prong1_p2_tickCoordinates = decayVertex.fProngTickLoc[0][2];
+    prong1_p0_wireCoordinates = candidates.fProngChannelLoc[hsnID][0][0];
+    prong1_p0_tickCoordinates = candidates.fProngTickLoc[hsnID][0][0];
+    prong1_p1_wireCoordinates = candidates.fProngChannelLoc[hsnID][0][1];
+    prong1_p1_tickCoordinates = candidates.fProngTickLoc[hsnID][0][1];
+    prong1_p2_wireCoordinates = candidates.fProngChannelLoc[hsnID][0][2];
+    prong1_p2_tickCoordinates = candidates.fProngTickLoc[hsnID][0][2];
     if (prong1_p0_wireCoordinates<p0_minWire) p0_minWire = prong1_p0_wireCoordinates;
     if (prong1_p0_wireCoordinates>p0_maxWire) p0_maxWire = prong1_p0_wireCoordinates;
     if (prong1_p1_wireCoordinates<p1_minWire) p1_minWire = prong1_p1_wireCoordinates;
@@ -193,12 +193,12 @@ namespace AuxEvent
     if (prong1_p2_tickCoordinates<p2_minTick) p2_minTick = prong1_p2_tickCoordinates;
     if (prong1_p2_tickCoordinates>p2_maxTick) p2_maxTick = prong1_p2_tickCoordinates;
 
-    prong2_p0_wireCoordinates = decayVertex.fProngChannelLoc[1][0];
-    prong2_p0_tickCoordinates = decayVertex.fProngTickLoc[1][0];
-    prong2_p1_wireCoordinates = decayVertex.fProngChannelLoc[1][1];
-    prong2_p1_tickCoordinates = decayVertex.fProngTickLoc[1][1];
-    prong2_p2_wireCoordinates = decayVertex.fProngChannelLoc[1][2];
-    prong2_p2_tickCoordinates = decayVertex.fProngTickLoc[1][2];
+    prong2_p0_wireCoordinates = candidates.fProngChannelLoc[hsnID][1][0];
+    prong2_p0_tickCoordinates = candidates.fProngTickLoc[hsnID][1][0];
+    prong2_p1_wireCoordinates = candidates.fProngChannelLoc[hsnID][1][1];
+    prong2_p1_tickCoordinates = candidates.fProngTickLoc[hsnID][1][1];
+    prong2_p2_wireCoordinates = candidates.fProngChannelLoc[hsnID][1][2];
+    prong2_p2_tickCoordinates = candidates.fProngTickLoc[hsnID][1][2];
     if (prong2_p0_wireCoordinates<p0_minWire) p0_minWire = prong2_p0_wireCoordinates;
     if (prong2_p0_wireCoordinates>p0_maxWire) p0_maxWire = prong2_p0_wireCoordinates;
     if (prong2_p1_wireCoordinates<p1_minWire) p1_minWire = prong2_p1_wireCoordinates;
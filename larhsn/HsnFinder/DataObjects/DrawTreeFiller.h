@@ -66,7 +66,7 @@
 #include "lardataobj/AnalysisBase/BackTrackerMatchingData.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 // HSN finder includes
-#include "larhsn/HsnFinder/DataObjects/DecayVertex.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
 #include "EventTreeFiller.h"
 
 
@@ -80,7 +80,14 @@ namespace AuxEvent
     // Constructor and destructor
     DrawTreeFiller();
     virtual ~DrawTreeFiller();
-    void Initialize(AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::DecayVertex & decayVertex);
+    // Movable, so filled instances can be handed to the tree writer without copying their vectors
+    DrawTreeFiller(const DrawTreeFiller &) = default;
+    DrawTreeFiller(DrawTreeFiller &&) = default;
+    DrawTreeFiller & operator=(const DrawTreeFiller &) = default;
+    DrawTreeFiller & operator=(DrawTreeFiller &&) = default;
+    void Initialize(AuxEvent::EventTreeFiller & etf, int i_hsnID, const AuxVertex::CandidateBatch & candidates);
+    // Output columns: calls bind(name, &member) for each of them, in output order. Used by the output trees and the readers.
+    template <typename Binder> void BindFields(Binder & bind, bool withTruth);
 
     // General
     int run;
@@ -210,6 +217,113 @@ namespace AuxEvent
     std::vector<float> truth_secondaryShowers_end_p2_tickCoordinates;
 
   }; // END class AuxEvent
+
+  template <typename Binder>
+  void DrawTreeFiller::BindFields(Binder & bind, bool withTruth)
+  {
+    bind("run", &run);
+    bind("subrun", &subrun);
+    bind("event", &event);
+    bind("hsnID", &hsnID);
+    bind("nHsnCandidatesInSameEvent", &nHsnCandidatesInSameEvent);
+    bind("dv_p0_wireCoordinates", &dv_p0_wireCoordinates);
+    bind("dv_p0_tickCoordinates", &dv_p0_tickCoordinates);
+    bind("dv_p1_wireCoordinates", &dv_p1_wireCoordinates);
+    bind("dv_p1_tickCoordinates", &dv_p1_tickCoordinates);
+    bind("dv_p2_wireCoordinates", &dv_p2_wireCoordinates);
+    bind("dv_p2_tickCoordinates", &dv_p2_tickCoordinates);
+    bind("prong1_p0_wireCoordinates", &prong1_p0_wireCoordinates);
+    bind("prong1_p0_tickCoordinates", &prong1_p0_tickCoordinates);
+    bind("prong1_p1_wireCoordinates", &prong1_p1_wireCoordinates);
+    bind("prong1_p1_tickCoordinates", &prong1_p1_tickCoordinates);
+    bind("prong1_p2_wireCoordinates", &prong1_p2_wireCoordinates);
+    bind("prong1_p2_tickCoordinates", &prong1_p2_tickCoordinates);
+    bind("prong2_p0_wireCoordinates", &prong2_p0_wireCoordinates);
+    bind("prong2_p0_tickCoordinates", &prong2_p0_tickCoordinates);
+    bind("prong2_p1_wireCoordinates", &prong2_p1_wireCoordinates);
+    bind("prong2_p1_tickCoordinates", &prong2_p1_tickCoordinates);
+    bind("prong2_p2_wireCoordinates", &prong2_p2_wireCoordinates);
+    bind("prong2_p2_tickCoordinates", &prong2_p2_tickCoordinates);
+    bind("prong1_hits_p0_wireCoordinates", &prong1_hits_p0_wireCoordinates);
+    bind("prong1_hits_p0_tickCoordinates", &prong1_hits_p0_tickCoordinates);
+    bind("prong1_hits_p1_wireCoordinates", &prong1_hits_p1_wireCoordinates);
+    bind("prong1_hits_p1_tickCoordinates", &prong1_hits_p1_tickCoordinates);
+    bind("prong1_hits_p2_wireCoordinates", &prong1_hits_p2_wireCoordinates);
+    bind("prong1_hits_p2_tickCoordinates", &prong1_hits_p2_tickCoordinates);
+    bind("prong2_hits_p0_wireCoordinates", &prong2_hits_p0_wireCoordinates);
+    bind("prong2_hits_p0_tickCoordinates", &prong2_hits_p0_tickCoordinates);
+    bind("prong2_hits_p1_wireCoordinates", &prong2_hits_p1_wireCoordinates);
+    bind("prong2_hits_p1_tickCoordinates", &prong2_hits_p1_tickCoordinates);
+    bind("prong2_hits_p2_wireCoordinates", &prong2_hits_p2_wireCoordinates);
+    bind("prong2_hits_p2_tickCoordinates", &prong2_hits_p2_tickCoordinates);
+    bind("tot_hits_p0_wireCoordinates", &tot_hits_p0_wireCoordinates);
+    bind("tot_hits_p0_tickCoordinates", &tot_hits_p0_tickCoordinates);
+    bind("tot_hits_p1_wireCoordinates", &tot_hits_p1_wireCoordinates);
+    bind("tot_hits_p1_tickCoordinates", &tot_hits_p1_tickCoordinates);
+    bind("tot_hits_p2_wireCoordinates", &tot_hits_p2_wireCoordinates);
+    bind("tot_hits_p2_tickCoordinates", &tot_hits_p2_tickCoordinates);
+    if (withTruth)
+    {
+      bind("truth_dv_p0_wireCoordinates", &truth_dv_p0_wireCoordinates);
+      bind("truth_dv_p0_tickCoordinates", &truth_dv_p0_tickCoordinates);
+      bind("truth_dv_p1_wireCoordinates", &truth_dv_p1_wireCoordinates);
+      bind("truth_dv_p1_tickCoordinates", &truth_dv_p1_tickCoordinates);
+      bind("truth_dv_p2_wireCoordinates", &truth_dv_p2_wireCoordinates);
+      bind("truth_dv_p2_tickCoordinates", &truth_dv_p2_tickCoordinates);
+      bind("truth_nPrimaryTracks", &truth_nPrimaryTracks);
+      bind("truth_nSecondaryTracks", &truth_nSecondaryTracks);
+      bind("truth_primaryTracks_start_p0_wireCoordinates", &truth_primaryTracks_start_p0_wireCoordinates);
+      bind("truth_primaryTracks_start_p0_tickCoordinates", &truth_primaryTracks_start_p0_tickCoordinates);
+      bind("truth_primaryTracks_start_p1_wireCoordinates", &truth_primaryTracks_start_p1_wireCoordinates);
+      bind("truth_primaryTracks_start_p1_tickCoordinates", &truth_primaryTracks_start_p1_tickCoordinates);
+      bind("truth_primaryTracks_start_p2_wireCoordinates", &truth_primaryTracks_start_p2_wireCoordinates);
+      bind("truth_primaryTracks_start_p2_tickCoordinates", &truth_primaryTracks_start_p2_tickCoordinates);
+      bind("truth_primaryTracks_end_p0_wireCoordinates", &truth_primaryTracks_end_p0_wireCoordinates);
+      bind("truth_primaryTracks_end_p0_tickCoordinates", &truth_primaryTracks_end_p0_tickCoordinates);
+      bind("truth_primaryTracks_end_p1_wireCoordinates", &truth_primaryTracks_end_p1_wireCoordinates);
+      bind("truth_primaryTracks_end_p1_tickCoordinates", &truth_primaryTracks_end_p1_tickCoordinates);
+      bind("truth_primaryTracks_end_p2_wireCoordinates", &truth_primaryTracks_end_p2_wireCoordinates);
+      bind("truth_primaryTracks_end_p2_tickCoordinates", &truth_primaryTracks_end_p2_tickCoordinates);
+      bind("truth_secondaryTracks_start_p0_wireCoordinates", &truth_secondaryTracks_start_p0_wireCoordinates);
+      bind("truth_secondaryTracks_start_p0_tickCoordinates", &truth_secondaryTracks_start_p0_tickCoordinates);
+      bind("truth_secondaryTracks_start_p1_wireCoordinates", &truth_secondaryTracks_start_p1_wireCoordinates);
+      bind("truth_secondaryTracks_start_p1_tickCoordinates", &truth_secondaryTracks_start_p1_tickCoordinates);
+      bind("truth_secondaryTracks_start_p2_wireCoordinates", &truth_secondaryTracks_start_p2_wireCoordinates);
+      bind("truth_secondaryTracks_start_p2_tickCoordinates", &truth_secondaryTracks_start_p2_tickCoordinates);
+      bind("truth_secondaryTracks_end_p0_wireCoordinates", &truth_secondaryTracks_end_p0_wireCoordinates);
+      bind("truth_secondaryTracks_end_p0_tickCoordinates", &truth_secondaryTracks_end_p0_tickCoordinates);
+      bind("truth_secondaryTracks_end_p1_wireCoordinates", &truth_secondaryTracks_end_p1_wireCoordinates);
+      bind("truth_secondaryTracks_end_p1_tickCoordinates", &truth_secondaryTracks_end_p1_tickCoordinates);
+      bind("truth_secondaryTracks_end_p2_wireCoordinates", &truth_secondaryTracks_end_p2_wireCoordinates);
+      bind("truth_secondaryTracks_end_p2_tickCoordinates", &truth_secondaryTracks_end_p2_tickCoordinates);
+      bind("truth_nPrimaryShowers", &truth_nPrimaryShowers);
+      bind("truth_nSecondaryShowers", &truth_nSecondaryShowers);
+      bind("truth_primaryShowers_start_p0_wireCoordinates", &truth_primaryShowers_start_p0_wireCoordinates);
+      bind("truth_primaryShowers_start_p0_tickCoordinates", &truth_primaryShowers_start_p0_tickCoordinates);
+      bind("truth_primaryShowers_start_p1_wireCoordinates", &truth_primaryShowers_start_p1_wireCoordinates);
+      bind("truth_primaryShowers_start_p1_tickCoordinates", &truth_primaryShowers_start_p1_tickCoordinates);
+      bind("truth_primaryShowers_start_p2_wireCoordinates", &truth_primaryShowers_start_p2_wireCoordinates);
+      bind("truth_primaryShowers_start_p2_tickCoordinates", &truth_primaryShowers_start_p2_tickCoordinates);
+      bind("truth_primaryShowers_end_p0_wireCoordinates", &truth_primaryShowers_end_p0_wireCoordinates);
+      bind("truth_primaryShowers_end_p0_tickCoordinates", &truth_primaryShowers_end_p0_tickCoordinates);
+      bind("truth_primaryShowers_end_p1_wireCoordinates", &truth_primaryShowers_end_p1_wireCoordinates);
+      bind("truth_primaryShowers_end_p1_tickCoordinates", &truth_primaryShowers_end_p1_tickCoordinates);
+      bind("truth_primaryShowers_end_p2_wireCoordinates", &truth_primaryShowers_end_p2_wireCoordinates);
+      bind("truth_primaryShowers_end_p2_tickCoordinates", &truth_primaryShowers_end_p2_tickCoordinates);
+      bind("truth_secondaryShowers_start_p0_wireCoordinates", &truth_secondaryShowers_start_p0_wireCoordinates);
+      bind("truth_secondaryShowers_start_p0_tickCoordinates", &truth_secondaryShowers_start_p0_tickCoordinates);
+      bind("truth_secondaryShowers_start_p1_wireCoordinates", &truth_secondaryShowers_start_p1_wireCoordinates);
+      bind("truth_secondaryShowers_start_p1_tickCoordinates", &truth_secondaryShowers_start_p1_tickCoordinates);
+      bind("truth_secondaryShowers_start_p2_wireCoordinates", &truth_secondaryShowers_start_p2_wireCoordinates);
+      bind("truth_secondaryShowers_start_p2_tickCoordinates", &truth_secondaryShowers_start_p2_tickCoordinates);
+      bind("truth_secondaryShowers_end_p0_wireCoordinates", &truth_secondaryShowers_end_p0_wireCoordinates);
+      bind("truth_secondaryShowers_end_p0_tickCoordinates", &truth_secondaryShowers_end_p0_tickCoordinates);
+      bind("truth_secondaryShowers_end_p1_wireCoordinates", &truth_secondaryShowers_end_p1_wireCoordinates);
+      bind("truth_secondaryShowers_end_p1_tickCoordinates", &truth_secondaryShowers_end_p1_tickCoordinates);
+      bind("truth_secondaryShowers_end_p2_wireCoordinates", &truth_secondaryShowers_end_p2_wireCoordinates);
+      bind("truth_secondaryShowers_end_p2_tickCoordinates", &truth_secondaryShowers_end_p2_tickCoordinates);
+    }
+  } // END function BindFields
 } //END namespace AuxEvent
 
 #endif
\ No newline at end of file
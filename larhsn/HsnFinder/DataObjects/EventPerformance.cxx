@@ -0,0 +1,78 @@
+/******************************************************************************
+ * @file EventPerformance.cxx
+ * @brief Per-event stage timers and counters of HsnFinder, the Performance tree row and its end-of-job summary
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventPerformance.h
+ * ****************************************************************************/
+
+#include "EventPerformance.h"
+#include <algorithm>
+#include <numeric>
+
+namespace AuxEvent
+{
+  const char* const kStageNames[kNumStages] = {"pfpScan", "associations", "vertices", "calorimetry", "truth", "rows", "treeFill"};
+  const char* const kCounterNames[kNumCounters] = {"pfps", "associations", "hits", "candidates"};
+
+  EventPerformance::EventPerformance()
+  {
+    Initialize(-999, -999, -999);
+  }
+  EventPerformance::~EventPerformance()
+  {}
+
+  void EventPerformance::Initialize(int i_run, int i_subrun, int i_event)
+  {
+    run = i_run;
+    subrun = i_subrun;
+    event = i_event;
+    stageTime.fill(0.);
+    counts.fill(0);
+  } // END function Initialize
+
+  PerformanceSummary::PerformanceSummary()
+  {
+    fCounts.fill(0);
+  }
+  PerformanceSummary::~PerformanceSummary()
+  {}
+
+  void PerformanceSummary::Add(const EventPerformance & performance)
+  {
+    for (int s=0; s!=kNumStages; s++) fStageTimes[s].push_back(performance.stageTime[s]);
+    for (int c=0; c!=kNumCounters; c++) fCounts[c] += performance.counts[c];
+    return;
+  } // END function Add
+
+  void PerformanceSummary::Print(const HsnLog::Logger & log) const
+  {
+    const size_t nEvents = NumEvents();
+    std::string text = HsnLog::Format("\n--- HsnFinder stage timers (%zu events) ---\n", nEvents);
+    if (nEvents == 0)
+    {
+      HSN_INFO(log, "Performance", "%s", text.c_str());
+      return;
+    }
+    text += HsnLog::Format("%-14s %10s %10s %10s %10s %10s %12s\n", "Stage [ms]", "Mean", "p50", "p95", "p99", "Max", "Total [s]");
+    std::vector<double> sorted;
+    for (int s=0; s!=kNumStages; s++)
+    {
+      // Nearest rank percentiles
+      sorted = fStageTimes[s];
+      std::sort(sorted.begin(), sorted.end());
+      auto percentile = [&sorted](double p) {return sorted[std::min(sorted.size()-1, (size_t) (p*sorted.size()))];};
+      const double total = std::accumulate(sorted.begin(), sorted.end(), 0.);
+      text += HsnLog::Format("%-14s %10.3f %10.3f %10.3f %10.3f %10.3f %12.2f\n", kStageNames[s], total/nEvents, percentile(0.50), percentile(0.95), percentile(0.99), sorted.back(), total/1000.);
+    }
+    text += HsnLog::Format("%-14s %10s %12s\n", "Counter", "Mean", "Total");
+    for (int c=0; c!=kNumCounters; c++)
+    {
+      text += HsnLog::Format("%-14s %10.1f %12lld\n", kCounterNames[c], (double) fCounts[c]/nEvents, fCounts[c]);
+    }
+    HSN_INFO(log, "Performance", "%s", text.c_str());
+    return;
+  } // END function Print
+
+  size_t PerformanceSummary::NumEvents() const {return fStageTimes[0].size();}
+
+} // END namespace AuxEvent
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * @file EventPerformance.h
+ * @brief Per-event stage timers and counters of HsnFinder, the Performance tree row and its end-of-job summary
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  EventPerformance.cxx
+ * ****************************************************************************/
+
+#ifndef EVENTPERFORMANCE_H
+#define EVENTPERFORMANCE_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "larhsn/Logging/HsnLog.h"
+
+namespace AuxEvent
+{
+
+  // Stages of the event processing, in the order they run
+  enum PerformanceStage
+  {
+    kStagePfpScan,      // PFParticle hierarchy and search of the two-pronged neutrinos
+    kStageAssociations, // Vertex, track, hit and MCS lookups of the candidates
+    kStageVertices,     // Decay vertices of the complete candidates (coordinates, containment)
+    kStageCalorimetry,  // Charge radius profiles
+    kStageTruth,        // Truth extraction for the event and draw trees
+    kStageRows,         // Candidate and draw rows (kinematics of every mass hypothesis)
+    kStageTreeFill,     // Filling the output trees with the rows of the event
+    kNumStages
+  };
+  extern const char* const kStageNames[kNumStages];
+
+  // Work done by the stages
+  enum PerformanceCounter
+  {
+    kCountPfps,         // PFParticles scanned
+    kCountAssociations, // Association lookups (vertices, tracks and hit collections)
+    kCountHits,         // Hits referenced by the candidates, i.e. read by the calorimetry
+    kCountCandidates,   // Candidates with a row
+    kNumCounters
+  };
+  extern const char* const kCounterNames[kNumCounters];
+
+  // EventPerformance class and functions
+  // One row of the Performance tree. Travels with the event record, so it is written in the same order as the other trees.
+  class EventPerformance
+  {
+  public:
+    // Constructor and destructor
+    EventPerformance();
+    virtual ~EventPerformance();
+
+    void Initialize(int i_run, int i_subrun, int i_event);
+    // Output columns: calls bind(name, &member) for each of them, in output order
+    template <typename Binder> void BindFields(Binder & bind);
+
+    int run;
+    int subrun;
+    int event;
+    std::array<double,kNumStages> stageTime; // [ms]
+    std::array<int,kNumCounters> counts;
+  };
+
+  template <typename Binder>
+  void EventPerformance::BindFields(Binder & bind)
+  {
+    bind("run", &run);
+    bind("subrun", &subrun);
+    bind("event", &event);
+    for (int s=0; s!=kNumStages; s++) bind(std::string("time_")+kStageNames[s], &stageTime[s]);
+    for (int c=0; c!=kNumCounters; c++) bind(std::string("count_")+kCounterNames[c], &counts[c]);
+  } // END function BindFields
+
+  // Adds the time spent in its scope to a stage. With a null row (timers disabled) it does not read the clock at all.
+  class ScopedStageTimer
+  {
+  public:
+    ScopedStageTimer(EventPerformance* performance, PerformanceStage stage) : fPerformance(nullptr), fStage(stage) {Start(performance);}
+    ~ScopedStageTimer() {Stop();}
+    // Pause the stage (e.g. around a nested stage) and resume it
+    void Stop()
+    {
+      if (fPerformance) fPerformance->stageTime[fStage] += std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now() - fStart).count();
+      fPerformance = nullptr;
+    }
+    void Start(EventPerformance* performance)
+    {
+      fPerformance = performance;
+      if (fPerformance) fStart = std::chrono::steady_clock::now();
+    }
+    ScopedStageTimer(const ScopedStageTimer &) = delete;
+    ScopedStageTimer & operator=(const ScopedStageTimer &) = delete;
+
+  private:
+    EventPerformance* fPerformance;
+    PerformanceStage fStage;
+    std::chrono::steady_clock::time_point fStart;
+  };
+
+  inline void CountWork(EventPerformance* performance, PerformanceCounter counter, size_t n)
+  {
+    if (performance) performance->counts[counter] += (int) n;
+  }
+
+  // PerformanceSummary class and functions
+  // Keeps the stage times of every event, for percentiles at the end of the job
+  class PerformanceSummary
+  {
+  public:
+    // Constructor and destructor
+    PerformanceSummary();
+    virtual ~PerformanceSummary();
+
+    void Add(const EventPerformance & performance);
+    // Per stage: mean, p50, p95, p99 and maximum per event, and total. Per counter: mean per event and total.
+    void Print(const HsnLog::Logger & log) const;
+    size_t NumEvents() const;
+
+  private:
+    std::array<std::vector<double>,kNumStages> fStageTimes; // [ms], one entry per event
+    std::array<long long,kNumCounters> fCounts;
+  };
+
+} //END namespace AuxEvent
+
+#endif
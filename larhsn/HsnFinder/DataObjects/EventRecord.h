@@ -0,0 +1,32 @@
+/******************************************************************************
+ * @file EventRecord.h
+ * @brief All the tree rows produced by one event, kept together until they are written
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinderOutput.h
+ * ****************************************************************************/
+
+#ifndef EVENTRECORD_H
+#define EVENTRECORD_H
+
+// C++ standard libraries
+#include <vector>
+#include "larhsn/HsnFinder/DataObjects/EventTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/DrawTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/EventPerformance.h"
+
+namespace AuxEvent
+{
+
+  // Output of one event: the fillers are not bound to any branch, the tree writer swaps them into the ones that are.
+  struct EventRecord
+  {
+    EventTreeFiller event; // One row of the event tree
+    std::vector<CandidateTreeFiller> candidates; // One row of the candidate tree each
+    std::vector<DrawTreeFiller> draws; // One row of the draw tree each (only if the draw tree is saved)
+    EventPerformance performance; // One row of the performance tree (only with the stage timers)
+  };
+
+} //END namespace AuxEvent
+
+#endif
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * @file EventSource.h
+ * @brief Data products of one event as seen by the HsnFinder algorithms, for art and gallery events alike
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinder_module.cc, Gallery/HsnFinderGallery.cc
+ * ****************************************************************************/
+
+#ifndef EVENTSOURCE_H
+#define EVENTSOURCE_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <vector>
+#include "canvas/Persistency/Common/Assns.h"
+#include "canvas/Persistency/Common/EDProductGetter.h"
+#include "canvas/Persistency/Common/FindManyP.h"
+#include "canvas/Persistency/Common/FindOneP.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Utilities/InputTag.h"
+#include "cetlib/exception.h"
+#include "lardataobj/MCBase/MCShower.h"
+#include "lardataobj/MCBase/MCTrack.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "lardataobj/RecoBase/MCSFitResult.h"
+#include "lardataobj/RecoBase/PFParticle.h"
+#include "lardataobj/RecoBase/Track.h"
+#include "lardataobj/RecoBase/Vertex.h"
+#include "nusimdata/SimulationBase/MCTruth.h"
+
+namespace AuxEvent
+{
+
+  // A collection of the event and its product ID, enough to make art::Ptr to its elements
+  template <typename T>
+  struct ProductView
+  {
+    const std::vector<T>* product = nullptr;
+    art::ProductID id;
+    const std::vector<T> & operator*() const {return *product;}
+    const std::vector<T>* operator->() const {return product;}
+    art::Ptr<T> MakePtr(size_t key) const {return art::Ptr<T>(id, &(*product)[key], key);}
+  };
+
+  // EventSource class and functions
+  // Everything the algorithms read from an event. They only see this interface, so the same code runs in the art module
+  // (EventSourceOf<art::Event>) and in the art-free gallery runner (EventSourceOf<gallery::Event>).
+  // Missing products throw, as getValidHandle does.
+  class EventSource
+  {
+  public:
+    virtual ~EventSource() {}
+
+    virtual art::EventID ID() const = 0;
+
+    // Collections
+    virtual ProductView<recob::PFParticle> GetPFParticles(const art::InputTag & tag) const = 0;
+    virtual ProductView<recob::Hit> GetHits(const art::InputTag & tag) const = 0;
+    virtual ProductView<recob::MCSFitResult> GetMcsFitResults(const art::InputTag & tag) const = 0;
+    virtual ProductView<simb::MCTruth> GetMCTruths(const art::InputTag & tag) const = 0;
+    virtual ProductView<sim::MCTrack> GetMCTracks(const art::InputTag & tag) const = 0;
+    virtual ProductView<sim::MCShower> GetMCShowers(const art::InputTag & tag) const = 0;
+
+    // Associations made by the producer of tag, one query for many objects. Objects without an association get a null Ptr (or no hits).
+    virtual void FindVertices(const std::vector<art::Ptr<recob::PFParticle>> & pfps, const art::InputTag & tag, std::vector<art::Ptr<recob::Vertex>> & vertices) const = 0;
+    virtual void FindTracks(const std::vector<art::Ptr<recob::PFParticle>> & pfps, const art::InputTag & tag, std::vector<art::Ptr<recob::Track>> & tracks) const = 0;
+    virtual void FindHits(const std::vector<art::Ptr<recob::Track>> & tracks, const art::InputTag & tag, std::vector<std::vector<art::Ptr<recob::Hit>>> & hits) const = 0;
+
+    // Collection the hit points to, e.g. the one of the hits found by FindHits
+    virtual const std::vector<recob::Hit>* GetHitCollection(const art::Ptr<recob::Hit> & hit) const = 0;
+  };
+
+  // art::Event has id(), gallery::Event only eventAuxiliary()
+  template <typename Event>
+  auto EventIDOf(const Event & evt, int) -> decltype(evt.id()) {return evt.id();}
+  template <typename Event>
+  art::EventID EventIDOf(const Event & evt, long) {return evt.eventAuxiliary().id();}
+
+  // Adapter for any event with the art interface (getValidHandle, and a data container for FindOneP and FindManyP)
+  template <typename Event>
+  class EventSourceOf : public EventSource
+  {
+  public:
+    explicit EventSourceOf(const Event & evt) : fEvent(evt) {}
+
+    art::EventID ID() const override {return EventIDOf(fEvent, 0);}
+
+    ProductView<recob::PFParticle> GetPFParticles(const art::InputTag & tag) const override {return View<recob::PFParticle>(tag);}
+    ProductView<recob::Hit> GetHits(const art::InputTag & tag) const override {return View<recob::Hit>(tag);}
+    ProductView<recob::MCSFitResult> GetMcsFitResults(const art::InputTag & tag) const override {return View<recob::MCSFitResult>(tag);}
+    ProductView<simb::MCTruth> GetMCTruths(const art::InputTag & tag) const override {return View<simb::MCTruth>(tag);}
+    ProductView<sim::MCTrack> GetMCTracks(const art::InputTag & tag) const override {return View<sim::MCTrack>(tag);}
+    ProductView<sim::MCShower> GetMCShowers(const art::InputTag & tag) const override {return View<sim::MCShower>(tag);}
+
+    void FindVertices(const std::vector<art::Ptr<recob::PFParticle>> & pfps, const art::InputTag & tag, std::vector<art::Ptr<recob::Vertex>> & vertices) const override
+    {
+      FindOne(pfps, tag, vertices);
+    }
+    void FindTracks(const std::vector<art::Ptr<recob::PFParticle>> & pfps, const art::InputTag & tag, std::vector<art::Ptr<recob::Track>> & tracks) const override
+    {
+      FindOne(pfps, tag, tracks);
+    }
+    void FindHits(const std::vector<art::Ptr<recob::Track>> & tracks, const art::InputTag & tag, std::vector<std::vector<art::Ptr<recob::Hit>>> & hits) const override
+    {
+      art::FindManyP<recob::Hit> tha(tracks, fEvent, tag);
+      hits.resize(tracks.size());
+      for (size_t q=0; q!=tracks.size(); q++) tha.get(q, hits[q]);
+    }
+
+    const std::vector<recob::Hit>* GetHitCollection(const art::Ptr<recob::Hit> & hit) const override
+    {
+      // Ptr read with an association know where their product is, in art and in gallery alike
+      const art::EDProductGetter* getter = hit.productGetter();
+      const art::EDProduct* product = getter ? getter->getIt() : nullptr;
+      const auto* wrapper = dynamic_cast<const art::Wrapper<std::vector<recob::Hit>>*>(product);
+      if (!wrapper || !wrapper->product()) throw cet::exception("EventSource") << "Could not retrieve hit collection of associated hits.\n";
+      return wrapper->product();
+    }
+
+  private:
+    template <typename T>
+    ProductView<T> View(const art::InputTag & tag) const
+    {
+      const auto handle = fEvent.template getValidHandle<std::vector<T>>(tag);
+      ProductView<T> view;
+      view.product = handle.product();
+      view.id = handle.id();
+      return view;
+    }
+
+    template <typename T, typename Q>
+    void FindOne(const std::vector<art::Ptr<Q>> & query, const art::InputTag & tag, std::vector<art::Ptr<T>> & result) const
+    {
+      art::FindOneP<T> association(query, fEvent, tag);
+      result.resize(query.size());
+      for (size_t q=0; q!=query.size(); q++) association.get(q, result[q]);
+    }
+
+    const Event & fEvent;
+  };
+
+} //END namespace AuxEvent
+
+#endif
@@ -33,7 +33,7 @@
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom<>()
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
-#include "larhsn/HsnFinder/DataObjects/DecayVertex.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateBatch.h"
 
 namespace AuxEvent
 {
@@ -45,8 +45,15 @@ namespace AuxEvent
     // Constructor and destructor
     EventTreeFiller();
     virtual ~EventTreeFiller();
+    // Movable, so filled instances can be handed to the tree writer without copying their vectors
+    EventTreeFiller(const EventTreeFiller &) = default;
+    EventTreeFiller(EventTreeFiller &&) = default;
+    EventTreeFiller & operator=(const EventTreeFiller &) = default;
+    EventTreeFiller & operator=(EventTreeFiller &&) = default;
 
     void Initialize(int i_run, int i_subrun, int i_event);
+    // Output columns: calls bind(name, &member) for each of them, in output order. Used by the output trees and the readers.
+    template <typename Binder> void BindFields(Binder & bind);
 
     // General
     int run;
@@ -74,6 +81,27 @@ namespace AuxEvent
     std::vector<bool> isClosestToTruth;
   };
 
+  template <typename Binder>
+  void EventTreeFiller::BindFields(Binder & bind)
+  {
+    bind("run", &run);
+    bind("subrun", &subrun);
+    bind("event", &event);
+    bind("nNeutrinos", &nNeutrinos);
+    bind("neutrinoPdgCode", &neutrinoPdgCode);
+    bind("neutrinoNumDaughters", &neutrinoNumDaughters);
+    bind("neutrinoNumTracks", &neutrinoNumTracks);
+    bind("neutrinoNumShowers", &neutrinoNumShowers);
+    bind("nTwoProngedNeutrinos", &nTwoProngedNeutrinos);
+    bind("nContainedTwoProngedNeutrinos", &nContainedTwoProngedNeutrinos);
+    bind("nHsnCandidates", &nHsnCandidates);
+    bind("truth_vx", &truth_vx);
+    bind("truth_vy", &truth_vy);
+    bind("truth_vz", &truth_vz);
+    bind("recoTruthDistances", &recoTruthDistances);
+    bind("isClosestToTruth", &isClosestToTruth);
+  } // END function BindFields
+
 
 } //END namespace AuxEvent
 
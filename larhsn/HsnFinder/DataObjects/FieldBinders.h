@@ -0,0 +1,104 @@
+/******************************************************************************
+ * @file FieldBinders.h
+ * @brief Binders connecting the output columns of the tree fillers to TTree branches, with streamed or flat layouts
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinderOutput.h CandidateReader.h
+ * ****************************************************************************/
+
+#ifndef FIELDBINDERS_H
+#define FIELDBINDERS_H
+
+// C++ standard libraries
+#include <array>
+#include <string>
+#include <vector>
+#include "TTree.h"
+#include "TLeaf.h"
+
+namespace AuxEvent
+{
+
+  // The fillers list their columns through BindFields(binder), which calls binder(name, &member) for each of them.
+  // Writing and reading go through the same list, so the branches of the output and of the readers always match.
+  // The output is TTree only: the ROOT of the e15 stack (6.08) has no RNTuple, which only exists as ROOT::Experimental from 6.18.
+
+  // Make a branch for each column (writing). The split level only matters for the object columns.
+  struct TreeBranchBinder
+  {
+    explicit TreeBranchBinder(TTree* i_tree, int i_splitLevel = 99) : tree(i_tree), splitLevel(i_splitLevel) {}
+    template <typename T> void operator()(const std::string & name, T* address) {tree->Branch(name.c_str(), address, 32000, splitLevel);}
+    TTree* tree;
+    int splitLevel;
+  };
+
+  // Read each column into the member (reading). Columns missing from the tree are skipped, and left as they are in the filler.
+  struct TreeAddressBinder
+  {
+    explicit TreeAddressBinder(TTree* i_tree) : tree(i_tree) {}
+    template <typename T> void operator()(const std::string & name, T* address)
+    {
+      if (tree->GetBranch(name.c_str())) tree->SetBranchAddress(name.c_str(), address);
+    }
+    TTree* tree;
+  };
+
+  // Flat layouts (no streamed objects): every column is a plain leaf, described by a leaflist.
+  // std::array members are fixed-size leaves, std::vector members are fixed-size leaves too, with the size they have when they are bound.
+  // The vectors must not be resized afterwards, the branches keep the address of their data.
+  template <typename T> struct LeafType;
+  template <> struct LeafType<bool> {static const char* Code() {return "O";}};
+  template <> struct LeafType<short> {static const char* Code() {return "S";}};
+  template <> struct LeafType<int> {static const char* Code() {return "I";}};
+  template <> struct LeafType<float> {static const char* Code() {return "F";}};
+  template <> struct LeafType<double> {static const char* Code() {return "D";}};
+
+  template <typename T>
+  std::string LeafList(const std::string & name, size_t size)
+  {
+    return (size == 1) ? name+"/"+LeafType<T>::Code() : name+"["+std::to_string(size)+"]/"+LeafType<T>::Code();
+  }
+
+  // Make a leaf branch for each column (writing)
+  struct FlatBranchBinder
+  {
+    explicit FlatBranchBinder(TTree* i_tree) : tree(i_tree) {}
+    template <typename T> void operator()(const std::string & name, T* address)
+    {
+      tree->Branch(name.c_str(), address, LeafList<T>(name, 1).c_str());
+    }
+    template <typename T, size_t N> void operator()(const std::string & name, std::array<T,N>* address)
+    {
+      tree->Branch(name.c_str(), address->data(), LeafList<T>(name, N).c_str());
+    }
+    template <typename T> void operator()(const std::string & name, std::vector<T>* address)
+    {
+      tree->Branch(name.c_str(), address->data(), LeafList<T>(name, address->size()).c_str());
+    }
+    TTree* tree;
+  };
+
+  // Read each column of a flat tree into the member (reading). Vectors take the length of their leaf.
+  struct FlatAddressBinder
+  {
+    explicit FlatAddressBinder(TTree* i_tree) : tree(i_tree) {}
+    template <typename T> void operator()(const std::string & name, T* address)
+    {
+      if (tree->GetBranch(name.c_str())) tree->SetBranchAddress(name.c_str(), address);
+    }
+    template <typename T, size_t N> void operator()(const std::string & name, std::array<T,N>* address)
+    {
+      if (tree->GetBranch(name.c_str())) tree->SetBranchAddress(name.c_str(), address->data());
+    }
+    template <typename T> void operator()(const std::string & name, std::vector<T>* address)
+    {
+      TLeaf* leaf = tree->GetLeaf(name.c_str());
+      if (!leaf) return;
+      address->resize(leaf->GetLenStatic());
+      tree->SetBranchAddress(name.c_str(), address->data());
+    }
+    TTree* tree;
+  };
+
+} //END namespace AuxEvent
+
+#endif
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * @file HitGrid.cxx
+ * @brief Per-plane (channel, tick) bucketed grid of the hits of an event, for fast radius searches
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HitGrid.h
+ * ****************************************************************************/
+
+// Hit grid header
+#include "HitGrid.h"
+
+namespace AuxEvent
+{
+  HitGrid::HitGrid() :
+    fInvChannelNorm(1.),
+    fInvTickNorm(1.),
+    fInvCellSize(1.)
+  {}
+  HitGrid::~HitGrid()
+  {}
+
+  void HitGrid::Clear()
+  {
+    // Vectors keep their capacity, so the next event can reuse it
+    for (PlaneGrid & g : fPlanes)
+    {
+      g.nU = 0;
+      g.nV = 0;
+      g.cellOffsets.clear();
+      g.u.clear();
+      g.v.clear();
+      g.charge.clear();
+      g.keys.clear();
+    }
+  } // END function Clear
+
+  void HitGrid::Build(const std::vector<recob::Hit> & hits, double channelNorm, double tickNorm, double cellSize)
+  {
+    /* Counting sort of the hits by cell, in three passes over the collection:
+    1. Coordinates and bounding box of the hits in each plane, which fixes the number of cells.
+    2. Number of hits in each cell, turned into offsets by a prefix sum.
+    3. Scatter of the hit coordinates, charge and index to their cell.
+    */
+    Clear();
+    if (hits.size() > UINT32_MAX) throw cet::exception("HitGrid") << "Hit collection too large for 32-bit indices (" << hits.size() << " hits).\n";
+    fInvChannelNorm = 1./channelNorm;
+    fInvTickNorm = 1./tickNorm;
+    fInvCellSize = 1./cellSize;
+
+    // Bounding box
+    std::array<float,kNumPlanes> maxU, maxV;
+    std::array<uint32_t,kNumPlanes> nHits = {{0,0,0}};
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      fPlanes[p].minU = fPlanes[p].minV = 1e30;
+      maxU[p] = maxV[p] = -1e30;
+    }
+    fHitU.resize(hits.size());
+    fHitV.resize(hits.size());
+    for (size_t i=0; i!=hits.size(); i++)
+    {
+      const recob::Hit & hit = hits[i];
+      int p = (int) hit.View();
+      if (p < 0 || p >= kNumPlanes) continue;
+      const float u = fHitU[i] = hit.Channel()*fInvChannelNorm;
+      const float v = fHitV[i] = (hit.StartTick() + hit.EndTick())/2.*fInvTickNorm;
+      PlaneGrid & g = fPlanes[p];
+      if (u < g.minU) g.minU = u;
+      if (u > maxU[p]) maxU[p] = u;
+      if (v < g.minV) g.minV = v;
+      if (v > maxV[p]) maxV[p] = v;
+      nHits[p]++;
+    }
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      PlaneGrid & g = fPlanes[p];
+      if (nHits[p] == 0) continue;
+      g.nU = (int) ((maxU[p] - g.minU)*fInvCellSize) + 1;
+      g.nV = (int) ((maxV[p] - g.minV)*fInvCellSize) + 1;
+      g.cellOffsets.assign(g.nU*g.nV + 1, 0);
+      g.u.resize(nHits[p]);
+      g.v.resize(nHits[p]);
+      g.charge.resize(nHits[p]);
+      g.keys.resize(nHits[p]);
+    }
+
+    // Count hits in each cell. The cell index uses the same float coordinates and arithmetic as the bounding box,
+    // so a hit on the upper edge gets index nU-1 (nV-1) and never one past the last cell.
+    fCellOfHit.resize(hits.size());
+    for (size_t i=0; i!=hits.size(); i++)
+    {
+      int p = (int) hits[i].View();
+      if (p < 0 || p >= kNumPlanes) continue;
+      PlaneGrid & g = fPlanes[p];
+      int iu = (int) ((fHitU[i] - g.minU)*fInvCellSize);
+      int iv = (int) ((fHitV[i] - g.minV)*fInvCellSize);
+      fCellOfHit[i] = iu*g.nV + iv;
+      g.cellOffsets[fCellOfHit[i]+1]++;
+    }
+    for (PlaneGrid & g : fPlanes)
+    {
+      for (size_t c=1; c<g.cellOffsets.size(); c++) g.cellOffsets[c] += g.cellOffsets[c-1];
+    }
+
+    // Scatter hits to their cell. Each offset is used as insertion cursor, so at the end it points to the start of the next cell and the offsets are shifted back by one.
+    for (size_t i=0; i!=hits.size(); i++)
+    {
+      const recob::Hit & hit = hits[i];
+      int p = (int) hit.View();
+      if (p < 0 || p >= kNumPlanes) continue;
+      PlaneGrid & g = fPlanes[p];
+      uint32_t k = g.cellOffsets[fCellOfHit[i]]++;
+      g.u[k] = fHitU[i];
+      g.v[k] = fHitV[i];
+      g.charge[k] = hit.Integral();
+      g.keys[k] = i;
+    }
+    for (PlaneGrid & g : fPlanes)
+    {
+      if (g.cellOffsets.empty()) continue;
+      for (size_t c=g.cellOffsets.size()-1; c>0; c--) g.cellOffsets[c] = g.cellOffsets[c-1];
+      g.cellOffsets[0] = 0;
+    }
+    return;
+  } // END function Build
+
+  void HitGrid::GetHitsInRadius(int plane, double channel, double tick, double radius, std::vector<GridHit> & result) const
+  {
+    if (plane < 0 || plane >= kNumPlanes) return;
+    const PlaneGrid & g = fPlanes[plane];
+    if (g.nU == 0) return;
+
+    // Range of cells overlapping the square around the circle
+    const float u0 = channel*fInvChannelNorm;
+    const float v0 = tick*fInvTickNorm;
+    const float radius2 = radius*radius;
+    const int iuMin = std::max((int) floorf((u0 - radius - g.minU)*fInvCellSize), 0);
+    const int iuMax = std::min((int) floorf((u0 + radius - g.minU)*fInvCellSize), g.nU-1);
+    const int ivMin = std::max((int) floorf((v0 - radius - g.minV)*fInvCellSize), 0);
+    const int ivMax = std::min((int) floorf((v0 + radius - g.minV)*fInvCellSize), g.nV-1);
+
+    for (int iu=iuMin; iu<=iuMax; iu++)
+    {
+      for (int iv=ivMin; iv<=ivMax; iv++)
+      {
+        const int cell = iu*g.nV + iv;
+        for (uint32_t k=g.cellOffsets[cell]; k!=g.cellOffsets[cell+1]; k++)
+        {
+          const float du = g.u[k] - u0;
+          const float dv = g.v[k] - v0;
+          const float distance2 = du*du + dv*dv;
+          if (distance2 < radius2) result.push_back({g.keys[k], distance2, g.charge[k]});
+        }
+      }
+    }
+    return;
+  } // END function GetHitsInRadius
+
+  void HitGrid::AccumulateProfile(int plane, double channel, double tick, const float* radii2, size_t nRadii, float* profile, std::vector<uint32_t>* keysInMaxRadius) const
+  {
+    if (plane < 0 || plane >= kNumPlanes || nRadii == 0) return;
+    const PlaneGrid & g = fPlanes[plane];
+    if (g.nU == 0) return;
+
+    // Range of cells overlapping the square around the largest circle
+    const float u0 = channel*fInvChannelNorm;
+    const float v0 = tick*fInvTickNorm;
+    const float radius = sqrtf(radii2[nRadii-1]);
+    const int iuMin = std::max((int) floorf((u0 - radius - g.minU)*fInvCellSize), 0);
+    const int iuMax = std::min((int) floorf((u0 + radius - g.minU)*fInvCellSize), g.nU-1);
+    const int ivMin = std::max((int) floorf((v0 - radius - g.minV)*fInvCellSize), 0);
+    const int ivMax = std::min((int) floorf((v0 + radius - g.minV)*fInvCellSize), g.nV-1);
+    if (ivMin > ivMax) return;
+
+    // Cells with the same iu and consecutive iv are contiguous, so each row of cells is a single span of hits for the kernel
+    for (int iu=iuMin; iu<=iuMax; iu++)
+    {
+      const uint32_t first = g.cellOffsets[iu*g.nV + ivMin];
+      const uint32_t last = g.cellOffsets[iu*g.nV + ivMax + 1];
+      HitColumns columns = {g.u.data() + first, g.v.data() + first, g.charge.data() + first, g.keys.data() + first, last - first};
+      AccumulateRadiusProfile(columns, u0, v0, radii2, nRadii, profile, keysInMaxRadius);
+    }
+    return;
+  } // END function AccumulateProfile
+
+  float HitGrid::GetDistance2(const recob::Hit & hit, double channel, double tick) const
+  {
+    const float du = (hit.Channel() - channel)*fInvChannelNorm;
+    const float dv = ((hit.StartTick() + hit.EndTick())/2. - tick)*fInvTickNorm;
+    return du*du + dv*dv;
+  }
+
+  size_t HitGrid::NumHits() const
+  {
+    size_t n = 0;
+    for (const PlaneGrid & g : fPlanes) n += g.keys.size();
+    return n;
+  }
+
+} // END namespace AuxEvent
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * @file HitGrid.h
+ * @brief Per-plane (channel, tick) bucketed grid of the hits of an event, for fast radius searches
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HitGrid.cxx
+ * ****************************************************************************/
+
+#ifndef HITGRID_H
+#define HITGRID_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include "cetlib/exception.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "larhsn/HsnFinder/DataObjects/RadiusProfileKernel.h"
+
+namespace AuxEvent
+{
+
+  // Hit found by a radius search
+  struct GridHit
+  {
+    uint32_t key; // Index of the hit in the collection used to build the grid.
+    float distance2; // Squared distance from the search center (in cm, after channel and tick normalization).
+    float charge; // Integral of the hit.
+  };
+
+  // HitGrid class and functions
+  // Hits are converted to cm (channel/channelNorm, tick/tickNorm) and bucketed by plane in square cells.
+  // Each plane stores its hits sorted by cell, with the offset of the first hit of every cell, so a radius search only visits the cells that overlap the circle.
+  class HitGrid
+  {
+  public:
+    // Constructor and destructor
+    HitGrid();
+    virtual ~HitGrid();
+
+    // Bucket every hit of the collection. cellSize [cm] is best set to the largest radius that will be searched.
+    void Build(const std::vector<recob::Hit> & hits, double channelNorm, double tickNorm, double cellSize);
+    void Clear();
+
+    // Append to result the hits of the plane closer than radius [cm] to (channel, tick)
+    void GetHitsInRadius(int plane, double channel, double tick, double radius, std::vector<GridHit> & result) const;
+
+    // Add to profile[j] the charge of the hits of the plane within sqrt(radii2[j]) of (channel, tick), with the vectorized kernel.
+    // If keysInMaxRadius is not null, the keys of the hits within the last radius are appended to it.
+    void AccumulateProfile(int plane, double channel, double tick, const float* radii2, size_t nRadii, float* profile, std::vector<uint32_t>* keysInMaxRadius) const;
+
+    // Normalized squared distance between a hit and a (channel, tick) point, with the same convention used by the grid
+    float GetDistance2(const recob::Hit & hit, double channel, double tick) const;
+
+    size_t NumHits() const;
+    static constexpr int kNumPlanes = 3;
+
+  private:
+    struct PlaneGrid
+    {
+      float minU = 0., minV = 0.; // Lower corner of the grid (channel and tick direction, cm)
+      int nU = 0, nV = 0; // Number of cells in each direction
+      std::vector<uint32_t> cellOffsets; // Hits of cell (iu,iv) are in [cellOffsets[iu*nV+iv], cellOffsets[iu*nV+iv+1])
+      std::vector<float> u, v, charge; // Hit coordinates and charge, sorted by cell
+      std::vector<uint32_t> keys; // Hit index in the collection, sorted by cell
+    };
+    std::array<PlaneGrid,kNumPlanes> fPlanes;
+    std::vector<uint32_t> fCellOfHit; // Scratch space used by Build.
+    std::vector<float> fHitU, fHitV; // Scratch space used by Build: coordinates of every hit, computed once.
+    float fInvChannelNorm;
+    float fInvTickNorm;
+    float fInvCellSize;
+  };
+
+} //END namespace AuxEvent
+
+#endif
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * @file HitPool.cxx
+ * @brief Per-event pool of compact hit indices shared by all decay vertices
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HitPool.h
+ * ****************************************************************************/
+
+// Hit pool header
+#include "HitPool.h"
+
+namespace AuxEvent
+{
+  HitPool::HitPool()
+  {}
+  HitPool::~HitPool()
+  {}
+
+  void HitPool::Clear()
+  {
+    fProductIDs.clear();
+    fCollections.clear();
+    fIndices.clear();
+  } // END function Clear
+
+  uint32_t HitPool::FindSlot(art::ProductID id) const
+  {
+    for (size_t s=0; s!=fProductIDs.size(); s++)
+    {
+      if (fProductIDs[s] == id) return s;
+    }
+    return fProductIDs.size();
+  }
+
+  uint32_t HitPool::GetSlot(art::ProductID id, const std::vector<recob::Hit>* collection)
+  {
+    uint32_t slot = FindSlot(id);
+    if (slot != fProductIDs.size()) return slot;
+    if (collection->size() > UINT32_MAX) throw cet::exception("HitPool") << "Hit collection too large for 32-bit indices (" << collection->size() << " hits).\n";
+    fProductIDs.push_back(id);
+    fCollections.push_back(collection);
+    return slot;
+  } // END function GetSlot
+
+  HitRange HitPool::AddHits(const EventSource & evt, const std::vector<art::Ptr<recob::Hit>> & hits)
+  {
+    HitRange range;
+    range.begin = fIndices.size();
+    range.end = range.begin;
+    if (hits.empty()) return range;
+
+    // Hits associated to the same object all come from one collection, look it up only once
+    art::ProductID id = hits.front().id();
+    uint32_t slot = FindSlot(id);
+    if (slot == fProductIDs.size()) slot = GetSlot(id, evt.GetHitCollection(hits.front()));
+    range.slot = slot;
+
+    for (auto const& hit : hits)
+    {
+      if (hit.id() != id) throw cet::exception("HitPool") << "Hits from different collections in the same range.\n";
+      fIndices.push_back(hit.key());
+    }
+    range.end = fIndices.size();
+    return range;
+  } // END function AddHits
+
+  HitRange HitPool::AddCollection(const art::ValidHandle<std::vector<recob::Hit>> & hitHandle)
+  {
+    HitRange range;
+    range.slot = GetSlot(hitHandle.id(), hitHandle.product());
+    range.begin = fIndices.size();
+    const uint32_t nHits = hitHandle->size();
+    for (uint32_t i=0; i!=nHits; i++) fIndices.push_back(i);
+    range.end = fIndices.size();
+    return range;
+  } // END function AddCollection
+
+  HitRange HitPool::AddKeys(const art::ValidHandle<std::vector<recob::Hit>> & hitHandle, const std::vector<uint32_t> & keys)
+  {
+    return AddKeys(hitHandle.id(), hitHandle.product(), keys);
+  } // END function AddKeys
+
+  HitRange HitPool::AddKeys(art::ProductID id, const std::vector<recob::Hit>* collection, const std::vector<uint32_t> & keys)
+  {
+    HitRange range;
+    range.slot = GetSlot(id, collection);
+    range.begin = fIndices.size();
+    fIndices.insert(fIndices.end(), keys.begin(), keys.end());
+    range.end = fIndices.size();
+    return range;
+  } // END function AddKeys
+
+  HitView HitPool::GetView(const HitRange & range) const
+  {
+    if (range.empty()) return HitView();
+    const uint32_t* data = fIndices.data();
+    return HitView(fCollections[range.slot]->data(), data + range.begin, data + range.end);
+  }
+
+  size_t HitPool::NumIndices() const {return fIndices.size();}
+  size_t HitPool::NumCollections() const {return fCollections.size();}
+
+} // END namespace AuxEvent
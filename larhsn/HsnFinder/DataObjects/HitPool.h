@@ -0,0 +1,106 @@
+/******************************************************************************
+ * @file HitPool.h
+ * @brief Per-event pool of compact hit indices shared by all decay vertices
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HitPool.cxx
+ * ****************************************************************************/
+
+#ifndef HITPOOL_H
+#define HITPOOL_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <stdint.h>
+#include <iterator>
+#include <vector>
+#include "art/Framework/Principal/Handle.h"
+#include "canvas/Persistency/Common/Ptr.h"
+#include "cetlib/exception.h"
+#include "lardataobj/RecoBase/Hit.h"
+#include "larhsn/HsnFinder/DataObjects/EventSource.h"
+
+namespace AuxEvent
+{
+
+  // Range of hit indices owned by the pool. All hits of a range belong to the same hit collection (slot).
+  struct HitRange
+  {
+    uint32_t slot = 0;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+    size_t size() const {return end - begin;}
+    bool empty() const {return end == begin;}
+  };
+
+  // Zero-copy view over a HitRange. Elements are the recob::Hit objects stored in the event.
+  // A view is only valid until the next hits are added to the pool.
+  class HitView
+  {
+  public:
+    class const_iterator : public std::iterator<std::forward_iterator_tag, recob::Hit>
+    {
+    public:
+      const_iterator(const recob::Hit* hits, const uint32_t* index) : fHits(hits), fIndex(index) {}
+      const recob::Hit & operator*() const {return fHits[*fIndex];}
+      const recob::Hit * operator->() const {return fHits + *fIndex;}
+      const_iterator & operator++() {++fIndex; return *this;}
+      bool operator==(const const_iterator & other) const {return fIndex == other.fIndex;}
+      bool operator!=(const const_iterator & other) const {return fIndex != other.fIndex;}
+    private:
+      const recob::Hit* fHits;
+      const uint32_t* fIndex;
+    };
+
+    HitView() : fHits(nullptr), fFirst(nullptr), fLast(nullptr) {}
+    HitView(const recob::Hit* hits, const uint32_t* first, const uint32_t* last) : fHits(hits), fFirst(first), fLast(last) {}
+    const_iterator begin() const {return const_iterator(fHits, fFirst);}
+    const_iterator end() const {return const_iterator(fHits, fLast);}
+    size_t size() const {return fLast - fFirst;}
+    bool empty() const {return fFirst == fLast;}
+    const recob::Hit & operator[](size_t i) const {return fHits[fFirst[i]];}
+    // Index of the i-th hit in its hit collection (art::Ptr key)
+    uint32_t GetKey(size_t i) const {return fFirst[i];}
+  private:
+    const recob::Hit* fHits;
+    const uint32_t* fFirst;
+    const uint32_t* fLast;
+  };
+
+  // HitPool class and functions
+  // Hits are stored as 32-bit indices into the hit collections of the event (one slot per collection), so a candidate only carries a HitRange instead of vectors of art::Ptr.
+  class HitPool
+  {
+  public:
+    // Constructor and destructor
+    HitPool();
+    virtual ~HitPool();
+
+    // Forget every range and collection, keeping the allocated memory for the next event
+    void Clear();
+
+    // Append hits to the pool and return their range. Hits of different collections are not allowed in the same range.
+    HitRange AddHits(const EventSource & evt, const std::vector<art::Ptr<recob::Hit>> & hits);
+    // Append all hits of a collection (in collection order)
+    HitRange AddCollection(const art::ValidHandle<std::vector<recob::Hit>> & hitHandle);
+    // Append a subset of a collection given by their keys
+    HitRange AddKeys(const art::ValidHandle<std::vector<recob::Hit>> & hitHandle, const std::vector<uint32_t> & keys);
+    // Same, for a collection given by its product ID and contents (e.g. built in memory, outside an art job)
+    HitRange AddKeys(art::ProductID id, const std::vector<recob::Hit>* collection, const std::vector<uint32_t> & keys);
+
+    // Getters
+    HitView GetView(const HitRange & range) const;
+    size_t NumIndices() const;
+    size_t NumCollections() const;
+
+  private:
+    uint32_t GetSlot(art::ProductID id, const std::vector<recob::Hit>* collection);
+    uint32_t FindSlot(art::ProductID id) const;
+
+    std::vector<art::ProductID> fProductIDs; // Product ID of each collection slot
+    std::vector<const std::vector<recob::Hit>*> fCollections; // Hit collection of each slot (owned by the event)
+    std::vector<uint32_t> fIndices; // Hit keys of every range, stored contiguously
+  };
+
+} //END namespace AuxEvent
+
+#endif
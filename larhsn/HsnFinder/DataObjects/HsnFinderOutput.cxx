@@ -0,0 +1,233 @@
+/******************************************************************************
+ * @file HsnFinderOutput.cxx
+ * @brief Output trees of HsnFinder (meta, event, candidate, draw and performance data), shared by the art module and the gallery runner
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinderOutput.h
+ * ****************************************************************************/
+
+#include "HsnFinderOutput.h"
+#include <algorithm>
+#include <utility>
+
+namespace AuxEvent
+{
+  HsnFinderOutput::HsnFinderOutput(fhicl::ParameterSet const & pset) :
+    fInstanceName(pset.get<std::string>("InstanceName")),
+    fIteration(pset.get<int>("Iteration")),
+    fMinTpcBound(pset.get<std::vector<double>>("MinTpcBound")),
+    fMaxTpcBound(pset.get<std::vector<double>>("MaxTpcBound")),
+    fPfpLabel(pset.get<std::string>("PfpLabel")),
+    fHitLabel(pset.get<std::string>("HitLabel")),
+    fMcsLabel(pset.get<std::string>("McsLabel")),
+    fRadiusProfileLimits(pset.get<std::vector<double>>("RadiusProfileLimits")),
+    fRadiusProfileBins(pset.get<int>("RadiusProfileBins")),
+    fChannelNorm(pset.get<double>("ChannelNorm")),
+    fTickNorm(pset.get<double>("TickNorm")),
+    fSaveDrawTree(pset.get<bool>("SaveDrawTree")),
+    fSaveTruthDrawTree(pset.get<bool>("SaveTruthDrawTree")),
+    fUseTruthDistanceMetric(pset.get<bool>("UseTruthDistanceMetric")),
+    fRangeTableMaxRange(pset.get<double>("RangeTableMaxRange")),
+    fRangeTableStep(pset.get<double>("RangeTableStep")),
+    fRangeTableDeviation(0.),
+    fCandidateSchemaVersion(pset.get<int>("CandidateSchemaVersion")),
+    fStageTimers(pset.get<bool>("StageTimers")),
+    fMetaPolicy(pset.get<fhicl::ParameterSet>("OutputPolicy.MetaData")),
+    fEventPolicy(pset.get<fhicl::ParameterSet>("OutputPolicy.EventData")),
+    fCandidatePolicy(pset.get<fhicl::ParameterSet>("OutputPolicy.CandidateData")),
+    fDrawPolicy(pset.get<fhicl::ParameterSet>("OutputPolicy.DrawData")),
+    fNumWrittenEvents(0),
+    fLog(&HsnLog::DefaultLogger()),
+    fDetectorRun(0),
+    fArgonDensity(0.),
+    metaTree(nullptr),
+    detectorTree(nullptr),
+    eventTree(nullptr),
+    candidateTree(nullptr),
+    drawTree(nullptr),
+    performanceTree(nullptr),
+    fWriteTime(0.)
+  {
+    if (fCandidateSchemaVersion != kCandidateSchemaStreamed && fCandidateSchemaVersion != kCandidateSchemaFlat)
+    {
+      throw cet::exception("HsnFinder") << "Unknown CandidateSchemaVersion " << fCandidateSchemaVersion << " (1 or 2).\n";
+    }
+
+    // Determine profile ticks
+    double profileStep = (fRadiusProfileLimits[1] - fRadiusProfileLimits[0]) / float(fRadiusProfileBins);
+    double currTick = fRadiusProfileLimits[0];
+    for (int i=0; i<fRadiusProfileBins; i++)
+    {
+      currTick += profileStep;
+      fProfileTicks.push_back(currTick);
+    }
+  } // END constructor HsnFinderOutput
+
+  HsnFinderOutput::~HsnFinderOutput()
+  {} // END destructor HsnFinderOutput
+
+  void HsnFinderOutput::SetLogger(const HsnLog::Logger* logger)
+  {
+    fLog = logger;
+    return;
+  }
+
+  void HsnFinderOutput::SetRangeTableDeviation(double deviation)
+  {
+    fRangeTableDeviation = deviation;
+    return;
+  }
+
+  void HsnFinderOutput::Open(const TreeMaker & makeTree)
+  {
+    // Meta tree containing fcl file parameters
+    metaTree = makeTree("MetaData");
+    metaTree->Branch("instanceName",&fInstanceName);
+    metaTree->Branch("iteration",&fIteration,"iteration/I");
+    metaTree->Branch("minTpcBound",&fMinTpcBound);
+    metaTree->Branch("maxTpcBound",&fMaxTpcBound);
+    metaTree->Branch("pfpLabel",&fPfpLabel);
+    metaTree->Branch("hitLabel",&fHitLabel);
+    metaTree->Branch("mcsLabel",&fMcsLabel);
+    metaTree->Branch("radiusProfileLimits",&fRadiusProfileLimits);
+    metaTree->Branch("radiusProfileBins",&fRadiusProfileBins);
+    metaTree->Branch("profileTicks",&fProfileTicks);
+    metaTree->Branch("channelNorm",&fChannelNorm,"channelNorm/D");
+    metaTree->Branch("tickNorm",&fTickNorm,"tickNorm/D");
+    metaTree->Branch("saveDrawTree",&fSaveDrawTree,"saveDrawTree/O");
+    metaTree->Branch("rangeTableMaxRange",&fRangeTableMaxRange,"rangeTableMaxRange/D");
+    metaTree->Branch("rangeTableStep",&fRangeTableStep,"rangeTableStep/D");
+    metaTree->Branch("rangeTableDeviation",&fRangeTableDeviation,"rangeTableDeviation/D");
+    metaTree->Branch("candidateSchemaVersion",&fCandidateSchemaVersion,"candidateSchemaVersion/I");
+    metaTree->Branch("stageTimers",&fStageTimers,"stageTimers/O");
+    fMetaPolicy.Apply(metaTree);
+    metaTree->Fill();
+
+    // Tree with the detector description of every run, as given by the services
+    detectorTree = makeTree("DetectorData");
+    detectorTree->Branch("run",&fDetectorRun,"run/I");
+    detectorTree->Branch("argonDensity",&fArgonDensity,"argonDensity/D");
+    detectorTree->Branch("projection",&fProjection);
+    fMetaPolicy.Apply(detectorTree);
+
+    // Tree containing data about current event (the columns of each tree are listed by the BindFields of its filler)
+    eventTree = makeTree("EventData");
+    TreeBranchBinder eventBinder(eventTree, fEventPolicy.GetSplitLevel());
+    etf.BindFields(eventBinder);
+    fEventPolicy.Apply(eventTree);
+
+    // Tree containing data about current HSN candidate
+    candidateTree = makeTree("CandidateData");
+    if (fCandidateSchemaVersion == kCandidateSchemaFlat)
+    {
+      // Plain leaves only: the profile length is fixed for the job
+      cfr.SetNumRadii(fRadiusProfileBins);
+      FlatBranchBinder candidateBinder(candidateTree);
+      cfr.BindFields(candidateBinder, fUseTruthDistanceMetric);
+    }
+    else
+    {
+      TreeBranchBinder candidateBinder(candidateTree, fCandidatePolicy.GetSplitLevel());
+      ctf.BindFields(candidateBinder, fUseTruthDistanceMetric);
+    }
+    fCandidatePolicy.Apply(candidateTree);
+
+    if (fSaveDrawTree)
+    {
+      drawTree = makeTree("DrawData");
+      TreeBranchBinder drawBinder(drawTree, fDrawPolicy.GetSplitLevel());
+      dtf.BindFields(drawBinder, fSaveTruthDrawTree);
+      fDrawPolicy.Apply(drawTree);
+    }
+
+    // Tree with the stage timers and counters of every event
+    if (fStageTimers)
+    {
+      performanceTree = makeTree("Performance");
+      TreeBranchBinder performanceBinder(performanceTree);
+      epf.BindFields(performanceBinder);
+    }
+    return;
+  } // END function Open
+
+  void HsnFinderOutput::WriteDetector(int run, double argonDensity, const std::string & projection)
+  {
+    fDetectorRun = run;
+    fArgonDensity = argonDensity;
+    fProjection = projection;
+    detectorTree->Fill();
+    return;
+  } // END function WriteDetector
+
+  void HsnFinderOutput::Submit(EventRecord && record)
+  {
+    auto t0 = std::chrono::steady_clock::now();
+    // Swap each row into the filler bound to the branches, the record gets the old buffers of the filler
+    for (CandidateTreeFiller & row : record.candidates)
+    {
+      std::swap(ctf, row);
+      if (fCandidateSchemaVersion == kCandidateSchemaFlat) cfr.Set(ctf);
+      candidateTree->Fill();
+    }
+    if (fSaveDrawTree)
+    {
+      for (DrawTreeFiller & row : record.draws)
+      {
+        std::swap(dtf, row);
+        drawTree->Fill();
+      }
+    }
+    std::swap(etf, record.event);
+    eventTree->Fill();
+
+    // Close the clusters at event boundaries
+    fNumWrittenEvents++;
+    fEventPolicy.EndEvent(eventTree, fNumWrittenEvents);
+    fCandidatePolicy.EndEvent(candidateTree, fNumWrittenEvents);
+    if (drawTree) fDrawPolicy.EndEvent(drawTree, fNumWrittenEvents);
+
+    // The performance row ends with the time spent above
+    const double fillTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fWriteTime += fillTime;
+    if (fStageTimers)
+    {
+      epf = record.performance;
+      epf.stageTime[kStageTreeFill] = 1000.*fillTime;
+      performanceTree->Fill();
+      fPerformanceSummary.Add(epf);
+    }
+    return;
+  } // END function Submit
+
+  void HsnFinderOutput::Close(double processTime)
+  {
+    PrintOutputReport(processTime);
+    return;
+  } // END function Close
+
+  void HsnFinderOutput::PrintOutputReport(double processTime) const
+  {
+    // Logged as one block
+    std::string text = "\n--- HsnFinder output report ---\n";
+    text += HsnLog::Format("Event processing: %.2f s\n", processTime);
+    text += HsnLog::Format("Tree filling: %.2f s\n", fWriteTime);
+
+    // Sizes of the trees in the output file, with their pending baskets
+    const TreeIOPolicy defaultPolicy;
+    const std::vector<std::pair<TTree*, const TreeIOPolicy*>> trees = {
+      {metaTree, &fMetaPolicy}, {detectorTree, &fMetaPolicy}, {eventTree, &fEventPolicy}, {candidateTree, &fCandidatePolicy}, {drawTree, &fDrawPolicy}, {performanceTree, &defaultPolicy}};
+    text += HsnLog::Format("%-14s %10s %14s %14s %7s   %s\n", "Tree", "Entries", "Uncompressed", "Compressed", "Ratio", "Policy");
+    for (const auto & tree : trees)
+    {
+      if (!tree.first) continue;
+      tree.first->FlushBaskets();
+      const double totBytes = tree.first->GetTotBytes();
+      const double zipBytes = tree.first->GetZipBytes();
+      text += HsnLog::Format("%-14s %10lld %11.2f MB %11.2f MB %7.2f   %s\n", tree.first->GetName(), (long long) tree.first->GetEntries(), totBytes/1048576., zipBytes/1048576.,
+        (zipBytes > 0.) ? totBytes/zipBytes : 0., tree.second->Describe().c_str());
+    }
+    HSN_INFO(*fLog, "Output", "%s", text.c_str());
+    if (fStageTimers) fPerformanceSummary.Print(*fLog);
+    return;
+  } // END function PrintOutputReport
+
+} // END namespace AuxEvent
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * @file HsnFinderOutput.h
+ * @brief Output trees of HsnFinder (meta, event, candidate, draw and performance data), shared by the art module and the gallery runner
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinderOutput.cxx
+ * ****************************************************************************/
+
+#ifndef HSNFINDEROUTPUT_H
+#define HSNFINDEROUTPUT_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cetlib/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "TROOT.h"
+#include "TTree.h"
+#include "TDirectory.h"
+#include "larhsn/HsnFinder/DataObjects/EventTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/DrawTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateFlatRow.h"
+#include "larhsn/HsnFinder/DataObjects/EventPerformance.h"
+#include "larhsn/HsnFinder/DataObjects/EventRecord.h"
+#include "larhsn/HsnFinder/DataObjects/FieldBinders.h"
+#include "larhsn/HsnFinder/DataObjects/TreeIOPolicy.h"
+#include "larhsn/Logging/HsnLog.h"
+
+namespace AuxEvent
+{
+
+  // HsnFinderOutput class and functions
+  // Configured by the HsnFinder parameter set. Open makes the trees, Submit fills them with the rows of every event (in event order),
+  // and Close logs the output report. WriteDetector records the detector description of every run (DetectorData tree),
+  // which the gallery runner reads back from a module output instead of the services.
+  class HsnFinderOutput
+  {
+  public:
+    // Makes an empty tree with the given name in the output directory
+    using TreeMaker = std::function<TTree*(const char*)>;
+
+    // Constructor and destructor
+    HsnFinderOutput(fhicl::ParameterSet const & pset);
+    virtual ~HsnFinderOutput();
+    HsnFinderOutput(const HsnFinderOutput &) = delete;
+    HsnFinderOutput & operator=(const HsnFinderOutput &) = delete;
+
+    void SetLogger(const HsnLog::Logger* logger);
+    // Recorded in the meta tree, must be set before Open
+    void SetRangeTableDeviation(double deviation);
+
+    // Make the output trees and fill the meta tree
+    void Open(const TreeMaker & makeTree);
+    // Record the argon density and the projection (ProjectionCache::Describe) used for a run, at the start of the run
+    void WriteDetector(int run, double argonDensity, const std::string & projection);
+    // Fill the trees with the rows of an event, in event ID order (the record gets the old buffers of the fillers)
+    void Submit(EventRecord && record);
+    // Log the output report. processTime [s] is the event processing time reported with it.
+    void Close(double processTime);
+
+  private:
+    // Timers, and the compressed and uncompressed size of every output tree
+    void PrintOutputReport(double processTime) const;
+
+    // Fhiclcpp variables (also written to the meta tree)
+    std::string fInstanceName;
+    int fIteration;
+    std::vector<double> fMinTpcBound, fMaxTpcBound;
+    std::string fPfpLabel;
+    std::string fHitLabel;
+    std::string fMcsLabel;
+    std::vector<double> fRadiusProfileLimits;
+    int fRadiusProfileBins;
+    std::vector<float> fProfileTicks;
+    double fChannelNorm;
+    double fTickNorm;
+    bool fSaveDrawTree;
+    bool fSaveTruthDrawTree;
+    bool fUseTruthDistanceMetric;
+    double fRangeTableMaxRange;
+    double fRangeTableStep;
+    double fRangeTableDeviation; // Largest relative deviation from TrackMomentumCalculator found by the validation.
+    int fCandidateSchemaVersion;
+    bool fStageTimers;
+    // Compression, basket, cluster and split settings of each output tree (OutputPolicy)
+    TreeIOPolicy fMetaPolicy;
+    TreeIOPolicy fEventPolicy;
+    TreeIOPolicy fCandidatePolicy;
+    TreeIOPolicy fDrawPolicy;
+    size_t fNumWrittenEvents; // Counts the events of the clusters
+    const HsnLog::Logger* fLog;
+
+    // Detector description of the current run (DetectorData tree)
+    int fDetectorRun;
+    double fArgonDensity;
+    std::string fProjection;
+
+    // Trees in the output directory
+    TTree *metaTree;
+    TTree *detectorTree;
+    TTree *eventTree;
+    TTree *candidateTree;
+    TTree *drawTree;
+    TTree *performanceTree;
+
+    // Tree fillers (bound to the branches)
+    EventTreeFiller etf;
+    CandidateTreeFiller ctf;
+    DrawTreeFiller dtf;
+    CandidateFlatRow cfr; // Bound to the candidate branches instead of ctf with CandidateSchemaVersion 2
+    EventPerformance epf; // Bound to the performance branches (StageTimers)
+
+    // Stage timers [s]
+    double fWriteTime; // Tree filling in Submit
+    PerformanceSummary fPerformanceSummary; // Stage timers of every written event (StageTimers)
+  };
+
+} //END namespace AuxEvent
+
+#endif
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * @file MassHypotheses.h
+ * @brief Compile-time table of the decay hypotheses and kinematics shared by all of them
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  CandidateBatch.h
+ * ****************************************************************************/
+
+#ifndef MASSHYPOTHESES_H
+#define MASSHYPOTHESES_H
+
+#include <stdlib.h>
+#include <math.h>
+#include <array>
+
+namespace AuxVertex
+{
+  // Fixed size storage for quantities defined for each prong (two) or each plane (three)
+  template <typename T> using Prongs = std::array<T,2>;
+  template <typename T> using Planes = std::array<T,3>;
+
+  // Particle masses [GeV]
+  constexpr float kElectronMass = 0.000511;
+  constexpr float kMuonMass = 0.10566;
+  constexpr float kPionMass = 0.13957;
+  constexpr float kProtonMass = 0.93827;
+
+  // A decay hypothesis assigns a particle to the longest and to the shortest prong.
+  // The label is used as suffix of the tree branches (e.g. range_invariantMass_h1).
+  struct MassHypothesis
+  {
+    const char* label;
+    const char* description;
+    int longPdgCode;
+    float longMass;
+    int shortPdgCode;
+    float shortMass;
+  };
+
+  // Table of all the hypotheses evaluated for each candidate. To add a hypothesis append it here, everything else (columns, kinematics, branches) follows.
+  constexpr size_t kNumHypotheses = 5;
+  constexpr std::array<MassHypothesis,kNumHypotheses> kMassHypotheses = {{
+    {"h1", "mu-pi (long muon, short pion)", 13, kMuonMass, 211, kPionMass},
+    {"h2", "pi-mu (long pion, short muon)", 211, kPionMass, 13, kMuonMass},
+    {"h3", "mu-mu", 13, kMuonMass, 13, kMuonMass},
+    {"h4", "e-pi (long electron, short pion)", 11, kElectronMass, 211, kPionMass},
+    {"h5", "p-pi (long proton, short pion)", 2212, kProtonMass, 211, kPionMass}
+  }};
+
+  // Fixed size storage for quantities defined for each hypothesis
+  template <typename T> using Hypotheses = std::array<T,kNumHypotheses>;
+
+  // Kinematics of one candidate under every hypothesis, for one momentum estimate (range, MCS forward, MCS best)
+  struct HypothesisKinematics
+  {
+    Hypotheses<Prongs<float>> prongMomMag, prongEnergy; // Momentum and energy of each prong.
+    Hypotheses<Prongs<float>> prongMomX, prongMomY, prongMomZ; // Components of momentum.
+    Hypotheses<float> totMomX, totMomY, totMomZ; // Momentum component for neutrino.
+    Hypotheses<float> totDirX, totDirY, totDirZ; // Direction components of neutrino
+    Hypotheses<float> totTheta, totPhi; // Direction angles of neutrino
+    Hypotheses<float> totMomMag, totEnergy, invMass; // Total momentum, total energy and invariant mass.
+  };
+
+  // Assign pdg codes and masses of each prong for every hypothesis, given which prong is the longest
+  inline void SetHypothesisMasses(
+    int longProng,
+    Hypotheses<Prongs<int>> & pdgCodes,
+    Hypotheses<Prongs<float>> & masses)
+  {
+    const int shortProng = 1 - longProng;
+    for (size_t h=0; h!=kNumHypotheses; h++)
+    {
+      pdgCodes[h][longProng] = kMassHypotheses[h].longPdgCode;
+      pdgCodes[h][shortProng] = kMassHypotheses[h].shortPdgCode;
+      masses[h][longProng] = kMassHypotheses[h].longMass;
+      masses[h][shortProng] = kMassHypotheses[h].shortMass;
+    }
+  }
+
+  // Compute every kinematic quantity from prong momentum magnitudes (kin.prongMomMag, already filled), masses and prong directions.
+  // All hypotheses are handled in the same loops over fixed size arrays, so the compiler can unroll and vectorize them.
+  inline void ComputeHypothesisKinematics(
+    const Hypotheses<Prongs<float>> & masses,
+    const Prongs<float> & dirX,
+    const Prongs<float> & dirY,
+    const Prongs<float> & dirZ,
+    HypothesisKinematics & kin)
+  {
+    // Prong momentum components and energy
+    for (size_t h=0; h!=kNumHypotheses; h++)
+    {
+      for (size_t p=0; p!=2; p++)
+      {
+        const float mom = kin.prongMomMag[h][p];
+        kin.prongMomX[h][p] = dirX[p]*mom;
+        kin.prongMomY[h][p] = dirY[p]*mom;
+        kin.prongMomZ[h][p] = dirZ[p]*mom;
+        kin.prongEnergy[h][p] = sqrtf(masses[h][p]*masses[h][p] + mom*mom);
+      }
+    }
+    // Total momentum, energy and invariant mass
+    for (size_t h=0; h!=kNumHypotheses; h++)
+    {
+      kin.totMomX[h] = kin.prongMomX[h][0] + kin.prongMomX[h][1];
+      kin.totMomY[h] = kin.prongMomY[h][0] + kin.prongMomY[h][1];
+      kin.totMomZ[h] = kin.prongMomZ[h][0] + kin.prongMomZ[h][1];
+      kin.totMomMag[h] = sqrtf(kin.totMomX[h]*kin.totMomX[h] + kin.totMomY[h]*kin.totMomY[h] + kin.totMomZ[h]*kin.totMomZ[h]);
+      kin.totEnergy[h] = kin.prongEnergy[h][0] + kin.prongEnergy[h][1];
+      kin.invMass[h] = sqrtf(kin.totEnergy[h]*kin.totEnergy[h] - kin.totMomMag[h]*kin.totMomMag[h]);
+      kin.totDirX[h] = kin.totMomX[h]/kin.totMomMag[h];
+      kin.totDirY[h] = kin.totMomY[h]/kin.totMomMag[h];
+      kin.totDirZ[h] = kin.totMomZ[h]/kin.totMomMag[h];
+    }
+    // Total direction angles (not vectorizable, kept in their own loop)
+    for (size_t h=0; h!=kNumHypotheses; h++)
+    {
+      kin.totTheta[h] = acosf(kin.totDirZ[h]);
+      kin.totPhi[h] = atan2f(kin.totDirY[h],kin.totDirX[h]);
+    }
+  } // END function ComputeHypothesisKinematics
+
+} //END namespace AuxVertex
+
+#endif
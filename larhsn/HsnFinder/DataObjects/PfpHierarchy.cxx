@@ -0,0 +1,90 @@
+/******************************************************************************
+ * @file PfpHierarchy.cxx
+ * @brief Parent to children index of the PFParticles in an event
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  PfpHierarchy.h
+ * ****************************************************************************/
+
+// Pfp hierarchy header
+#include "PfpHierarchy.h"
+
+namespace AuxEvent
+{
+  constexpr size_t PfpHierarchy::kInvalidIndex;
+
+  PfpHierarchy::PfpHierarchy()
+  {}
+  PfpHierarchy::~PfpHierarchy()
+  {}
+
+  void PfpHierarchy::Clear()
+  {
+    // Keep the capacity, the index is rebuilt every event
+    fChildOffsets.clear();
+    fChildIndices.clear();
+    fParentIndex.clear();
+    fPrimaries.clear();
+    fSelfToIndex.clear();
+  } // END function Clear
+
+  void PfpHierarchy::Build(const std::vector<recob::PFParticle> & pfps)
+  {
+    /*
+    Build a compressed parent->children index of the pfp collection.
+    Pandora IDs (Self) usually coincide with the position in the collection, but this is not guaranteed, so Self and Parent are first translated to collection indices.
+    Children of each pfp are then stored contiguously (in collection order) so that any traversal of the hierarchy costs linear time in the number of pfps.
+    */
+    Clear();
+    const size_t nPfps = pfps.size();
+
+    // Map Self() to collection index
+    size_t maxSelf = 0;
+    for (const recob::PFParticle & pfp : pfps) maxSelf = std::max(maxSelf, pfp.Self());
+    fSelfToIndex.assign(nPfps==0 ? 0 : maxSelf+1, kInvalidIndex);
+    for (size_t i=0; i!=nPfps; i++) fSelfToIndex[pfps[i].Self()] = i;
+
+    // Find parent index of each pfp and count the children of each parent
+    fParentIndex.assign(nPfps, kInvalidIndex);
+    fChildOffsets.assign(nPfps+1, 0);
+    for (size_t i=0; i!=nPfps; i++)
+    {
+      if (pfps[i].IsPrimary())
+      {
+        fPrimaries.push_back(i);
+        continue;
+      }
+      size_t parent = GetIndexFromSelf(pfps[i].Parent());
+      if (parent == kInvalidIndex) continue;
+      fParentIndex[i] = parent;
+      fChildOffsets[parent+1] += 1;
+    }
+
+    // Turn counts into offsets, then scatter children in their slots
+    for (size_t i=0; i!=nPfps; i++) fChildOffsets[i+1] += fChildOffsets[i];
+    fChildIndices.resize(fChildOffsets[nPfps]);
+    std::vector<size_t> cursor(fChildOffsets.begin(), fChildOffsets.end()-1);
+    for (size_t i=0; i!=nPfps; i++)
+    {
+      size_t parent = fParentIndex[i];
+      if (parent != kInvalidIndex) fChildIndices[cursor[parent]++] = i;
+    }
+  } // END function Build
+
+  // Getters
+  size_t PfpHierarchy::NumParticles() const {return fParentIndex.size();}
+  const std::vector<size_t> & PfpHierarchy::GetPrimaries() const {return fPrimaries;}
+  size_t PfpHierarchy::GetParentIndex(size_t index) const {return fParentIndex[index];}
+
+  PfpIndexRange PfpHierarchy::GetChildren(size_t index) const
+  {
+    const size_t* data = fChildIndices.data();
+    return PfpIndexRange(data + fChildOffsets[index], data + fChildOffsets[index+1]);
+  }
+
+  size_t PfpHierarchy::GetIndexFromSelf(size_t self) const
+  {
+    if (self >= fSelfToIndex.size()) return kInvalidIndex;
+    return fSelfToIndex[self];
+  }
+
+} // END namespace AuxEvent
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * @file PfpHierarchy.h
+ * @brief Parent to children index of the PFParticles in an event
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  PfpHierarchy.cxx
+ * ****************************************************************************/
+
+#ifndef PFPHIERARCHY_H
+#define PFPHIERARCHY_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "lardataobj/RecoBase/PFParticle.h"
+
+namespace AuxEvent
+{
+
+  // Contiguous range of pfp indices (children of a given pfp)
+  class PfpIndexRange
+  {
+  public:
+    PfpIndexRange(const size_t* first, const size_t* last) : fFirst(first), fLast(last) {}
+    const size_t* begin() const {return fFirst;}
+    const size_t* end() const {return fLast;}
+    size_t size() const {return fLast - fFirst;}
+    bool empty() const {return fFirst == fLast;}
+    size_t operator[](size_t i) const {return fFirst[i];}
+  private:
+    const size_t* fFirst;
+    const size_t* fLast;
+  };
+
+  // PfpHierarchy class and functions
+  class PfpHierarchy
+  {
+  public:
+    // Constructor and destructor
+    PfpHierarchy();
+    virtual ~PfpHierarchy();
+
+    // Build the index for a whole pfp collection. Indices refer to positions in that collection.
+    void Build(const std::vector<recob::PFParticle> & pfps);
+    void Clear();
+
+    // Getters
+    size_t NumParticles() const;
+    const std::vector<size_t> & GetPrimaries() const;
+    PfpIndexRange GetChildren(size_t index) const;
+    size_t GetIndexFromSelf(size_t self) const;
+    size_t GetParentIndex(size_t index) const;
+
+    static constexpr size_t kInvalidIndex = std::numeric_limits<size_t>::max();
+
+  private:
+    std::vector<size_t> fChildOffsets; // Compressed adjacency offsets, NumParticles()+1 entries.
+    std::vector<size_t> fChildIndices; // Children of pfp i are in [fChildOffsets[i], fChildOffsets[i+1]).
+    std::vector<size_t> fParentIndex; // Index of the parent of each pfp (kInvalidIndex for primaries and orphans).
+    std::vector<size_t> fPrimaries; // Indices of primary pfps, in collection order.
+    std::vector<size_t> fSelfToIndex; // Map from PFParticle::Self() to collection index.
+  };
+
+} //END namespace AuxEvent
+
+#endif
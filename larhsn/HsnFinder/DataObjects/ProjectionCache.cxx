@@ -0,0 +1,175 @@
+/******************************************************************************
+ * @file ProjectionCache.cxx
+ * @brief Per-run cache of the linear transforms from detector coordinates to (channel, tick) in each plane
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  ProjectionCache.h
+ * ****************************************************************************/
+
+// Projection cache header
+#include "ProjectionCache.h"
+
+namespace AuxEvent
+{
+  constexpr int ProjectionCache::kNumPlanes;
+
+  ProjectionCache::ProjectionCache() :
+    fIsBuilt(false),
+    fValidate(false),
+    fNumValidatedPoints(0),
+    fGeometry(nullptr),
+    fDetectorProperties(nullptr)
+  {}
+  ProjectionCache::~ProjectionCache()
+  {}
+
+  void ProjectionCache::Build(geo::GeometryCore const* geometry, detinfo::DetectorProperties const* detectorProperties, bool validate)
+  {
+    /* Both transforms are linear, so they are fully determined by evaluating the services at a few points:
+    wire coordinate at (y,z) = (0,0), (1,0), (0,1) and tick at x = 0 and x = 100 cm.
+    */
+    fGeometry = geometry;
+    fDetectorProperties = detectorProperties;
+    fValidate = validate;
+    fNumValidatedPoints = 0;
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      const double w00 = geometry->WireCoordinate(0., 0., p, 0, 0);
+      fWireY[p] = geometry->WireCoordinate(1., 0., p, 0, 0) - w00;
+      fWireZ[p] = geometry->WireCoordinate(0., 1., p, 0, 0) - w00;
+      fWireOffset[p] = w00;
+      fFirstChannel[p] = geometry->PlaneWireToChannel(p, 0, 0, 0);
+      fNumWires[p] = geometry->Nwires(geo::PlaneID(0, 0, p));
+
+      const double t0 = detectorProperties->ConvertXToTicks(0., p, 0, 0);
+      fTicksPerCm[p] = (detectorProperties->ConvertXToTicks(100., p, 0, 0) - t0)/100.;
+      fTickOffset[p] = t0;
+    }
+    fIsBuilt = true;
+    return;
+  } // END function Build
+
+  void ProjectionCache::Build(const std::array<PlaneGeometry,3> & planes)
+  {
+    fGeometry = nullptr;
+    fDetectorProperties = nullptr;
+    fValidate = false;
+    fNumValidatedPoints = 0;
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      fWireY[p] = cos(planes[p].wireAngle)/planes[p].wirePitch;
+      fWireZ[p] = sin(planes[p].wireAngle)/planes[p].wirePitch;
+      fWireOffset[p] = planes[p].wireOffset;
+      fFirstChannel[p] = planes[p].firstChannel;
+      fNumWires[p] = planes[p].numWires;
+      fTicksPerCm[p] = planes[p].ticksPerCm;
+      fTickOffset[p] = planes[p].tickOffset;
+    }
+    fIsBuilt = true;
+    return;
+  } // END function Build
+
+  void ProjectionCache::Build(const std::vector<fhicl::ParameterSet> & planes)
+  {
+    if (planes.size() != (size_t) kNumPlanes)
+    {
+      throw cet::exception("ProjectionCache") << "Projection needs " << kNumPlanes << " planes, " << planes.size() << " given.\n";
+    }
+    fGeometry = nullptr;
+    fDetectorProperties = nullptr;
+    fValidate = false;
+    fNumValidatedPoints = 0;
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      fWireY[p] = planes[p].get<double>("WireY");
+      fWireZ[p] = planes[p].get<double>("WireZ");
+      fWireOffset[p] = planes[p].get<double>("WireOffset");
+      fFirstChannel[p] = planes[p].get<int>("FirstChannel");
+      fNumWires[p] = planes[p].get<int>("NumWires");
+      fTicksPerCm[p] = planes[p].get<float>("TicksPerCm");
+      fTickOffset[p] = planes[p].get<float>("TickOffset");
+    }
+    fIsBuilt = true;
+    return;
+  } // END function Build
+
+  std::string ProjectionCache::Describe() const
+  {
+    std::string text = "[";
+    char plane[512];
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      // 17 digits keep the doubles exact, 9 the floats
+      snprintf(plane, sizeof(plane), "%s\n  {WireY: %.17g WireZ: %.17g WireOffset: %.17g FirstChannel: %i NumWires: %i TicksPerCm: %.9g TickOffset: %.9g}",
+        (p == 0) ? "" : ",", fWireY[p], fWireZ[p], fWireOffset[p], fFirstChannel[p], fNumWires[p], fTicksPerCm[p], fTickOffset[p]);
+      text += plane;
+    }
+    text += "\n]";
+    return text;
+  } // END function Describe
+
+  void ProjectionCache::ProjectPoints(const float* x, const float* y, const float* z, size_t n, std::array<int,3>* channels, std::array<float,3>* ticks) const
+  {
+    if (!fIsBuilt)
+    {
+      throw cet::exception("ProjectionCache") << "Projection requested before the cache was built.\n";
+    }
+    // One plane at a time, so the loop over points only has multiply-adds and a rounding
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      const double wireY = fWireY[p], wireZ = fWireZ[p], wireOffset = fWireOffset[p];
+      const float ticksPerCm = fTicksPerCm[p], tickOffset = fTickOffset[p];
+      const double lastWire = fNumWires[p] - 1;
+      const int firstChannel = fFirstChannel[p];
+      for (size_t i=0; i!=n; i++)
+      {
+        const double wire = round(wireY*y[i] + wireZ*z[i] + wireOffset);
+        channels[i][p] = firstChannel + (int) fmin(fmax(wire, 0.), lastWire);
+        ticks[i][p] = ticksPerCm*x[i] + tickOffset;
+      }
+    }
+    if (fValidate)
+    {
+      for (size_t i=0; i!=n; i++)
+      {
+        const float xyz[3] = {x[i], y[i], z[i]};
+        Validate(xyz, channels[i], ticks[i]);
+      }
+    }
+    return;
+  } // END function ProjectPoints
+
+  void ProjectionCache::ProjectPoint(const float* xyz, std::array<int,3> & channels, std::array<float,3> & ticks) const
+  {
+    ProjectPoints(xyz, xyz+1, xyz+2, 1, &channels, &ticks);
+    return;
+  } // END function ProjectPoint
+
+  void ProjectionCache::Validate(const float* xyz, const std::array<int,3> & channels, const std::array<float,3> & ticks) const
+  {
+    for (int p=0; p!=kNumPlanes; p++)
+    {
+      const int channel = fGeometry->NearestChannel(xyz, p);
+      const double tick = fDetectorProperties->ConvertXToTicks(xyz[0], p, 0, 0);
+      // Points exactly between two wires can round either way depending on precision
+      const double wire = fWireY[p]*xyz[1] + fWireZ[p]*xyz[2] + fWireOffset[p];
+      const bool isWireBoundary = fabs(wire - floor(wire) - 0.5) < 1e-3;
+      if ((channel != channels[p] && !isWireBoundary) || fabs(tick - ticks[p]) > 1e-2)
+      {
+        throw cet::exception("ProjectionCache") << "Projection of (" << xyz[0] << "," << xyz[1] << "," << xyz[2] << ") in plane " << p
+          << " gives channel " << channels[p] << ", tick " << ticks[p] << " but the services give channel " << channel << ", tick " << tick << ".\n";
+      }
+    }
+    fNumValidatedPoints++;
+    return;
+  } // END function Validate
+
+  // Getters
+  bool ProjectionCache::IsBuilt() const {return fIsBuilt;}
+  float ProjectionCache::GetWirePitch(int plane) const {return 1./sqrt(fWireY[plane]*fWireY[plane] + fWireZ[plane]*fWireZ[plane]);}
+  float ProjectionCache::GetWireAngle(int plane) const {return atan2(fWireZ[plane], fWireY[plane]);}
+  float ProjectionCache::GetWireOffset(int plane) const {return fWireOffset[plane];}
+  float ProjectionCache::GetTicksPerCm(int plane) const {return fTicksPerCm[plane];}
+  float ProjectionCache::GetTickOffset(int plane) const {return fTickOffset[plane];}
+  size_t ProjectionCache::NumValidatedPoints() const {return fNumValidatedPoints;}
+
+} // END namespace AuxEvent
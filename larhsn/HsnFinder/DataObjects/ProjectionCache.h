@@ -0,0 +1,96 @@
+/******************************************************************************
+ * @file ProjectionCache.h
+ * @brief Per-run cache of the linear transforms from detector coordinates to (channel, tick) in each plane
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  ProjectionCache.cxx
+ * ****************************************************************************/
+
+#ifndef PROJECTIONCACHE_H
+#define PROJECTIONCACHE_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <array>
+#include <string>
+#include <vector>
+#include "cetlib/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "larcorealg/Geometry/geo.h"
+#include "larcore/Geometry/Geometry.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+
+namespace AuxEvent
+{
+
+  // ProjectionCache class and functions
+  // The wire coordinate of a point in a plane is linear in (y,z): w = (y*cos(angle) + z*sin(angle))/pitch + offset, and the drift time is linear in x.
+  // Both are sampled from the Geometry and DetectorProperties services when the cache is built (at every new run), then every conversion is a few multiply-adds.
+  class ProjectionCache
+  {
+  public:
+    // Constructor and destructor
+    ProjectionCache();
+    virtual ~ProjectionCache();
+
+    // Sample the services for cryostat 0, TPC 0. With validate, every later conversion is also done by the services and compared.
+    void Build(geo::GeometryCore const* geometry, detinfo::DetectorProperties const* detectorProperties, bool validate);
+    // Plane described by its wires and drift, in the convention of the getters below
+    struct PlaneGeometry
+    {
+      float wirePitch; // [cm]
+      float wireAngle; // w = (y*cos(angle) + z*sin(angle))/pitch + offset
+      float wireOffset;
+      int firstChannel;
+      int numWires;
+      float ticksPerCm;
+      float tickOffset;
+    };
+    // Build from given planes instead of the services, e.g. in standalone programs (no validation)
+    void Build(const std::array<PlaneGeometry,3> & planes);
+    // Build from the coefficients of another cache, one table per plane as written by Describe:
+    // {WireY WireZ WireOffset FirstChannel NumWires TicksPerCm TickOffset}. The conversions are then exactly the ones of that cache (no validation).
+    void Build(const std::vector<fhicl::ParameterSet> & planes);
+    // The coefficients of the cache as a fhicl sequence, at full precision
+    std::string Describe() const;
+    bool IsBuilt() const;
+
+    // Nearest channel and tick in all the planes for n points given as coordinate arrays.
+    // Results are written as channels[i][plane], ticks[i][plane].
+    void ProjectPoints(const float* x, const float* y, const float* z, size_t n, std::array<int,3>* channels, std::array<float,3>* ticks) const;
+    // Single point version
+    void ProjectPoint(const float* xyz, std::array<int,3> & channels, std::array<float,3> & ticks) const;
+
+    // Getters
+    float GetWirePitch(int plane) const;
+    float GetWireAngle(int plane) const;
+    float GetWireOffset(int plane) const;
+    float GetTicksPerCm(int plane) const;
+    float GetTickOffset(int plane) const;
+    size_t NumValidatedPoints() const;
+
+    static constexpr int kNumPlanes = 3;
+
+  private:
+    // Compare a conversion with the services, throw if they disagree
+    void Validate(const float* xyz, const std::array<int,3> & channels, const std::array<float,3> & ticks) const;
+
+    // Wire coordinate w = fWireY*y + fWireZ*z + fWireOffset (double, since it is rounded to the nearest wire)
+    std::array<double,kNumPlanes> fWireY, fWireZ, fWireOffset;
+    std::array<int,kNumPlanes> fFirstChannel; // Channel of wire 0
+    std::array<int,kNumPlanes> fNumWires;
+    // Tick t = fTicksPerCm*x + fTickOffset
+    std::array<float,kNumPlanes> fTicksPerCm, fTickOffset;
+
+    bool fIsBuilt;
+    bool fValidate;
+    mutable size_t fNumValidatedPoints; // Counted by the (const) conversions
+    geo::GeometryCore const* fGeometry;
+    detinfo::DetectorProperties const* fDetectorProperties;
+  };
+
+} //END namespace AuxEvent
+
+#endif
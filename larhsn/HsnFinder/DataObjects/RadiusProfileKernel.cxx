@@ -0,0 +1,159 @@
+/******************************************************************************
+ * @file RadiusProfileKernel.cxx
+ * @brief Charge within radius profile of a set of hits around a point, with an AVX2 version selected at run time
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  RadiusProfileKernel.h
+ * ****************************************************************************/
+
+// Radius profile kernel header
+#include "RadiusProfileKernel.h"
+#include <algorithm>
+
+// The AVX2 kernel is compiled with a function target attribute, so the rest of the library keeps the default instruction set
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HSN_RADIUS_PROFILE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace AuxEvent
+{
+  void AccumulateRadiusProfile_Scalar(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius)
+  {
+    /* Each hit is added to the first radius containing it (binary search over the squared radii), then a prefix sum turns the per-bin charge into charge within each radius.
+    A hit is inside radius j if its squared distance is strictly smaller than radii2[j].
+    */
+    if (nRadii == 0) return;
+    // Profiles up to kMaxProfileRadii radii (the usual case) are binned on the stack
+    float stackBins[kMaxProfileRadii];
+    std::vector<float> heapBins;
+    float* binCharge = stackBins;
+    if (nRadii > kMaxProfileRadii)
+    {
+      heapBins.resize(nRadii);
+      binCharge = heapBins.data();
+    }
+    std::fill(binCharge, binCharge+nRadii, 0.f);
+    const float maxRadius2 = radii2[nRadii-1];
+    for (size_t i=0; i!=hits.size; i++)
+    {
+      const float du = hits.u[i] - u0;
+      const float dv = hits.v[i] - v0;
+      const float distance2 = du*du + dv*dv;
+      if (!(distance2 < maxRadius2)) continue;
+      binCharge[std::upper_bound(radii2, radii2+nRadii, distance2) - radii2] += hits.charge[i];
+      if (keysInMaxRadius) keysInMaxRadius->push_back(hits.keys[i]);
+    }
+    float cumulative = 0.;
+    for (size_t j=0; j!=nRadii; j++)
+    {
+      cumulative += binCharge[j];
+      profile[j] += cumulative;
+    }
+    return;
+  } // END function AccumulateRadiusProfile_Scalar
+
+#ifdef HSN_RADIUS_PROFILE_AVX2
+  __attribute__((target("avx2")))
+  void AccumulateRadiusProfile_Avx2(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius)
+  {
+    /* Eight hits per iteration: the squared distances are compared with every radius and the charges selected by the comparison mask are added to one accumulator per radius.
+    This gives the cumulative profile directly. Keys within the largest radius are extracted from the bits of its mask. The remaining (size%8) hits go through the scalar kernel.
+    */
+    if (nRadii == 0) return;
+    if (nRadii > kMaxProfileRadii)
+    {
+      AccumulateRadiusProfile_Scalar(hits, u0, v0, radii2, nRadii, profile, keysInMaxRadius);
+      return;
+    }
+    __m256 accumulators[kMaxProfileRadii];
+    __m256 thresholds[kMaxProfileRadii];
+    for (size_t j=0; j!=nRadii; j++)
+    {
+      accumulators[j] = _mm256_setzero_ps();
+      thresholds[j] = _mm256_set1_ps(radii2[j]);
+    }
+    const __m256 center_u = _mm256_set1_ps(u0);
+    const __m256 center_v = _mm256_set1_ps(v0);
+    const __m256 maxThreshold = thresholds[nRadii-1];
+
+    const size_t nVector = hits.size - hits.size%8;
+    for (size_t i=0; i!=nVector; i+=8)
+    {
+      const __m256 du = _mm256_sub_ps(_mm256_loadu_ps(hits.u + i), center_u);
+      const __m256 dv = _mm256_sub_ps(_mm256_loadu_ps(hits.v + i), center_v);
+      const __m256 distance2 = _mm256_add_ps(_mm256_mul_ps(du,du), _mm256_mul_ps(dv,dv));
+      // Skip the radius loop when none of the eight hits is close enough (most of them, for a whole event)
+      int inside = _mm256_movemask_ps(_mm256_cmp_ps(distance2, maxThreshold, _CMP_LT_OQ));
+      if (inside == 0) continue;
+      const __m256 charge = _mm256_loadu_ps(hits.charge + i);
+      for (size_t j=0; j!=nRadii; j++)
+      {
+        const __m256 mask = _mm256_cmp_ps(distance2, thresholds[j], _CMP_LT_OQ);
+        accumulators[j] = _mm256_add_ps(accumulators[j], _mm256_and_ps(mask, charge));
+      }
+      if (keysInMaxRadius)
+      {
+        while (inside)
+        {
+          keysInMaxRadius->push_back(hits.keys[i + __builtin_ctz(inside)]);
+          inside &= inside - 1;
+        }
+      }
+    }
+
+    // Horizontal sums
+    for (size_t j=0; j!=nRadii; j++)
+    {
+      alignas(32) float lanes[8];
+      _mm256_store_ps(lanes, accumulators[j]);
+      profile[j] += ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    }
+
+    // Remainder
+    HitColumns tail = {hits.u + nVector, hits.v + nVector, hits.charge + nVector, hits.keys ? hits.keys + nVector : nullptr, hits.size - nVector};
+    AccumulateRadiusProfile_Scalar(tail, u0, v0, radii2, nRadii, profile, keysInMaxRadius);
+    return;
+  } // END function AccumulateRadiusProfile_Avx2
+
+  bool RadiusProfileHasAvx2()
+  {
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+  }
+#else
+  void AccumulateRadiusProfile_Avx2(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius)
+  {
+    AccumulateRadiusProfile_Scalar(hits, u0, v0, radii2, nRadii, profile, keysInMaxRadius);
+  }
+
+  bool RadiusProfileHasAvx2() {return false;}
+#endif
+
+  void AccumulateRadiusProfile(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius)
+  {
+    if (RadiusProfileHasAvx2()) AccumulateRadiusProfile_Avx2(hits, u0, v0, radii2, nRadii, profile, keysInMaxRadius);
+    else AccumulateRadiusProfile_Scalar(hits, u0, v0, radii2, nRadii, profile, keysInMaxRadius);
+    return;
+  } // END function AccumulateRadiusProfile
+
+} // END namespace AuxEvent
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * @file RadiusProfileKernel.h
+ * @brief Charge within radius profile of a set of hits around a point, with an AVX2 version selected at run time
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  RadiusProfileKernel.cxx
+ * ****************************************************************************/
+
+#ifndef RADIUSPROFILEKERNEL_H
+#define RADIUSPROFILEKERNEL_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+
+namespace AuxEvent
+{
+  // Hit columns read by the kernel. Coordinates are already normalized to cm (channel/channelNorm, tick/tickNorm) and all hits belong to the same plane.
+  struct HitColumns
+  {
+    const float* u; // Channel direction
+    const float* v; // Tick direction
+    const float* charge; // Hit integral
+    const uint32_t* keys; // Hit index in its collection (only read when keysInMaxRadius is requested)
+    size_t size;
+  };
+
+  // Largest number of radii handled by the vectorized kernel (longer profiles use the scalar one)
+  constexpr size_t kMaxProfileRadii = 64;
+
+  // Add to profile[j] the charge of the hits closer than sqrt(radii2[j]) to (u0,v0). radii2 must be increasing.
+  // If keysInMaxRadius is not null, the keys of the hits within the last radius are appended to it.
+  // Dispatches to the AVX2 kernel when the CPU supports it, otherwise to the scalar one.
+  void AccumulateRadiusProfile(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius);
+
+  // Explicit versions, used by the dispatcher and by the benchmarks
+  void AccumulateRadiusProfile_Scalar(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius);
+  void AccumulateRadiusProfile_Avx2(
+    const HitColumns & hits,
+    float u0, float v0,
+    const float* radii2, size_t nRadii,
+    float* profile,
+    std::vector<uint32_t>* keysInMaxRadius);
+
+  // Whether the AVX2 kernel was compiled in and the CPU supports it
+  bool RadiusProfileHasAvx2();
+
+} //END namespace AuxEvent
+
+#endif
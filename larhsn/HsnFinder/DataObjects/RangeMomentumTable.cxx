@@ -0,0 +1,170 @@
+/******************************************************************************
+ * @file RangeMomentumTable.cxx
+ * @brief Precomputed CSDA range to momentum tables for muons, charged pions and protons in liquid argon
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  RangeMomentumTable.h
+ * ****************************************************************************/
+
+#include "RangeMomentumTable.h"
+#include "larreco/RecoAlg/TrackMomentumCalculator.h"
+#include "larhsn/HsnFinder/DataObjects/MassHypotheses.h"
+
+namespace
+{
+  // Bethe-Bloch parameters for liquid argon (PDG, Atomic and nuclear properties of materials)
+  constexpr double kBetheK = 0.307075; // MeV cm2/mol
+  constexpr double kArgonZoverA = 0.45059;
+  constexpr double kArgonExcitation = 188.0e-6; // MeV
+  constexpr double kElectronMassMeV = 0.510999;
+  // Sternheimer density effect parameters
+  constexpr double kDensityC = 5.2146;
+  constexpr double kDensityX0 = 0.2;
+  constexpr double kDensityX1 = 3.0;
+  constexpr double kDensityA = 0.19559;
+  constexpr double kDensityK = 3.0;
+
+  // Mean energy loss [MeV/cm] of a particle with kinetic energy T and mass M (both MeV)
+  double StoppingPower(double T, double M, double density)
+  {
+    const double gamma = 1. + T/M;
+    const double beta2 = 1. - 1./(gamma*gamma);
+    const double bg2 = beta2*gamma*gamma;
+    const double massRatio = kElectronMassMeV/M;
+    const double tMax = 2.*kElectronMassMeV*bg2/(1. + 2.*gamma*massRatio + massRatio*massRatio);
+    const double x = 0.5*log10(bg2);
+    double delta = 0.;
+    if (x >= kDensityX1) delta = 2.*log(10.)*x - kDensityC;
+    else if (x >= kDensityX0) delta = 2.*log(10.)*x - kDensityC + kDensityA*pow(kDensityX1 - x, kDensityK);
+    const double logTerm = 0.5*log(2.*kElectronMassMeV*bg2*tMax/(kArgonExcitation*kArgonExcitation));
+    return density*kBetheK*kArgonZoverA/beta2*(logTerm - beta2 - 0.5*delta);
+  }
+
+  // Momentum [GeV] from kinetic energy and mass [MeV]
+  float MomentumFromKineticEnergy(double T, double M)
+  {
+    return (float) (sqrt(T*T + 2.*M*T)/1000.);
+  }
+}
+
+namespace AuxVertex
+{
+  RangeMomentumTable::RangeMomentumTable() :
+    fMaxRange(0.),
+    fRangeStep(0.),
+    fInvRangeStep(0.),
+    fNumBins(0)
+  {}
+  RangeMomentumTable::~RangeMomentumTable()
+  {}
+
+  void RangeMomentumTable::Build(float maxRange, float rangeStep, float density)
+  {
+    /* Integrate the CSDA range R(T) = int dT/(dE/dx) in small logarithmic steps of kinetic energy and record the momentum every time R crosses the next table entry.
+    The integration starts at betagamma = 0.05, where the Bethe-Bloch formula is still valid. Below it the stopping power grows roughly like 1/T, so R is proportional to T^2.
+    */
+    if (rangeStep <= 0. || maxRange <= rangeStep)
+    {
+      throw cet::exception("RangeMomentumTable") << "Invalid range table binning (max range " << maxRange << " cm, step " << rangeStep << " cm).\n";
+    }
+    fNumBins = (size_t) ceil(maxRange/rangeStep);
+    fRangeStep = rangeStep;
+    fInvRangeStep = 1./rangeStep;
+    fMaxRange = fNumBins*rangeStep;
+
+    const std::array<double,kNumRangeSpecies> masses = {{1000.*kMuonMass, 1000.*kPionMass, 1000.*kProtonMass}};
+    const double logStep = 1e-3;
+    for (size_t s=0; s!=kNumRangeSpecies; s++)
+    {
+      const double M = masses[s];
+      std::vector<float> & table = fMomentum[s];
+      table.assign(fNumBins+1,0.);
+
+      double T = M*(sqrt(1. + 0.05*0.05) - 1.);
+      double R = 0.5*T/StoppingPower(T,M,density);
+      size_t i = 1;
+      for (; i<=fNumBins && i*fRangeStep<=R; i++) table[i] = MomentumFromKineticEnergy(T*sqrt(i*fRangeStep/R),M);
+      while (i<=fNumBins)
+      {
+        const double nextT = T*exp(logStep);
+        const double nextR = R + 0.5*(nextT - T)*(1./StoppingPower(T,M,density) + 1./StoppingPower(nextT,M,density));
+        for (; i<=fNumBins && i*fRangeStep<=nextR; i++)
+        {
+          const double Ti = T + (nextT - T)*(i*fRangeStep - R)/(nextR - R);
+          table[i] = MomentumFromKineticEnergy(Ti,M);
+        }
+        T = nextT;
+        R = nextR;
+      }
+    }
+    return;
+  } // END function Build
+
+  float RangeMomentumTable::Validate(float minRange, float tolerance, const HsnLog::Logger & log) const
+  {
+    /* Compare the tables with TrackMomentumCalculator, which only provides muons (CSDA tables) and protons (fit to CSDA tables).
+    Points where the calculator gives no momentum (outside its own range of validity) are skipped.
+    The pion table has no reference, but it is produced by the same integration as the other two.
+    */
+    if (!IsBuilt())
+    {
+      throw cet::exception("RangeMomentumTable") << "Range tables validated before being built.\n";
+    }
+    trkf::TrackMomentumCalculator tmc;
+    const std::array<RangeSpecies,2> species = {{kRangeMuon, kRangeProton}};
+    const std::array<int,2> pdgCodes = {{13, 2212}};
+    float maxDeviation = 0.;
+    for (size_t k=0; k!=species.size(); k++)
+    {
+      float speciesDeviation = 0., worstRange = 0.;
+      size_t nPoints = 0;
+      for (float range=minRange; range<=fMaxRange; range+=fRangeStep)
+      {
+        double reference = tmc.GetTrackMomentum(range,pdgCodes[k]);
+        if (reference <= 0.) continue;
+        float deviation = fabs(GetMomentum(species[k],range)/reference - 1.);
+        if (deviation > speciesDeviation) {speciesDeviation = deviation; worstRange = range;}
+        nPoints++;
+      }
+      HSN_DEBUG(log, "RangeTable", "Range table (pdg %i): %zu points compared with TrackMomentumCalculator, max relative deviation %.4f at %.1f cm.\n", pdgCodes[k], nPoints, speciesDeviation, worstRange);
+      if (speciesDeviation > tolerance)
+      {
+        throw cet::exception("RangeMomentumTable") << "Range table for pdg " << pdgCodes[k] << " deviates from TrackMomentumCalculator by " << speciesDeviation << " at " << worstRange << " cm (tolerance " << tolerance << ").\n";
+      }
+      if (speciesDeviation > maxDeviation) maxDeviation = speciesDeviation;
+    }
+    return maxDeviation;
+  } // END function Validate
+
+  // Getters
+  bool RangeMomentumTable::IsBuilt() const {return fNumBins > 0;}
+  float RangeMomentumTable::GetMaxRange() const {return fMaxRange;}
+  float RangeMomentumTable::GetRangeStep() const {return fRangeStep;}
+
+  RangeSpecies RangeMomentumTable::SpeciesFromPdg(int pdgCode)
+  {
+    // Electrons (and anything else without a table) use the muon table: a short track is treated as a minimum ionizing particle.
+    switch (abs(pdgCode))
+    {
+      case 211: return kRangePion;
+      case 2212: return kRangeProton;
+      default: return kRangeMuon;
+    }
+  } // END function SpeciesFromPdg
+
+  void RangeMomentumTable::GetMomenta(RangeSpecies species, const float* ranges, float* momenta, size_t n) const
+  {
+    const float* table = fMomentum[species].data();
+    const float lastBin = (float) (fNumBins-1);
+    for (size_t i=0; i!=n; i++)
+    {
+      const float range = ranges[i];
+      const float x = fminf(fmaxf(range*fInvRangeStep,0.f),(float) fNumBins);
+      const float bin = fminf(floorf(x),lastBin);
+      const size_t j = (size_t) bin;
+      const float momentum = table[j] + (x - bin)*(table[j+1] - table[j]);
+      momenta[i] = (range > 0.f && range <= fMaxRange) ? momentum : -1.f;
+    }
+    return;
+  } // END function GetMomenta
+
+} // END namespace AuxVertex
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * @file RangeMomentumTable.h
+ * @brief Precomputed CSDA range to momentum tables for muons, charged pions and protons in liquid argon
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  RangeMomentumTable.cxx
+ * ****************************************************************************/
+
+#ifndef RANGEMOMENTUMTABLE_H
+#define RANGEMOMENTUMTABLE_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <array>
+#include <vector>
+#include "cetlib/exception.h"
+#include "larhsn/Logging/HsnLog.h"
+
+namespace AuxVertex
+{
+  // Particles with a range table
+  enum RangeSpecies
+  {
+    kRangeMuon = 0,
+    kRangePion = 1,
+    kRangeProton = 2,
+    kNumRangeSpecies = 3
+  };
+
+  // RangeMomentumTable class and functions
+  // Built once per job by integrating the Bethe-Bloch stopping power of liquid argon (CSDA approximation).
+  // Each table stores the momentum at uniformly spaced ranges, so a lookup is one multiplication, one truncation and a linear interpolation.
+  class RangeMomentumTable
+  {
+  public:
+    // Constructor and destructor
+    RangeMomentumTable();
+    virtual ~RangeMomentumTable();
+
+    // Fill the tables for ranges in [0,maxRange] cm, with one entry every rangeStep cm
+    void Build(float maxRange, float rangeStep, float density);
+    // Compare the muon and proton tables with trkf::TrackMomentumCalculator between minRange and the end of the table.
+    // Throws if the relative deviation is larger than tolerance anywhere, otherwise returns the largest deviation found (logged at Debug level).
+    float Validate(float minRange, float tolerance, const HsnLog::Logger & log) const;
+
+    // Getters
+    bool IsBuilt() const;
+    float GetMaxRange() const;
+    float GetRangeStep() const;
+    static RangeSpecies SpeciesFromPdg(int pdgCode);
+
+    // Momentum [GeV] of a stopping particle with given range [cm]. Returns -1 outside (0,maxRange], like TrackMomentumCalculator.
+    inline float GetMomentum(RangeSpecies species, float range) const
+    {
+      if (!(range > 0.f && range <= fMaxRange)) return -1.f;
+      const float* table = fMomentum[species].data();
+      const float x = range*fInvRangeStep;
+      size_t bin = (size_t) x;
+      if (bin >= fNumBins) bin = fNumBins-1;
+      const float frac = x - (float) bin;
+      return table[bin] + frac*(table[bin+1] - table[bin]);
+    }
+    // Momenta for n ranges at once (no branches in the loop, so it can be vectorized)
+    void GetMomenta(RangeSpecies species, const float* ranges, float* momenta, size_t n) const;
+
+  private:
+    float fMaxRange;
+    float fRangeStep;
+    float fInvRangeStep;
+    size_t fNumBins; // Each table has fNumBins+1 entries, at ranges i*fRangeStep.
+    std::array<std::vector<float>,kNumRangeSpecies> fMomentum;
+  };
+
+} //END namespace AuxVertex
+
+#endif
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * @file TrajectoryBatch.cxx
+ * @brief Trajectory points of many tracks in contiguous coordinate columns, with a batch search of where each trajectory leaves a box
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  TrajectoryBatch.h
+ * ****************************************************************************/
+
+// Trajectory batch header
+#include "TrajectoryBatch.h"
+
+namespace AuxEvent
+{
+  TrajectoryBatch::TrajectoryBatch()
+  {
+    fOffsets.push_back(0);
+  }
+  TrajectoryBatch::~TrajectoryBatch()
+  {}
+
+  void TrajectoryBatch::Clear()
+  {
+    fX.clear();
+    fY.clear();
+    fZ.clear();
+    fOffsets.assign(1, 0);
+  } // END function Clear
+
+  void TrajectoryBatch::AddPoint(float x, float y, float z)
+  {
+    fX.push_back(x);
+    fY.push_back(y);
+    fZ.push_back(z);
+    return;
+  }
+
+  void TrajectoryBatch::EndTrajectory()
+  {
+    if (fX.size() > UINT32_MAX) throw cet::exception("TrajectoryBatch") << "Too many trajectory points for 32-bit offsets (" << fX.size() << " points).\n";
+    fOffsets.push_back(fX.size());
+    return;
+  }
+
+  void TrajectoryBatch::FindExits(const std::vector<double> & minBound, const std::vector<double> & maxBound, std::vector<TrajectoryExit> & exits) const
+  {
+    /* Each trajectory is scanned backwards in blocks of kBlock points. The box test of a block has no branches, so it is vectorized,
+    and the bits of the points inside are collected in a mask: the highest bit of the first non-empty mask is the last point inside.
+    Contained trajectories stop at the first block. The exit is then the intersection of the segment leaving the last point inside
+    with the box surface (slab method: the smallest parameter at which the segment reaches a face it is moving towards).
+    */
+    static constexpr uint32_t kBlock = 16;
+    const float minX = minBound[0], minY = minBound[1], minZ = minBound[2];
+    const float maxX = maxBound[0], maxY = maxBound[1], maxZ = maxBound[2];
+    const size_t nTrajectories = NumTrajectories();
+    exits.resize(nTrajectories);
+
+    for (size_t t=0; t!=nTrajectories; t++)
+    {
+      const uint32_t begin = fOffsets[t];
+      const uint32_t end = fOffsets[t+1];
+      TrajectoryExit & exit = exits[t];
+      exit.lastInside = -1;
+
+      // Last point inside the box
+      uint32_t blockEnd = end;
+      while (blockEnd > begin && exit.lastInside < 0)
+      {
+        const uint32_t blockBegin = (blockEnd - begin > kBlock) ? blockEnd - kBlock : begin;
+        uint32_t mask = 0;
+        for (uint32_t i=blockBegin; i!=blockEnd; i++)
+        {
+          const bool inside = (fX[i]>minX) & (fX[i]<maxX) & (fY[i]>minY) & (fY[i]<maxY) & (fZ[i]>minZ) & (fZ[i]<maxZ);
+          mask |= (uint32_t) inside << (i - blockBegin);
+        }
+        if (mask) exit.lastInside = blockBegin + (31 - __builtin_clz(mask)) - begin;
+        blockEnd = blockBegin;
+      }
+      if (exit.lastInside < 0)
+      {
+        if (begin != end) exit.xyz = {{fX[begin], fY[begin], fZ[begin]}};
+        continue;
+      }
+
+      // Crossing of the box surface by the following segment
+      const uint32_t i = begin + exit.lastInside;
+      const float point[3] = {fX[i], fY[i], fZ[i]};
+      exit.xyz = {{point[0], point[1], point[2]}};
+      if (i+1 == end) continue;
+      const float direction[3] = {fX[i+1] - point[0], fY[i+1] - point[1], fZ[i+1] - point[2]};
+      const float boxMin[3] = {minX, minY, minZ};
+      const float boxMax[3] = {maxX, maxY, maxZ};
+      float tExit = 1.;
+      for (int a=0; a!=3; a++)
+      {
+        if (direction[a] > 0.) tExit = fminf(tExit, (boxMax[a] - point[a])/direction[a]);
+        else if (direction[a] < 0.) tExit = fminf(tExit, (boxMin[a] - point[a])/direction[a]);
+      }
+      for (int a=0; a!=3; a++) exit.xyz[a] = point[a] + tExit*direction[a];
+    }
+    return;
+  } // END function FindExits
+
+  // Getters
+  size_t TrajectoryBatch::NumTrajectories() const {return fOffsets.size() - 1;}
+  size_t TrajectoryBatch::NumPoints(size_t t) const {return fOffsets[t+1] - fOffsets[t];}
+  std::array<float,3> TrajectoryBatch::GetPoint(size_t t, size_t j) const
+  {
+    const size_t i = fOffsets[t] + j;
+    return {{fX[i], fY[i], fZ[i]}};
+  }
+
+} // END namespace AuxEvent
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * @file TrajectoryBatch.h
+ * @brief Trajectory points of many tracks in contiguous coordinate columns, with a batch search of where each trajectory leaves a box
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  TrajectoryBatch.cxx
+ * ****************************************************************************/
+
+#ifndef TRAJECTORYBATCH_H
+#define TRAJECTORYBATCH_H
+
+// C++ standard libraries
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <array>
+#include <vector>
+#include "cetlib/exception.h"
+
+namespace AuxEvent
+{
+
+  // Where a trajectory leaves the box
+  struct TrajectoryExit
+  {
+    int lastInside; // Index (within the trajectory) of the last point inside the box, -1 if no point is inside.
+    std::array<float,3> xyz; // Point where the segment after the last point inside crosses the box surface. The last point itself if the trajectory ends inside.
+  };
+
+  // TrajectoryBatch class and functions
+  // The points of all trajectories are appended to the same x, y, z columns and each trajectory is a range of them, so the containment tests run over contiguous floats.
+  // Columns keep their capacity after Clear, so a batch reused across events stops allocating once it has seen its largest event.
+  class TrajectoryBatch
+  {
+  public:
+    // Constructor and destructor
+    TrajectoryBatch();
+    virtual ~TrajectoryBatch();
+
+    void Clear();
+    // Points are added to the current trajectory, which is closed by EndTrajectory
+    void AddPoint(float x, float y, float z);
+    void EndTrajectory();
+
+    // For each trajectory, the last point strictly inside the box (minBound, maxBound) and the exact crossing of the box surface by the following segment
+    void FindExits(const std::vector<double> & minBound, const std::vector<double> & maxBound, std::vector<TrajectoryExit> & exits) const;
+
+    // Getters
+    size_t NumTrajectories() const;
+    size_t NumPoints(size_t t) const;
+    std::array<float,3> GetPoint(size_t t, size_t j) const;
+
+  private:
+    std::vector<float> fX, fY, fZ;
+    std::vector<uint32_t> fOffsets; // First point of each trajectory, followed by the end of the last one
+  };
+
+} //END namespace AuxEvent
+
+#endif
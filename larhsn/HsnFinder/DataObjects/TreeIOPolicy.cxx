@@ -0,0 +1,118 @@
+/******************************************************************************
+ * @file TreeIOPolicy.cxx
+ * @brief Compression, basket, cluster and split settings of one output tree, read from fhicl
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  TreeIOPolicy.h
+ * ****************************************************************************/
+
+#include "TreeIOPolicy.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+
+// Since ROOT 6.14 FlushBaskets also closes a cluster, before that only AutoFlush did
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,14,0)
+#define HSN_FLUSH_CLOSES_CLUSTER 1
+#endif
+
+namespace AuxEvent
+{
+  // ROOT defaults
+  TreeIOPolicy::TreeIOPolicy() :
+    fCompression("Default"),
+    fLevel(1),
+    fBasketSize(32000),
+    fAutoFlushEvents(0),
+    fSplitLevel(99)
+  {}
+
+  TreeIOPolicy::TreeIOPolicy(fhicl::ParameterSet const & pset) :
+    fCompression(pset.get<std::string>("Compression")),
+    fLevel(pset.get<int>("Level")),
+    fBasketSize(pset.get<int>("BasketSize")),
+    fAutoFlushEvents(pset.get<int>("AutoFlushEvents")),
+    fSplitLevel(pset.get<int>("SplitLevel"))
+  {
+    if (fLevel < 1 || fLevel > 9) throw cet::exception("TreeIOPolicy") << "Compression level " << fLevel << " out of range (1 to 9).\n";
+    if (fBasketSize <= 0) throw cet::exception("TreeIOPolicy") << "Basket size " << fBasketSize << " must be positive.\n";
+    if (fAutoFlushEvents < 0) throw cet::exception("TreeIOPolicy") << "AutoFlushEvents " << fAutoFlushEvents << " must not be negative.\n";
+    GetCompressionSettings(); // Checks the algorithm
+  } // END constructor TreeIOPolicy
+
+  TreeIOPolicy::~TreeIOPolicy()
+  {}
+
+  int TreeIOPolicy::GetCompressionSettings() const
+  {
+    // Algorithm numbers of ROOT::ECompressionAlgorithm
+    if (fCompression == "Default") return -1;
+    if (fCompression == "ZLIB") return 100 + fLevel;
+    if (fCompression == "LZMA") return 200 + fLevel;
+    if (fCompression == "LZ4")
+    {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0)
+      return 400 + fLevel;
+#else
+      throw cet::exception("TreeIOPolicy") << "LZ4 compression needs ROOT 6.10 or later.\n";
+#endif
+    }
+    if (fCompression == "ZSTD")
+    {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,20,0)
+      return 500 + fLevel;
+#else
+      throw cet::exception("TreeIOPolicy") << "ZSTD compression needs ROOT 6.20 or later.\n";
+#endif
+    }
+    throw cet::exception("TreeIOPolicy") << "Unknown compression algorithm " << fCompression << ".\n";
+  } // END function GetCompressionSettings
+
+  void TreeIOPolicy::Apply(TTree* tree) const
+  {
+    // Compression is a branch setting, the sub-branches follow their parent
+    const int settings = GetCompressionSettings();
+    if (settings >= 0)
+    {
+      TObjArray* branches = tree->GetListOfBranches();
+      for (int b=0; b!=branches->GetEntriesFast(); b++) ((TBranch*) branches->At(b))->SetCompressionSettings(settings);
+    }
+    tree->SetBasketSize("*", fBasketSize);
+    if (fAutoFlushEvents > 0)
+    {
+#ifdef HSN_FLUSH_CLOSES_CLUSTER
+      // Clusters are closed by EndEvent
+      tree->SetAutoFlush(0);
+#else
+      // Nearest approximation: clusters of as many entries (exact for the per-event trees)
+      tree->SetAutoFlush(fAutoFlushEvents);
+#endif
+    }
+    return;
+  } // END function Apply
+
+  void TreeIOPolicy::EndEvent(TTree* tree, size_t nEvents) const
+  {
+#ifdef HSN_FLUSH_CLOSES_CLUSTER
+    if (fAutoFlushEvents > 0 && nEvents % fAutoFlushEvents == 0) tree->FlushBaskets();
+#else
+    (void) tree;
+    (void) nEvents;
+#endif
+    return;
+  } // END function EndEvent
+
+  std::string TreeIOPolicy::Describe() const
+  {
+    char description[128];
+    snprintf(description, sizeof(description), "%s-%d, baskets %d B, %s, split %d", fCompression.c_str(), fLevel, fBasketSize,
+      (fAutoFlushEvents > 0) ? (std::to_string(fAutoFlushEvents)+" events/cluster").c_str() : "default clusters", fSplitLevel);
+    return description;
+  } // END function Describe
+
+  // Getters
+  const std::string & TreeIOPolicy::GetCompression() const {return fCompression;}
+  int TreeIOPolicy::GetLevel() const {return fLevel;}
+  int TreeIOPolicy::GetBasketSize() const {return fBasketSize;}
+  int TreeIOPolicy::GetAutoFlushEvents() const {return fAutoFlushEvents;}
+  int TreeIOPolicy::GetSplitLevel() const {return fSplitLevel;}
+
+} // END namespace AuxEvent
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * @file TreeIOPolicy.h
+ * @brief Compression, basket, cluster and split settings of one output tree, read from fhicl
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  TreeIOPolicy.cxx
+ * ****************************************************************************/
+
+#ifndef TREEIOPOLICY_H
+#define TREEIOPOLICY_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include "cetlib/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "RVersion.h"
+#include "TTree.h"
+
+namespace AuxEvent
+{
+
+  // TreeIOPolicy class and functions
+  // Configuration table:
+  //   Compression:     "Default" (the setting of the output file), "ZLIB", "LZ4", "ZSTD" (ROOT 6.20 or later) or "LZMA"
+  //   Level:           compression level, 1 to 9
+  //   BasketSize:      initial basket size of every branch [bytes]
+  //   AutoFlushEvents: events per cluster, the baskets of the tree are flushed together every that many events. 0 keeps the ROOT default (30 MB).
+  //   SplitLevel:      split level of the object branches
+  class TreeIOPolicy
+  {
+  public:
+    // Constructor and destructor
+    TreeIOPolicy();
+    explicit TreeIOPolicy(fhicl::ParameterSet const & pset);
+    virtual ~TreeIOPolicy();
+
+    // Apply compression, basket size and cluster settings to a tree whose branches are all made
+    void Apply(TTree* tree) const;
+    // Called after the rows of every event are filled: closes a cluster every AutoFlushEvents events
+    void EndEvent(TTree* tree, size_t nEvents) const;
+
+    // Getters
+    const std::string & GetCompression() const;
+    int GetLevel() const;
+    int GetBasketSize() const;
+    int GetAutoFlushEvents() const;
+    int GetSplitLevel() const;
+    // ROOT compression settings (100*algorithm + level), -1 for the file default
+    int GetCompressionSettings() const;
+    std::string Describe() const;
+
+  private:
+    std::string fCompression;
+    int fLevel;
+    int fBasketSize;
+    int fAutoFlushEvents;
+    int fSplitLevel;
+  };
+
+} //END namespace AuxEvent
+
+#endif
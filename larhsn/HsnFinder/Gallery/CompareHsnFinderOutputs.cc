@@ -0,0 +1,228 @@
+/******************************************************************************
+ * @file CompareHsnFinderOutputs.cc
+ * @brief Compares the event, candidate and draw trees of two HsnFinder outputs, e.g. of the module and of the gallery runner
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinderGallery.cc hsnFinderGallery.fcl
+ *
+ * Usage: CompareHsnFinderOutputs <reference.root> <output.root> [module directory]
+ * The DetectorData, EventData, CandidateData and DrawData trees are compared. Both files are read entry by entry through the BindFields
+ * column lists of the fillers, so every column is compared with its own type.
+ * Floating point columns must be identical (NaN equals NaN). MetaData and Performance are not compared, they hold the job settings and timers.
+ * The exit status is 0 if the trees are identical, 1 otherwise.
+ *   lar -c hsnFinder_mc.fcl -s reference.root
+ *   HsnFinderGallery -c hsnFinderGallery.fcl -o HsnFinderGallery_hist.root reference.root   (DetectorFrom: "HsnFinder_hist.root")
+ *   CompareHsnFinderOutputs HsnFinder_hist.root HsnFinderGallery_hist.root
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TTree.h"
+
+// framework includes
+#include "cetlib/exception.h"
+
+// HSN finder includes
+#include "larhsn/HsnFinder/DataObjects/EventTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/DrawTreeFiller.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateFlatRow.h"
+#include "larhsn/HsnFinder/DataObjects/CandidateReader.h"
+#include "larhsn/HsnFinder/DataObjects/FieldBinders.h"
+
+// larhsn includes
+#include "larhsn/FileLocationDatabase/Index/ToolHelpers.h"
+
+namespace
+{
+  constexpr size_t kMaxPrintedDifferences = 20;
+
+  // Exact comparison of the column values, NaN equals NaN
+  template <typename T> bool Equal(const T & a, const T & b) {return a == b;}
+  inline bool Equal(float a, float b) {return a == b || (a != a && b != b);}
+  inline bool Equal(double a, double b) {return a == b || (a != a && b != b);}
+  template <typename T> bool Equal(const std::vector<T> & a, const std::vector<T> & b);
+  template <typename T, size_t N> bool Equal(const std::array<T,N> & a, const std::array<T,N> & b);
+  template <typename T> bool Equal(const std::vector<T> & a, const std::vector<T> & b)
+  {
+    if (a.size() != b.size()) return false;
+    for (size_t i=0; i!=a.size(); i++) if (!Equal(a[i], b[i])) return false;
+    return true;
+  }
+  template <typename T, size_t N> bool Equal(const std::array<T,N> & a, const std::array<T,N> & b)
+  {
+    for (size_t i=0; i!=N; i++) if (!Equal(a[i], b[i])) return false;
+    return true;
+  }
+
+  // Binder keeping the address of every column of the reference filler
+  struct ColumnAddresses
+  {
+    template <typename T> void operator()(const std::string &, T* address) {addresses.push_back(address);}
+    std::vector<const void*> addresses;
+  };
+
+  // Binder comparing every column of a filler with the same column of the reference, bound in the same order
+  struct ColumnComparer
+  {
+    explicit ColumnComparer(const ColumnAddresses & i_reference) : reference(i_reference), next(0) {}
+    template <typename T> void operator()(const std::string & name, T* address)
+    {
+      if (!Equal(*static_cast<const T*>(reference.addresses[next++]), *address)) differences.push_back(name);
+    }
+    const ColumnAddresses & reference;
+    size_t next;
+    std::vector<std::string> differences;
+  };
+
+  // Row of the DetectorData tree (HsnFinderOutput::WriteDetector)
+  struct DetectorRow
+  {
+    int run = 0;
+    double argonDensity = 0.;
+    std::string projection;
+    template <typename Binder> void BindFields(Binder & bind)
+    {
+      bind("run", &run);
+      bind("argonDensity", &argonDensity);
+      bind("projection", &projection);
+    }
+  };
+
+  // Differences found in one tree
+  struct TreeComparison
+  {
+    long long referenceEntries = 0;
+    long long entries = 0;
+    size_t differentEntries = 0;
+    size_t printed = 0;
+    bool IsIdentical() const {return referenceEntries == entries && differentEntries == 0;}
+  };
+
+  // Compare the rows of an entry (bind(filler, binder) lists the columns of a filler), the first differences are printed
+  template <typename Filler, typename Bind>
+  void CompareEntry(const char* treeName, long long entry, Filler & reference, Filler & row, const Bind & bind, TreeComparison & comparison)
+  {
+    ColumnAddresses addresses;
+    bind(reference, addresses);
+    ColumnComparer comparer(addresses);
+    bind(row, comparer);
+    if (comparer.differences.empty()) return;
+    comparison.differentEntries++;
+    if (comparison.printed == kMaxPrintedDifferences) return;
+    comparison.printed++;
+    std::string columns;
+    for (const std::string & name : comparer.differences) columns += (columns.empty() ? "" : ", ") + name;
+    printf("%s entry %lld differs: %s\n", treeName, entry, columns.c_str());
+    return;
+  }
+
+  // Trees read into fillers bound with TreeAddressBinder (event and draw data)
+  template <typename Filler, typename Bind>
+  TreeComparison CompareTree(const char* treeName, TDirectory & referenceDirectory, TDirectory & directory, const Bind & bind)
+  {
+    TreeComparison comparison;
+    TTree* referenceTree = nullptr;
+    TTree* tree = nullptr;
+    referenceDirectory.GetObject(treeName, referenceTree);
+    directory.GetObject(treeName, tree);
+    if (!referenceTree || !tree)
+    {
+      if (referenceTree || tree) throw cet::exception("CompareHsnFinderOutputs") << treeName << " is only in one of the files.\n";
+      return comparison;
+    }
+    Filler reference, row;
+    AuxEvent::TreeAddressBinder referenceBinder(referenceTree), binder(tree);
+    bind(reference, referenceBinder);
+    bind(row, binder);
+    comparison.referenceEntries = referenceTree->GetEntries();
+    comparison.entries = tree->GetEntries();
+    for (long long i=0; i<std::min(comparison.referenceEntries, comparison.entries); i++)
+    {
+      referenceTree->GetEntry(i);
+      tree->GetEntry(i);
+      CompareEntry(treeName, i, reference, row, bind, comparison);
+    }
+    referenceTree->ResetBranchAddresses();
+    tree->ResetBranchAddresses();
+    return comparison;
+  }
+
+  // Candidate data, with either schema version
+  TreeComparison CompareCandidates(TDirectory & referenceDirectory, TDirectory & directory)
+  {
+    TreeComparison comparison;
+    AuxEvent::CandidateReader referenceReader(referenceDirectory), reader(directory);
+    const bool withTruthDistance = referenceReader.HasTruthDistance();
+    if (reader.HasTruthDistance() != withTruthDistance) throw cet::exception("CompareHsnFinderOutputs") << "Only one of the files has the truth distance columns.\n";
+    auto bind = [withTruthDistance](AuxEvent::CandidateFlatRow & row, auto & binder) {row.BindFields(binder, withTruthDistance);};
+    AuxEvent::CandidateFlatRow reference, row;
+    comparison.referenceEntries = referenceReader.GetEntries();
+    comparison.entries = reader.GetEntries();
+    for (long long i=0; i<std::min(comparison.referenceEntries, comparison.entries); i++)
+    {
+      reference = referenceReader.GetEntry(i);
+      row = reader.GetEntry(i);
+      CompareEntry("CandidateData", i, reference, row, bind, comparison);
+    }
+    return comparison;
+  }
+
+  TDirectory & GetModuleDirectory(TFile & file, const std::string & moduleLabel)
+  {
+    TDirectory* directory = nullptr;
+    file.GetObject(moduleLabel.c_str(), directory);
+    if (!directory) throw cet::exception("CompareHsnFinderOutputs") << "No " << moduleLabel << " directory in " << file.GetName() << ".\n";
+    return *directory;
+  }
+
+  int Run(int argc, char** argv)
+  {
+    if (argc < 3)
+    {
+      printf("Usage: CompareHsnFinderOutputs <reference.root> <output.root> [module directory]\n");
+      return 1;
+    }
+    const std::string moduleLabel = (argc > 3) ? argv[3] : "HsnFinder";
+    std::unique_ptr<TFile> referenceFile(TFile::Open(argv[1], "READ"));
+    std::unique_ptr<TFile> file(TFile::Open(argv[2], "READ"));
+    if (!referenceFile || referenceFile->IsZombie()) throw cet::exception("CompareHsnFinderOutputs") << "Could not open " << argv[1] << ".\n";
+    if (!file || file->IsZombie()) throw cet::exception("CompareHsnFinderOutputs") << "Could not open " << argv[2] << ".\n";
+    TDirectory & referenceDirectory = GetModuleDirectory(*referenceFile, moduleLabel);
+    TDirectory & directory = GetModuleDirectory(*file, moduleLabel);
+
+    const std::vector<std::pair<std::string,TreeComparison>> comparisons = {
+      {"EventData", CompareTree<AuxEvent::EventTreeFiller>("EventData", referenceDirectory, directory,
+        [](AuxEvent::EventTreeFiller & row, auto & binder) {row.BindFields(binder);})},
+      {"DetectorData", CompareTree<DetectorRow>("DetectorData", referenceDirectory, directory,
+        [](DetectorRow & row, auto & binder) {row.BindFields(binder);})},
+      {"CandidateData", CompareCandidates(referenceDirectory, directory)},
+      {"DrawData", CompareTree<AuxEvent::DrawTreeFiller>("DrawData", referenceDirectory, directory,
+        [](AuxEvent::DrawTreeFiller & row, auto & binder) {row.BindFields(binder, true);})}
+    };
+
+    bool isIdentical = true;
+    for (const auto & comparison : comparisons)
+    {
+      const TreeComparison & c = comparison.second;
+      printf("%-14s %10lld entries (reference %lld), %zu different: %s\n", comparison.first.c_str(), c.entries, c.referenceEntries, c.differentEntries,
+        c.IsIdentical() ? "identical" : "DIFFERENT");
+      isIdentical = isIdentical && c.IsIdentical();
+    }
+    return isIdentical ? 0 : 1;
+  } // END function Run
+}
+
+int main(int argc, char** argv)
+{
+  return HsnTools::RunTool("CompareHsnFinderOutputs", Run, argc, argv);
+} // END function main
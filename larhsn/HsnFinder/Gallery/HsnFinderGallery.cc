@@ -0,0 +1,217 @@
+/******************************************************************************
+ * @file HsnFinderGallery.cc
+ * @brief Runs HsnFinder on art ROOT files with gallery, without an art job
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnFinder_module.cc hsnFinderGallery.fcl
+ *
+ * Usage: HsnFinderGallery -c <config.fcl> [-o <output.root>] [-n <maxEvents>] [-S <file list>] [input.root ...]
+ * The configuration holds a full HsnFinder job (e.g. it includes hsnFinder_mc.fcl) and a hsnFinderGallery table. The analyzer
+ * table physics.analyzers.<ModuleLabel> configures the same event processing (HsnFinderEventAlg) and output trees (HsnFinderOutput)
+ * as the module, read through gallery instead of art::Event. Without services, the detector is described by the output of a HsnFinder art job
+ * with the same services (DetectorFrom): its DetectorData tree holds the argon density and, for every run, the XYZ to (channel, tick)
+ * transforms the job sampled from the Geometry and DetectorProperties services (with the time offset of each plane). The gallery output then
+ * converts exactly as the module does, and CompareHsnFinderOutputs checks that the trees of both are the same.
+ * Startup only opens the input files, so many short jobs can run side by side (e.g. one per file).
+ * ****************************************************************************/
+
+// c++ includes
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// root includes
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TTree.h"
+
+// framework includes
+#include "gallery/Event.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/make_ParameterSet.h"
+#include "cetlib/filepath_maker.h"
+#include "cetlib/exception.h"
+
+// Auxiliary objects includes
+#include "larhsn/HsnFinder/Algorithms/HsnFinderEventAlg.h"
+#include "larhsn/HsnFinder/DataObjects/EventSource.h"
+#include "larhsn/HsnFinder/DataObjects/HsnFinderOutput.h"
+#include "larhsn/HsnFinder/DataObjects/ProjectionCache.h"
+#include "larhsn/Logging/HsnLog.h"
+
+// larhsn includes
+#include "larhsn/FileLocationDatabase/Index/ToolHelpers.h"
+
+namespace
+{
+  void PrintUsage()
+  {
+    printf("Usage: HsnFinderGallery -c <config.fcl> [-o <output.root>] [-n <maxEvents>] [-S <file list>] [input.root ...]\n");
+  }
+
+  // Detector description of one run, as the services of the reference job gave it
+  struct DetectorRun
+  {
+    double argonDensity;
+    std::string projection;
+  };
+  using DetectorRuns = std::map<int, DetectorRun>;
+
+  // DetectorData tree of a HsnFinder module output, by run
+  DetectorRuns ReadDetectorRuns(const std::string & referenceName, const std::string & moduleLabel)
+  {
+    if (referenceName.empty())
+    {
+      throw cet::exception("HsnFinderGallery") << "DetectorFrom is not set: give the output file of a HsnFinder art job with the same services "
+        << "(e.g. on one input file), the density and projection of its runs are read from its DetectorData tree.\n";
+    }
+    std::unique_ptr<TFile> file(TFile::Open(referenceName.c_str(), "READ"));
+    if (!file || file->IsZombie()) throw cet::exception("HsnFinderGallery") << "Could not open " << referenceName << ".\n";
+    TTree* tree = nullptr;
+    file->GetObject((moduleLabel + "/DetectorData").c_str(), tree);
+    if (!tree) throw cet::exception("HsnFinderGallery") << "No " << moduleLabel << "/DetectorData tree in " << referenceName << ".\n";
+    int run = 0;
+    double argonDensity = 0.;
+    std::string* projection = nullptr;
+    tree->SetBranchAddress("run", &run);
+    tree->SetBranchAddress("argonDensity", &argonDensity);
+    tree->SetBranchAddress("projection", &projection);
+    DetectorRuns detector;
+    for (Long64_t i=0; i!=tree->GetEntries(); i++)
+    {
+      tree->GetEntry(i);
+      detector[run] = {argonDensity, *projection};
+    }
+    tree->ResetBranchAddresses();
+    delete projection;
+    if (detector.empty()) throw cet::exception("HsnFinderGallery") << "The DetectorData tree of " << referenceName << " is empty.\n";
+    return detector;
+  } // END function ReadDetectorRuns
+
+  // Same as HsnFinder::beginRun: build the projection of the run and record it. A run missing from the reference
+  // takes the projection of the reference runs, only if they all agree.
+  void BeginRun(int run, const DetectorRuns & detector, AuxEvent::ProjectionCache & projection, AuxEvent::HsnFinderOutput & output, const HsnLog::Logger & log)
+  {
+    auto it = detector.find(run);
+    if (it == detector.end())
+    {
+      for (const auto & other : detector)
+      {
+        if (other.second.projection != detector.begin()->second.projection)
+        {
+          throw cet::exception("HsnFinderGallery") << "Run " << run << " is not in the DetectorFrom file and its runs have different projections.\n";
+        }
+      }
+      it = detector.begin();
+      HSN_WARNING(log, "Projection", "Run %i is not in the DetectorFrom file, using the projection of run %i.\n", run, it->first);
+    }
+    fhicl::ParameterSet planes;
+    fhicl::make_ParameterSet("Projection: " + it->second.projection, planes);
+    projection.Build(planes.get<std::vector<fhicl::ParameterSet>>("Projection"));
+    output.WriteDetector(run, it->second.argonDensity, it->second.projection);
+    return;
+  } // END function BeginRun
+
+  int Run(int argc, char** argv)
+  {
+    // Command line: options override the configuration
+    std::string configName, outputName, listName;
+    long long maxEvents = -2;
+    int option;
+    while ((option = getopt(argc, argv, "c:o:n:S:h")) != -1)
+    {
+      switch (option)
+      {
+        case 'c': configName = optarg; break;
+        case 'o': outputName = optarg; break;
+        case 'n': maxEvents = atoll(optarg); break;
+        case 'S': listName = optarg; break;
+        default: PrintUsage(); return 1;
+      }
+    }
+    std::vector<std::string> fileNames;
+    if (!listName.empty()) HsnTools::ReadFileList(listName, fileNames);
+    for (int i=optind; i<argc; i++) fileNames.push_back(argv[i]);
+    if (configName.empty() || fileNames.empty())
+    {
+      PrintUsage();
+      return 1;
+    }
+
+    // Configuration, found along FHICL_FILE_PATH as in an art job
+    fhicl::ParameterSet config;
+    cet::filepath_lookup policy("FHICL_FILE_PATH");
+    fhicl::make_ParameterSet(configName, policy, config);
+    const fhicl::ParameterSet runner = config.get<fhicl::ParameterSet>("hsnFinderGallery");
+    const std::string moduleLabel = runner.get<std::string>("ModuleLabel");
+    const fhicl::ParameterSet pset = config.get<fhicl::ParameterSet>("physics.analyzers." + moduleLabel);
+    if (outputName.empty()) outputName = runner.get<std::string>("OutputFile");
+    if (maxEvents == -2) maxEvents = runner.get<long long>("MaxEvents");
+    const DetectorRuns detector = ReadDetectorRuns(runner.get<std::string>("DetectorFrom"), moduleLabel);
+
+    // Same objects as in the module, in the same order
+    HsnLog::Logger log("HsnFinder", pset.get<fhicl::ParameterSet>("Logging"));
+    HsnFinderEvent::HsnFinderEventAlg eventAlg(pset);
+    AuxEvent::HsnFinderOutput output(pset);
+    eventAlg.SetLogger(&log);
+    output.SetLogger(&log);
+    // The services give one density for the whole job
+    output.SetRangeTableDeviation(eventAlg.BuildRangeTable(detector.begin()->second.argonDensity));
+    if (pset.get<bool>("ValidateProjectionCache")) HSN_WARNING(log, "Projection", "ValidateProjectionCache needs the art services, ignored.\n");
+
+    // Trees in a directory named after the module, as the TFileService does
+    TFile file(outputName.c_str(), "RECREATE");
+    if (file.IsZombie()) throw cet::exception("HsnFinderGallery") << "Could not open output file " << outputName << ".\n";
+    TDirectory* directory = file.mkdir(moduleLabel.c_str());
+    output.Open([directory](const char* name)
+      {
+        TDirectory::TContext context(directory);
+        return new TTree(name,"");
+      });
+
+    // Event loop. Events are read one at a time, so one workspace is enough.
+    std::unique_ptr<HsnFinderEvent::HsnFinderEventAlg::Workspace> workspace = eventAlg.MakeWorkspace();
+    double processTime = 0.;
+    long long nEvents = 0;
+    bool hasRun = false;
+    int lastRun = 0;
+    gallery::Event evt(fileNames);
+    auto tStart = std::chrono::steady_clock::now();
+    for (; !evt.atEnd() && (maxEvents < 0 || nEvents < maxEvents); evt.next())
+    {
+      const AuxEvent::EventSourceOf<gallery::Event> source(evt);
+      // art begins a run before its first event
+      const int run = source.ID().run();
+      if (!hasRun || run != lastRun) BeginRun(run, detector, eventAlg.GetProjectionCache(), output, log);
+      hasRun = true;
+      lastRun = run;
+
+      auto t0 = std::chrono::steady_clock::now();
+      eventAlg.ProcessEvent(source, *workspace);
+      processTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+      output.Submit(std::move(workspace->record));
+      // Messages of the event are written together
+      log.Flush();
+      nEvents++;
+    }
+    output.Close(processTime);
+    const double totalTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+    HSN_INFO(log, "Gallery", "Processed %lld events from %zu files in %.2f s (%.1f events/s), output in %s.\n", nEvents, fileNames.size(), totalTime,
+      (totalTime > 0.) ? nEvents/totalTime : 0., outputName.c_str());
+    log.PrintSummary();
+    log.Flush();
+
+    file.Write();
+    file.Close();
+    return 0;
+  } // END function Run
+}
+
+int main(int argc, char** argv)
+{
+  return HsnTools::RunTool("HsnFinderGallery", Run, argc, argv);
+} // END function main
@@ -0,0 +1,74 @@
+#ifndef HSNFILTER_H
+#define HSNFILTER_H
+
+// c++ includes
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+// framework includes
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/EDFilter.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// larsoft object includes
+#include "larcorealg/Geometry/geo.h"
+#include "larcore/Geometry/Geometry.h"
+#include "larcore/CoreUtils/ServiceUtil.h"
+#include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
+
+// Auxiliary objects includes
+#include "Algorithms/FindPandoraVertexAlg.h"
+#include "DataObjects/CandidateBatch.h"
+#include "DataObjects/EventSource.h"
+#include "DataObjects/EventTreeFiller.h"
+#include "DataObjects/HitPool.h"
+#include "DataObjects/ProjectionCache.h"
+#include "DataObjects/RangeMomentumTable.h"
+#include "larhsn/Logging/HsnLog.h"
+
+
+
+// Filter class
+// Runs the vertex search of HsnFinder (FindPandoraVertexAlg) and accepts the events with at least MinCandidates two-pronged candidates.
+// With Fcl/hsnFilter_slim.fcl the accepted events are written to an art file that only keeps the products read by HsnFinder.
+class HsnFilter : public art::EDFilter
+{
+public:
+  explicit HsnFilter(fhicl::ParameterSet const & pset);
+  virtual ~HsnFilter();
+  bool filter(art::Event & evt);
+  bool beginRun(art::Run & run);
+  void endJob();
+private:
+  // Diagnostic messages of the module and its algorithm (Logging table). Declared first, the algorithm keeps a pointer to it.
+  HsnLog::Logger fLog;
+  // Algorithms
+  FindPandoraVertex::FindPandoraVertexAlg fFindPandoraVertexAlg;
+  // Fhiclcpp variables
+  size_t fMinCandidates;
+  double fRangeTableMaxRange;
+  double fRangeTableStep;
+
+  // Declare services
+  geo::GeometryCore const* fGeometry; // Pointer to the Geometry service
+  detinfo::DetectorProperties const* fDetectorProperties; // Pointer to the Detector Properties
+
+  // Shared by the candidates (the candidates need the range tables, the vertex search the projection)
+  AuxVertex::RangeMomentumTable fRangeTable;
+  AuxEvent::ProjectionCache fProjectionCache;
+
+  // Per-event state, art v2 filters one event at a time
+  AuxEvent::EventTreeFiller fEventRow;
+  AuxEvent::HitPool fHitPool;
+  AuxVertex::CandidateBatch fCandidates;
+  FindPandoraVertex::FindPandoraVertexAlg::Workspace fVertexWorkspace;
+
+  // Counters for the summary at the end of the job
+  long long fNumEvents;
+  long long fNumPassed;
+}; // End class HsnFilter
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef HSNFILTER_MODULE
+#define HSNFILTER_MODULE
+
+#include "HsnFilter.h"
+
+HsnFilter::HsnFilter(fhicl::ParameterSet const & pset) :
+    EDFilter(pset),
+    fLog("HsnFilter", pset.get<fhicl::ParameterSet>("Logging")),
+    fFindPandoraVertexAlg(pset),
+    fMinCandidates(pset.get<size_t>("MinCandidates")),
+    fRangeTableMaxRange(pset.get<double>("RangeTableMaxRange")),
+    fRangeTableStep(pset.get<double>("RangeTableStep")),
+    fNumEvents(0),
+    fNumPassed(0)
+{
+  if (fMinCandidates == 0) throw cet::exception("HsnFilter") << "MinCandidates must be at least 1, otherwise every event is accepted.\n";
+  fFindPandoraVertexAlg.SetLogger(&fLog);
+  fFindPandoraVertexAlg.SetProjectionCache(&fProjectionCache);
+
+  // Get geometry and detector services
+  fGeometry = lar::providerFrom<geo::Geometry>();
+  fDetectorProperties = lar::providerFrom<detinfo::DetectorPropertiesService>();
+
+  // The candidates compute their range momenta when they are made, so the tables are needed even if only the count is used
+  fRangeTable.Build(fRangeTableMaxRange, fRangeTableStep, fDetectorProperties->Density());
+  fCandidates.SetRangeTable(&fRangeTable);
+} // END constructor HsnFilter
+
+HsnFilter::~HsnFilter()
+{} // END destructor HsnFilter
+
+bool HsnFilter::beginRun(art::Run & run)
+{
+  // Detector conditions can change between runs, so the XYZ to (channel, tick) transforms are sampled again
+  fProjectionCache.Build(fGeometry, fDetectorProperties, false);
+  return true;
+} // END function beginRun
+
+void HsnFilter::endJob()
+{
+  HSN_INFO(fLog, "Filter", "Accepted %lld of %lld events (%.2f%%) with at least %zu candidates.\n", fNumPassed, fNumEvents,
+    (fNumEvents > 0) ? 100.*fNumPassed/fNumEvents : 0., fMinCandidates);
+  fLog.PrintSummary();
+  fLog.Flush();
+} // END function endJob
+
+
+// Same vertex search as HsnFinder, the event passes if it has enough candidates
+bool HsnFilter::filter(art::Event & evt)
+{
+  fEventRow.Initialize((int) evt.id().run(), (int) evt.id().subRun(), (int) evt.id().event());
+  fHitPool.Clear();
+  fFindPandoraVertexAlg.GetPotentialNeutrinoVertices(AuxEvent::EventSourceOf<art::Event>(evt), fEventRow, fHitPool, fCandidates, fVertexWorkspace);
+  const bool pass = (fCandidates.Size() >= fMinCandidates);
+  fNumEvents++;
+  if (pass) fNumPassed++;
+  HSN_DEBUG(fLog, "Filter", "Event %i [run %i, subrun %i]: %zu candidates, %s.\n", (int) evt.id().event(), (int) evt.id().run(), (int) evt.id().subRun(),
+    fCandidates.Size(), pass ? "accepted" : "rejected");
+  // Messages of the event are written together
+  fLog.Flush();
+  return pass;
+} // END function filter
+
+
+// Name that will be used by the .fcl to invoke the module
+DEFINE_ART_MODULE(HsnFilter)
+
+#endif // END def HsnFilter_module
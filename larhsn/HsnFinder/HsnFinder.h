@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <string>
 #include <vector>
+#include <memory>
 #include <algorithm>
 #include <chrono>
 #include <exception>
@@ -18,6 +19,7 @@
 #include "TH2D.h"
 #include "TH2I.h"
 #include "TFile.h"
+#include "TDirectory.h"
 #include "TNtuple.h"
 #include "TClonesArray.h"
 #include "TCanvas.h"
@@ -59,17 +61,18 @@
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
 // Auxiliary objects includes
-#include "Algorithms/FindPandoraVertexAlg.h"
-#include "Algorithms/CalorimetryRadiusAlg.h"
-#include "Algorithms/ExtractTruthInformationAlg.h"
-#include "DataObjects/DecayVertex.h"
-#include "DataObjects/EventTreeFiller.h"
-#include "DataObjects/CandidateTreeFiller.h"
-#include "DataObjects/DrawTreeFiller.h"
+#include "Algorithms/HsnFinderEventAlg.h"
+#include "DataObjects/EventSource.h"
+#include "DataObjects/EventRecord.h"
+#include "DataObjects/HsnFinderOutput.h"
+#include "larhsn/Logging/HsnLog.h"
 
 
 
 // Analyzer class
+// The per-event work (HsnFinderEventAlg::ProcessEvent) is const and only writes to its workspace, and the trees are only filled by the output.
+// Events are processed one at a time (art v2 EDAnalyzer), in the order art reads them, with a single workspace reused for all of them.
+// Gallery/HsnFinderGallery.cc runs the same event processing and output on art files without an art job.
 class HsnFinder : public art::EDAnalyzer
 {
 public:
@@ -77,55 +80,24 @@ public:
   virtual ~HsnFinder();
   void analyze(art::Event const & evt);
   void beginJob();
+  void beginRun(art::Run const & run);
   void endJob();
 private:
-  // Algorithms
-  FindPandoraVertex::FindPandoraVertexAlg fFindPandoraVertexAlg;
-  CalorimetryRadius::CalorimetryRadiusAlg fCalorimetryRadiusAlg;
-  ExtractTruthInformation::ExtractTruthInformationAlg fExtractTruthInformationAlg;
+  // Diagnostic messages of the module and its algorithms (Logging table). Declared first, the algorithms and the output keep a pointer to it.
+  HsnLog::Logger fLog;
+  // Algorithms: event processing and output trees
+  HsnFinderEvent::HsnFinderEventAlg fEventAlg;
+  AuxEvent::HsnFinderOutput fOutput;
   // Fhiclcpp variables
-  std::string fInstanceName;
-  int fIteration;
-  std::vector<double> fMinTpcBound, fMaxTpcBound, fCenterCoordinates;
-  std::string fPfpLabel;
-  std::string fHitLabel;
-  std::string fMcsLabel;
-  std::vector<double> fRadiusProfileLimits;
-  int fRadiusProfileBins;
-  double fChannelNorm;
-  double fTickNorm;
-  bool fVerbose;
-  bool fSaveDrawTree;
-  bool fSaveTruthDrawTree;
-  bool fUseTruthDistanceMetric;
-  std::string fMcTrackLabel;
-  bool fIsHSN;
+  bool fValidateProjection;
 
   // Declare services
   geo::GeometryCore const* fGeometry; // Pointer to the Geometry service
   detinfo::DetectorProperties const* fDetectorProperties; // Pointer to the Detector Properties
 
-  // Declare trees
-  TTree *metaTree;
-  TTree *eventTree;
-  TTree *candidateTree;
-  TTree *drawTree;
-  TTree *physicsTree;
-
-  // Declare tree fillers
-  AuxEvent::EventTreeFiller etf;
-  AuxEvent::CandidateTreeFiller ctf;
-  AuxEvent::DrawTreeFiller dtf;
-
-  // Declare analysis variables
-  std::vector<float> profileTicks;
-
-  // Declare pandora analysis variables
-  std::vector<AuxVertex::DecayVertex> ana_pandora_decayVertices;
-  std::vector<recob::PFParticle const*> ana_pandora_neutrinos, ana_pandora_tracks, ana_pandora_showers;
-
-  // Declare analysis functions
-  void ClearData();
+  // Workspace of the event being processed
+  std::unique_ptr<HsnFinderEvent::HsnFinderEventAlg::Workspace> fWorkspace;
+  double fProcessTime; // Event processing [s]
 }; // End class HsnFinder
 
 #endif
@@ -0,0 +1,150 @@
+/******************************************************************************
+ * @file HsnLog.cxx
+ * @brief Level-gated, rate-limited and buffered diagnostic messages shared by the larhsn modules
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnLog.h
+ * ****************************************************************************/
+
+#include "HsnLog.h"
+#include <stdarg.h>
+
+namespace HsnLog
+{
+  // Buffers larger than this are written before the end of the event
+  static const size_t kMaxBufferSize = 1 << 16;
+
+  Level ParseLevel(const std::string & name)
+  {
+    if (name == "Debug") return kDebug;
+    if (name == "Info") return kInfo;
+    if (name == "Warning") return kWarning;
+    if (name == "Error") return kError;
+    throw cet::exception("HsnLog") << "Unknown log level " << name << " (Debug, Info, Warning or Error).\n";
+  } // END function ParseLevel
+
+  const char* LevelName(Level level)
+  {
+    static const char* const names[] = {"Debug", "Info", "Warning", "Error"};
+    return names[level];
+  } // END function LevelName
+
+  std::string Format(const char* format, ...)
+  {
+    va_list args;
+    va_start(args, format);
+    const int length = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+    if (length <= 0) return std::string();
+    std::string text(length+1, '\0');
+    va_start(args, format);
+    vsnprintf(&text[0], text.size(), format, args);
+    va_end(args);
+    text.resize(length);
+    return text;
+  } // END function Format
+
+  Logger::Logger() :
+    fName(""),
+    fLevel(kInfo),
+    fMaxPerEvent(0)
+  {}
+
+  Logger::Logger(const std::string & name, fhicl::ParameterSet const & pset) :
+    fName(name),
+    fLevel(ParseLevel(pset.get<std::string>("Level", "Info"))),
+    fMaxPerEvent(pset.get<int>("MaxPerEvent", 0))
+  {
+    if (fMaxPerEvent < 0) throw cet::exception("HsnLog") << "MaxPerEvent " << fMaxPerEvent << " must not be negative.\n";
+  } // END constructor Logger
+
+  Logger::~Logger()
+  {
+    Flush();
+  } // END destructor Logger
+
+  void Logger::Log(Level level, const char* category, const char* format, ...) const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (fMaxPerEvent > 0)
+    {
+      CategoryCount & count = fCounts[category];
+      if (count.inEvent >= fMaxPerEvent)
+      {
+        count.suppressedInEvent++;
+        count.suppressed++;
+        return;
+      }
+      count.inEvent++;
+    }
+
+    // Warnings and errors are labelled, the other messages are printed as they are
+    if (level >= kWarning) fBuffer += std::string(LevelName(level)) + " [" + fName + "/" + category + "]: ";
+    va_list args;
+    va_start(args, format);
+    char line[512];
+    const int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length < (int) sizeof(line)) fBuffer.append(line, (length > 0) ? length : 0);
+    else
+    {
+      // Long message: format again at its full size
+      std::string longLine(length+1, '\0');
+      va_start(args, format);
+      vsnprintf(&longLine[0], longLine.size(), format, args);
+      va_end(args);
+      fBuffer.append(longLine, 0, length);
+    }
+    if (fBuffer.size() > kMaxBufferSize) WriteBuffer();
+    return;
+  } // END function Log
+
+  void Logger::Flush() const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (auto & category : fCounts)
+    {
+      if (category.second.suppressedInEvent > 0)
+      {
+        fBuffer += "[" + fName + "/" + category.first + "]: " + std::to_string(category.second.suppressedInEvent) + " more messages suppressed in this event.\n";
+      }
+      category.second.inEvent = 0;
+      category.second.suppressedInEvent = 0;
+    }
+    WriteBuffer();
+    return;
+  } // END function Flush
+
+  void Logger::PrintSummary() const
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    for (const auto & category : fCounts)
+    {
+      if (category.second.suppressed > 0)
+      {
+        fBuffer += "[" + fName + "/" + category.first + "]: " + std::to_string(category.second.suppressed) + " messages suppressed by MaxPerEvent " + std::to_string(fMaxPerEvent) + ".\n";
+      }
+    }
+    WriteBuffer();
+    return;
+  } // END function PrintSummary
+
+  void Logger::WriteBuffer() const
+  {
+    if (fBuffer.empty()) return;
+    fwrite(fBuffer.data(), 1, fBuffer.size(), stdout);
+    fflush(stdout);
+    fBuffer.clear();
+    return;
+  } // END function WriteBuffer
+
+  // Getters
+  Level Logger::GetLevel() const {return fLevel;}
+  int Logger::GetMaxPerEvent() const {return fMaxPerEvent;}
+
+  const Logger & DefaultLogger()
+  {
+    static const Logger logger;
+    return logger;
+  } // END function DefaultLogger
+
+} // END namespace HsnLog
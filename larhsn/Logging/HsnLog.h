@@ -0,0 +1,96 @@
+/******************************************************************************
+ * @file HsnLog.h
+ * @brief Level-gated, rate-limited and buffered diagnostic messages shared by the larhsn modules
+ * @author salvatore.porzio@postgrad.manchester.ac.uk
+ * @see  HsnLog.cxx
+ * ****************************************************************************/
+
+#ifndef HSNLOG_H
+#define HSNLOG_H
+
+// C++ standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include "cetlib/exception.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// Messages below this level are compiled out, whatever the fhicl configuration (0 Debug, 1 Info, 2 Warning, 3 Error).
+// Set by the build (HSN_LOG_MIN_LEVEL in larhsn/CMakeLists.txt).
+#ifndef HSN_LOG_MIN_LEVEL
+#define HSN_LOG_MIN_LEVEL 0
+#endif
+
+// Use these instead of calling Logger::Log: the arguments are only evaluated for messages that are printed,
+// and below HSN_LOG_MIN_LEVEL the whole statement is removed by the compiler (the condition is a constant).
+#define HSN_LOG(logger, level, category, ...) \
+  do { if ((level) >= HSN_LOG_MIN_LEVEL && (logger).IsEnabled(level)) (logger).Log((level), (category), __VA_ARGS__); } while (0)
+#define HSN_DEBUG(logger, category, ...) HSN_LOG(logger, HsnLog::kDebug, category, __VA_ARGS__)
+#define HSN_INFO(logger, category, ...) HSN_LOG(logger, HsnLog::kInfo, category, __VA_ARGS__)
+#define HSN_WARNING(logger, category, ...) HSN_LOG(logger, HsnLog::kWarning, category, __VA_ARGS__)
+#define HSN_ERROR(logger, category, ...) HSN_LOG(logger, HsnLog::kError, category, __VA_ARGS__)
+
+namespace HsnLog
+{
+  enum Level {kDebug = 0, kInfo = 1, kWarning = 2, kError = 3};
+
+  // "Debug", "Info", "Warning" or "Error"
+  Level ParseLevel(const std::string & name);
+  const char* LevelName(Level level);
+  // printf to a string, to build multi-line blocks (reports, tables) logged as one message
+  std::string Format(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+  // Logger class and functions
+  // One per module, shared by its algorithms. Messages are appended to a buffer and written with a single call by Flush,
+  // which the module calls at the end of every event. Each category (e.g. "Vertex") prints at most MaxPerEvent messages per event,
+  // the others are counted and reported at the flush. Logging is const and thread safe, so const algorithms can log.
+  // Configuration table (optional, every key has a default):
+  //   Level:       lowest level printed, "Debug", "Info" (default), "Warning" or "Error"
+  //   MaxPerEvent: messages per category and event, 0 (default) for no limit
+  class Logger
+  {
+  public:
+    // Constructor and destructor
+    Logger();
+    Logger(const std::string & name, fhicl::ParameterSet const & pset);
+    virtual ~Logger();
+    Logger(const Logger &) = delete;
+    Logger & operator=(const Logger &) = delete;
+
+    bool IsEnabled(Level level) const {return level >= fLevel;}
+    void Log(Level level, const char* category, const char* format, ...) const __attribute__((format(printf, 4, 5)));
+    // Write the buffered messages and the number of messages over the limit, and start a new event for the limits
+    void Flush() const;
+    // Messages suppressed by the limits over the whole job
+    void PrintSummary() const;
+
+    // Getters
+    Level GetLevel() const;
+    int GetMaxPerEvent() const;
+
+  private:
+    struct CategoryCount
+    {
+      int inEvent = 0; // Printed in the current event
+      int suppressedInEvent = 0;
+      long long suppressed = 0; // Whole job
+    };
+
+    std::string fName;
+    Level fLevel;
+    int fMaxPerEvent;
+    mutable std::mutex fMutex;
+    mutable std::string fBuffer;
+    mutable std::map<std::string, CategoryCount> fCounts;
+
+    void WriteBuffer() const; // fMutex must be held
+  };
+
+  // Info level, no limits: used by algorithms until their module gives them its logger
+  const Logger & DefaultLogger();
+
+} //END namespace HsnLog
+
+#endif
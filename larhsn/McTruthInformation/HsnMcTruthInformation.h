@@ -55,6 +55,9 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
+// larhsn includes
+#include "larhsn/Logging/HsnLog.h"
+
 // Analyzer class
 class HsnMcTruthInformation : public art::EDAnalyzer
 {
@@ -70,6 +73,7 @@ private:
   // Declare fhiclcpp variables
   std::string fMcTruthLabel;
   std::string fMcTrackLabel;
+  HsnLog::Logger fLog;
 
   // Declare trees and tree variables
   TTree *tDataTree;
@@ -6,7 +6,8 @@
 HsnMcTruthInformation::HsnMcTruthInformation(fhicl::ParameterSet const & pset) :
     EDAnalyzer(pset),
     fMcTruthLabel(pset.get<std::string>("mcTruthLabel")),
-    fMcTrackLabel(pset.get<std::string>("mcTrackLabel"))
+    fMcTrackLabel(pset.get<std::string>("mcTrackLabel")),
+    fLog("HsnMcTruthInformation", pset.get<fhicl::ParameterSet>("Logging"))
 {} // END constructor HsnMcTruthInformation
 
 HsnMcTruthInformation::~HsnMcTruthInformation()
@@ -52,6 +53,8 @@ void HsnMcTruthInformation::beginJob()
 
 void HsnMcTruthInformation::endJob()
 {
+  fLog.PrintSummary();
+  fLog.Flush();
 } // END function endJob
 
 void HsnMcTruthInformation::ClearData()
@@ -101,32 +104,30 @@ void HsnMcTruthInformation::GetTruthParticles(art::Event const & evt)
   {
     art::Ptr<simb::MCTruth> mcTruth(mcTruthHandle,i);
     int nParticles = mcTruth->NParticles();
-    printf("|_Number of MCTruth: %i\n", nParticles);
-    printf("|_Number of MCTracks: %i\n", (int) (*mcTrackHandle).size());
-    printf("|\n");
+    HSN_DEBUG(fLog, "Truth", "|_Number of MCTruth: %i\n|_Number of MCTracks: %i\n|\n", nParticles, (int) (*mcTrackHandle).size());
 
     for (int j=0; j<nParticles; j++)
     {
       const simb::MCParticle & mcPart = mcTruth->GetParticle(j);
       art::Ptr<sim::MCTrack> mcTrack; 
-      printf("|_Found MCPart (%i of %i) | PDG: %i\n", j+1, nParticles, mcPart.PdgCode());
+      HSN_DEBUG(fLog, "Truth", "|_Found MCPart (%i of %i) | PDG: %i\n", j+1, nParticles, mcPart.PdgCode());
 
       // Find mcTrack object associated with this mcPart. mcPart doesn't have simulation of interaction in argon,
       // so we can't recover the end points of tracks (and thus the lengths)
       // There is no mcPart/mcTrack association so at the moment we look for primary particles
       // that have the same PDG code. This immediately fails if an interaction contains two particles with
       // same pdg coming out of nucleus (albeit unlikely), but it should be kept to mind.
-      printf("| |_Looping through candidates.\n");
+      HSN_DEBUG(fLog, "Truth", "| |_Looping through candidates.\n");
       bool matchFound = false;
       for(std::vector<int>::size_type k=0; k!=(*mcTrackHandle).size(); k++)
       {
         art::Ptr<sim::MCTrack> potMcTrack(mcTrackHandle,k);
         bool mctIsPrimary = (potMcTrack->Process()=="primary");
         bool mctHasSamePdgCode = (potMcTrack->PdgCode()==mcPart.PdgCode());
-        printf("| | |_Examining MCTrack candidate %i of %i | PDG: %i | Process: %s\n", (int) k+1, (int) (*mcTrackHandle).size(), potMcTrack->PdgCode(), potMcTrack->Process().c_str());
+        HSN_DEBUG(fLog, "Truth", "| | |_Examining MCTrack candidate %i of %i | PDG: %i | Process: %s\n", (int) k+1, (int) (*mcTrackHandle).size(), potMcTrack->PdgCode(), potMcTrack->Process().c_str());
         if (mctIsPrimary && mctHasSamePdgCode)
         {
-          printf("| | | |_Particle matches!\n");
+          HSN_DEBUG(fLog, "Truth", "| | | |_Particle matches!\n");
           mcTrack = potMcTrack;
           matchFound = true;
         }
@@ -156,7 +157,7 @@ void HsnMcTruthInformation::GetTruthParticles(art::Event const & evt)
         EndT.push_back(-999999);
         Length.push_back(-999999);
         Contained = false;
-        printf("|_BAD EVENT! Not all matches found.\n");
+        HSN_WARNING(fLog, "Truth", "Event %i: no primary MCTrack matches MCParticle %i (PDG %i), event flagged as not contained.\n", event, j, mcPart.PdgCode());
       }
 
       Px.push_back((float) mcPart.Px());
@@ -208,7 +209,7 @@ void HsnMcTruthInformation::GetTruthParticles(art::Event const & evt)
 void HsnMcTruthInformation::analyze(art::Event const & evt)
 {
   // Core analysis. Use all the previously defined functions to determine success rate. This will be repeated event by event.
-  printf("\n-------------------------------------------------------\n");
+  HSN_DEBUG(fLog, "Event", "\n-------------------------------------------------------\n");
 
   // Start by clearing all the vectors.
   ClearData();
@@ -217,14 +218,15 @@ void HsnMcTruthInformation::analyze(art::Event const & evt)
   run = evt.id().run();
   subrun = evt.id().subRun();
   event = evt.id().event();
-  printf("||INFORMATION FOR EVENT %i [RUN %i, SUBRUN %i]||\n", event, run, subrun);
+  HSN_DEBUG(fLog, "Event", "||INFORMATION FOR EVENT %i [RUN %i, SUBRUN %i]||\n", event, run, subrun);
 
   // Get vector of primaries and secondaries pfps
   GetTruthParticles(evt);
 
   // Fill tree and finish event loop
   tDataTree->Fill();
-  printf("-------------------------------------------------------\n\n");
+  HSN_DEBUG(fLog, "Event", "-------------------------------------------------------\n\n");
+  fLog.Flush();
 } // END function analyze
 
 
@@ -59,6 +59,9 @@
 #include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 
+// larhsn includes
+#include "larhsn/Logging/HsnLog.h"
+
 #ifndef ANAHELPER_H
 #define ANAHELPER_H
 
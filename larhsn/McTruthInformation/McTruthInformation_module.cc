@@ -18,7 +18,7 @@ private:
   std::string fNuLabel;
   std::string fCosmicLabel;
   bool fRecordCosmics;
-  bool fVerbose;
+  HsnLog::Logger fLog;
 
   // Declare trees
   TTree *tDataTree;
@@ -38,7 +38,7 @@ McTruthInformation::McTruthInformation(fhicl::ParameterSet const & pset) :
     fNuLabel(pset.get<std::string>("nuLabel")),
     fCosmicLabel(pset.get<std::string>("cosmicLabel")),
     fRecordCosmics(pset.get<bool>("recordCosmics")),
-    fVerbose(pset.get<bool>("verbose"))      
+    fLog("McTruthInformation", pset.get<fhicl::ParameterSet>("Logging"))
 {} // END constructor McTruthInformation
 
 McTruthInformation::~McTruthInformation()
@@ -132,6 +132,8 @@ void McTruthInformation::beginJob()
 
 void McTruthInformation::endJob()
 {
+  fLog.PrintSummary();
+  fLog.Flush();
 } // END function endJob
 
 void McTruthInformation::ClearData()
@@ -169,7 +171,7 @@ void McTruthInformation::GetTruthInformation(art::Event const & evt)
 
   // Find nu mcTruth
   const auto& mctNuHandle = evt.getValidHandle< std::vector<simb::MCTruth> >(nuTag);
-  if ((*mctNuHandle).size()>1) printf("WAIT!!! There are %i MCTruth in this event!", (int) (*mctNuHandle).size());
+  if ((*mctNuHandle).size()>1) HSN_WARNING(fLog, "Truth", "There are %i MCTruth in this event.\n", (int) (*mctNuHandle).size());
   for (auto const& mct : (*mctNuHandle))
   {
     const simb::MCNeutrino & mcn = mct.GetNeutrino();
@@ -240,7 +242,7 @@ void McTruthInformation::GetTruthInformation(art::Event const & evt)
   if ( fRecordCosmics )
   {
     const auto& mctCosmicHandle = evt.getValidHandle< std::vector<simb::MCTruth> >(cosmicTag);
-    if ((*mctCosmicHandle).size()>1) printf("WAIT!!! There are %i cosmic MCTruth in this event!", (int) (*mctCosmicHandle).size());
+    if ((*mctCosmicHandle).size()>1) HSN_WARNING(fLog, "Truth", "There are %i cosmic MCTruth in this event.\n", (int) (*mctCosmicHandle).size());
     for (auto const& mct : (*mctCosmicHandle))
     {
       int nCosmics = mct.NParticles();
@@ -275,12 +277,9 @@ void McTruthInformation::GetTruthInformation(art::Event const & evt)
   std::map<int, std::string> CCNCTable;
   CCNCTable[0] = std::string("CC");
   CCNCTable[1] = std::string("NC");
-  if (fVerbose)
-  {
-    printf("Found a %s %i interaction with a %i incoming neutrino and %i outgoing lepton.\n", CCNCTable[int_CCNC].c_str(), int_interactionType, nu_pdgCode, lepton_pdgCode);
-    if (fRecordCosmics ) printf("Event contains %i cosmics.\n", (int) cosmic_pdgCode.size());
-    else printf("Not analyzing cosmics.\n");
-  }
+  HSN_DEBUG(fLog, "Truth", "Found a %s %i interaction with a %i incoming neutrino and %i outgoing lepton.\n", CCNCTable[int_CCNC].c_str(), int_interactionType, nu_pdgCode, lepton_pdgCode);
+  if (fRecordCosmics) HSN_DEBUG(fLog, "Truth", "Event contains %i cosmics.\n", (int) cosmic_pdgCode.size());
+  else HSN_DEBUG(fLog, "Truth", "Not analyzing cosmics.\n");
   return;
 } // END function GetTruthParticles
 
@@ -288,9 +287,7 @@ void McTruthInformation::GetTruthInformation(art::Event const & evt)
 void McTruthInformation::analyze(art::Event const & evt)
 {
   // Core analysis. Use all the previously defined functions to determine success rate. This will be repeated event by event.
-  if (fVerbose) printf("\n|-----------------------------------------------------|");
-  if (fVerbose) printf("\n|   MCTRUTHINFORMATION MODULE                         |");
-  if (fVerbose) printf("\n|-----------------------------------------------------|\n\n");  
+  HSN_DEBUG(fLog, "Event", "\n|-----------------------------------------------------|\n|   MCTRUTHINFORMATION MODULE                         |\n|-----------------------------------------------------|\n\n");
   
   // Start by clearing all the vectors.
   ClearData();
@@ -299,7 +296,7 @@ void McTruthInformation::analyze(art::Event const & evt)
   run = evt.id().run();
   subrun = evt.id().subRun();
   event = evt.id().event();
-  if (fVerbose) printf("||  INFORMATION FOR EVENT %i [RUN %i, SUBRUN %i]  ||\n", event, run, subrun);
+  HSN_DEBUG(fLog, "Event", "||  INFORMATION FOR EVENT %i [RUN %i, SUBRUN %i]  ||\n", event, run, subrun);
 
 
   // Assign mcTruth values to global variables
@@ -307,7 +304,8 @@ void McTruthInformation::analyze(art::Event const & evt)
 
   // Fill tree and finish event loop
   tDataTree->Fill();
-  if (fVerbose) printf("\n|-----------------------------------------------------|\n\n");  
+  HSN_DEBUG(fLog, "Event", "\n|-----------------------------------------------------|\n\n");
+  fLog.Flush();
 } // END function analyze
 
 
@@ -15,6 +15,7 @@ public:
 private:
   // Declare fhiclcpp variables
   std::string fMessage;
+  HsnLog::Logger fLog;
 
   // Declare services
   geo::GeometryCore const* fGeometry; // Pointer to the Geometry service
@@ -33,7 +34,8 @@ private:
 
 MinimalExample::MinimalExample(fhicl::ParameterSet const & pset) :
     EDAnalyzer(pset),
-    fMessage(pset.get<std::string>("message"))  
+    fMessage(pset.get<std::string>("message")),
+    fLog("MinimalExample", pset.get<fhicl::ParameterSet>("Logging"))
 {} // END constructor MinimalExample
 
 MinimalExample::~MinimalExample()
@@ -59,6 +61,8 @@ void MinimalExample::beginJob()
 
 void MinimalExample::endJob()
 {
+  fLog.PrintSummary();
+  fLog.Flush();
 } // END function endJob
 
 void MinimalExample::ClearData()
@@ -71,7 +75,7 @@ void MinimalExample::ClearData()
 void MinimalExample::analyze(art::Event const & evt)
 {
   // Core analysis. Use all the previously defined functions to determine success rate. This will be repeated event by event.
-  printf("\n-------------------------------------------------------\n");
+  HSN_INFO(fLog, "Event", "\n-------------------------------------------------------\n");
   
   // Start by clearing all the vectors.
   ClearData();
@@ -80,14 +84,15 @@ void MinimalExample::analyze(art::Event const & evt)
   run = evt.id().run();
   subrun = evt.id().subRun();
   event = evt.id().event();
-  printf("||INFORMATION FOR EVENT %i [RUN %i, SUBRUN %i]||\n", event, run, subrun);
+  HSN_INFO(fLog, "Event", "||INFORMATION FOR EVENT %i [RUN %i, SUBRUN %i]||\n", event, run, subrun);
   
   // Start performing analysis
-  printf("Here's your message: %s\n", fMessage.c_str());
+  HSN_INFO(fLog, "Event", "Here's your message: %s\n", fMessage.c_str());
 
   // Fill tree and finish event loop
   tDataTree->Fill();
-  printf("-------------------------------------------------------\n\n");
+  HSN_INFO(fLog, "Event", "-------------------------------------------------------\n\n");
+  fLog.Flush();
 } // END function analyze
 
 